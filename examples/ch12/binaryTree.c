@@ -0,0 +1,583 @@
+// binaryTree.c
+// Binary search tree function definitions (Fig. 12.19), plus the AVL
+// insert and delete that keep the tree balanced.
+#include <stdio.h>
+#include <stdlib.h>
+#include "binaryTree.h" // include definition of TreeNode from binaryTree.h
+
+// nodes come from a node pool when compiled with -DUSE_NODE_POOL
+// NOTE: the pooled build must also be compiled with nodePool.c
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool treeNodePool = NODE_POOL_INITIALIZER(TreeNode);
+#define NEW_NODE() POOL_NEW(&treeNodePool, TreeNode)
+#define FREE_NODE(nodePtr) freeNode(&treeNodePool, (nodePtr))
+#else
+#define NEW_NODE() malloc(sizeof(TreeNode))
+#define FREE_NODE(nodePtr) free(nodePtr)
+#endif
+
+// height of a possibly empty subtree
+static int heightOf(TreeNodePtr treePtr)
+{
+   return treePtr == NULL ? 0 : treePtr->height;
+}
+
+// number of nodes in a possibly empty subtree
+static unsigned int sizeOf(TreeNodePtr treePtr)
+{
+   return treePtr == NULL ? 0 : treePtr->size;
+}
+
+// recompute a node's height and subtree size from its children
+static void updateNode(TreeNodePtr treePtr)
+{
+   int leftHeight = heightOf(treePtr->leftPtr);
+   int rightHeight = heightOf(treePtr->rightPtr);
+   treePtr->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+   treePtr->size = 1 + sizeOf(treePtr->leftPtr) + sizeOf(treePtr->rightPtr);
+}
+
+// create a leaf holding value, or return NULL if no memory is available
+static TreeNodePtr newLeaf(int value)
+{
+   TreeNodePtr newPtr = NEW_NODE();
+
+   if (newPtr != NULL) {
+      newPtr->data = value;
+      newPtr->leftPtr = NULL;
+      newPtr->rightPtr = NULL;
+      newPtr->height = 1;
+      newPtr->size = 1;
+   }
+
+   return newPtr;
+}
+
+// insert node into tree
+void insertNode(TreeNodePtr *treePtr, int value)
+{
+   // if tree is empty
+   if (*treePtr == NULL) {
+      *treePtr = newLeaf(value);
+
+      // if memory was not allocated, report it
+      if (*treePtr == NULL) {
+         printf("%d not inserted. No memory available.\n", value);
+      }
+   }
+   else { // tree is not empty
+      // data to insert is less than data in current node
+      if (value < (*treePtr)->data) {
+         insertNode(&((*treePtr)->leftPtr), value);
+      }
+
+      // data to insert is greater than data in current node
+      else if (value > (*treePtr)->data) {
+         insertNode(&((*treePtr)->rightPtr), value);
+      }
+      else { // duplicate data value ignored
+         printf("%s", "dup");
+      }
+
+      updateNode(*treePtr);
+   }
+}
+
+// begin inorder traversal of tree
+void inOrder(TreeNodePtr treePtr)
+{
+   // if tree is not empty, then traverse
+   if (treePtr != NULL) {
+      inOrder(treePtr->leftPtr);
+      printf("%3d", treePtr->data);
+      inOrder(treePtr->rightPtr);
+   }
+}
+
+// begin preorder traversal of tree
+void preOrder(TreeNodePtr treePtr)
+{
+   // if tree is not empty, then traverse
+   if (treePtr != NULL) {
+      printf("%3d", treePtr->data);
+      preOrder(treePtr->leftPtr);
+      preOrder(treePtr->rightPtr);
+   }
+}
+
+// begin postorder traversal of tree
+void postOrder(TreeNodePtr treePtr)
+{
+   // if tree is not empty, then traverse
+   if (treePtr != NULL) {
+      postOrder(treePtr->leftPtr);
+      postOrder(treePtr->rightPtr);
+      printf("%3d", treePtr->data);
+   }
+}
+
+// rotate the subtree at *treePtr to the right; its left child becomes root
+static void rotateRight(TreeNodePtr *treePtr)
+{
+   TreeNodePtr oldRootPtr = *treePtr;
+   TreeNodePtr newRootPtr = oldRootPtr->leftPtr;
+
+   oldRootPtr->leftPtr = newRootPtr->rightPtr;
+   newRootPtr->rightPtr = oldRootPtr;
+   updateNode(oldRootPtr);
+   updateNode(newRootPtr);
+   *treePtr = newRootPtr;
+}
+
+// rotate the subtree at *treePtr to the left; its right child becomes root
+static void rotateLeft(TreeNodePtr *treePtr)
+{
+   TreeNodePtr oldRootPtr = *treePtr;
+   TreeNodePtr newRootPtr = oldRootPtr->rightPtr;
+
+   oldRootPtr->rightPtr = newRootPtr->leftPtr;
+   newRootPtr->leftPtr = oldRootPtr;
+   updateNode(oldRootPtr);
+   updateNode(newRootPtr);
+   *treePtr = newRootPtr;
+}
+
+// restore the AVL property (subtree heights differ by at most 1) at
+// *treePtr after one of its subtrees grew or shrank by one level
+static void rebalance(TreeNodePtr *treePtr)
+{
+   TreeNodePtr nodePtr = *treePtr;
+   int balance = heightOf(nodePtr->leftPtr) - heightOf(nodePtr->rightPtr);
+
+   if (balance > 1) { // left side too tall
+      // left-right case: first turn it into a left-left case
+      if (heightOf(nodePtr->leftPtr->leftPtr) <
+         heightOf(nodePtr->leftPtr->rightPtr)) {
+         rotateLeft(&nodePtr->leftPtr);
+      }
+
+      rotateRight(treePtr);
+   }
+   else if (balance < -1) { // right side too tall
+      // right-left case: first turn it into a right-right case
+      if (heightOf(nodePtr->rightPtr->rightPtr) <
+         heightOf(nodePtr->rightPtr->leftPtr)) {
+         rotateRight(&nodePtr->rightPtr);
+      }
+
+      rotateLeft(treePtr);
+   }
+   else {
+      updateNode(nodePtr);
+   }
+}
+
+// insert value keeping the tree balanced; the recursion is only O(log n)
+// deep. Returns 1 if inserted, 0 for a duplicate or when out of memory.
+int insertNodeBalanced(TreeNodePtr *treePtr, int value)
+{
+   int inserted;
+
+   if (*treePtr == NULL) {
+      *treePtr = newLeaf(value);
+      return *treePtr != NULL;
+   }
+
+   if (value < (*treePtr)->data) {
+      inserted = insertNodeBalanced(&((*treePtr)->leftPtr), value);
+   }
+   else if (value > (*treePtr)->data) {
+      inserted = insertNodeBalanced(&((*treePtr)->rightPtr), value);
+   }
+   else { // duplicate data value ignored
+      return 0;
+   }
+
+   if (inserted) {
+      rebalance(treePtr);
+   }
+
+   return inserted;
+}
+
+// build a perfectly balanced subtree from sorted[0 .. count - 1]
+static TreeNodePtr buildSubtree(const int sorted[], size_t count, int *okPtr)
+{
+   if (count == 0 || !*okPtr) {
+      return NULL;
+   }
+
+   size_t middle = count / 2;
+   TreeNodePtr rootPtr = newLeaf(sorted[middle]);
+
+   if (rootPtr == NULL) {
+      *okPtr = 0;
+      return NULL;
+   }
+
+   rootPtr->leftPtr = buildSubtree(sorted, middle, okPtr);
+   rootPtr->rightPtr =
+      buildSubtree(sorted + middle + 1, count - middle - 1, okPtr);
+   updateNode(rootPtr);
+   return rootPtr;
+}
+
+// O(n) bulk load of an empty tree from keys sorted in increasing order,
+// without duplicates. The result is a valid balanced (AVL) tree, so it may
+// be extended with insertNodeBalanced. Returns 0 if memory ran out, in
+// which case the partial tree is freed.
+int buildTreeFromSorted(TreeNodePtr *treePtr, const int sorted[],
+   size_t count)
+{
+   int ok = 1;
+
+   *treePtr = buildSubtree(sorted, count, &ok);
+
+   if (!ok) {
+      freeTree(treePtr);
+   }
+
+   return ok;
+}
+
+// detach the smallest node of a nonempty subtree, rebalancing on the way up
+static TreeNodePtr removeMinimum(TreeNodePtr *treePtr)
+{
+   TreeNodePtr minimumPtr;
+
+   if ((*treePtr)->leftPtr == NULL) {
+      minimumPtr = *treePtr;
+      *treePtr = minimumPtr->rightPtr;
+   }
+   else {
+      minimumPtr = removeMinimum(&((*treePtr)->leftPtr));
+      rebalance(treePtr);
+   }
+
+   return minimumPtr;
+}
+
+// delete value keeping the tree balanced; returns 1 if it was found
+int deleteNodeBalanced(TreeNodePtr *treePtr, int value)
+{
+   int deleted;
+
+   if (*treePtr == NULL) {
+      return 0;
+   }
+
+   if (value < (*treePtr)->data) {
+      deleted = deleteNodeBalanced(&((*treePtr)->leftPtr), value);
+   }
+   else if (value > (*treePtr)->data) {
+      deleted = deleteNodeBalanced(&((*treePtr)->rightPtr), value);
+   }
+   else {
+      TreeNodePtr tempPtr = *treePtr;
+
+      if (tempPtr->leftPtr == NULL) {
+         *treePtr = tempPtr->rightPtr;
+      }
+      else if (tempPtr->rightPtr == NULL) {
+         *treePtr = tempPtr->leftPtr;
+      }
+      else { // two children: the in-order successor takes this place
+         TreeNodePtr successorPtr = removeMinimum(&tempPtr->rightPtr);
+         successorPtr->leftPtr = tempPtr->leftPtr;
+         successorPtr->rightPtr = tempPtr->rightPtr;
+         *treePtr = successorPtr;
+      }
+
+      FREE_NODE(tempPtr);
+      deleted = 1;
+   }
+
+   if (deleted && *treePtr != NULL) {
+      rebalance(treePtr);
+   }
+
+   return deleted;
+}
+
+// return the node holding value, or NULL if it is not in the tree
+TreeNodePtr searchTree(TreeNodePtr treePtr, int value)
+{
+   while (treePtr != NULL && treePtr->data != value) {
+      treePtr = value < treePtr->data ? treePtr->leftPtr : treePtr->rightPtr;
+   }
+
+   return treePtr;
+}
+
+// number of levels in the tree, 0 if it is empty
+int treeHeight(TreeNodePtr treePtr)
+{
+   return heightOf(treePtr);
+}
+
+// number of nodes in the tree
+size_t treeSize(TreeNodePtr treePtr)
+{
+   return sizeOf(treePtr);
+}
+
+// return the node with the k-th smallest value (k from 1 to treeSize), or
+// NULL if k is out of range
+TreeNodePtr selectKth(TreeNodePtr treePtr, size_t k)
+{
+   while (treePtr != NULL) {
+      size_t leftSize = sizeOf(treePtr->leftPtr);
+
+      if (k <= leftSize) {
+         treePtr = treePtr->leftPtr;
+      }
+      else if (k == leftSize + 1) {
+         return treePtr;
+      }
+      else { // skip the left subtree and this node
+         k -= leftSize + 1;
+         treePtr = treePtr->rightPtr;
+      }
+   }
+
+   return NULL;
+}
+
+// number of values in the tree smaller than value
+size_t rankOf(TreeNodePtr treePtr, int value)
+{
+   size_t rank = 0;
+
+   while (treePtr != NULL) {
+      if (value <= treePtr->data) {
+         treePtr = treePtr->leftPtr;
+      }
+      else { // this node and its left subtree are all smaller
+         rank += sizeOf(treePtr->leftPtr) + 1;
+         treePtr = treePtr->rightPtr;
+      }
+   }
+
+   return rank;
+}
+
+// number of values v in the tree with low <= v <= high
+size_t rangeCount(TreeNodePtr treePtr, int low, int high)
+{
+   if (low > high) {
+      return 0;
+   }
+
+   // values <= high are those smaller than high, plus high itself
+   size_t atMostHigh =
+      rankOf(treePtr, high) + (searchTree(treePtr, high) != NULL);
+   return atMostHigh - rankOf(treePtr, low);
+}
+
+// free every node without recursion, so even a tree that degenerated into
+// a list cannot overflow the call stack
+void freeTree(TreeNodePtr *treePtr)
+{
+   TreeNodePtr currentPtr = *treePtr;
+
+   while (currentPtr != NULL) {
+      if (currentPtr->leftPtr != NULL) {
+         // rotate the left child up so every node ends up on a right spine
+         TreeNodePtr leftPtr = currentPtr->leftPtr;
+         currentPtr->leftPtr = leftPtr->rightPtr;
+         leftPtr->rightPtr = currentPtr;
+         currentPtr = leftPtr;
+      }
+      else {
+         TreeNodePtr rightPtr = currentPtr->rightPtr;
+         FREE_NODE(currentPtr);
+         currentPtr = rightPtr;
+      }
+   }
+
+   *treePtr = NULL;
+}
+
+// push a node onto an explicit stack, doubling its room when it is full;
+// returns 0 if no memory is available
+static int pushNode(struct nodeStack *stackPtr, TreeNodePtr nodePtr)
+{
+   if (stackPtr->count == stackPtr->capacity) {
+      size_t newCapacity = stackPtr->capacity == 0 ? 64 : 2 * stackPtr->capacity;
+      TreeNodePtr *newNodes =
+         realloc(stackPtr->nodes, newCapacity * sizeof(TreeNodePtr));
+
+      if (newNodes == NULL) {
+         return 0;
+      }
+
+      stackPtr->nodes = newNodes;
+      stackPtr->capacity = newCapacity;
+   }
+
+   stackPtr->nodes[stackPtr->count++] = nodePtr;
+   return 1;
+}
+
+// release the memory of an explicit stack
+static void freeNodeStack(struct nodeStack *stackPtr)
+{
+   free(stackPtr->nodes);
+   stackPtr->nodes = NULL;
+   stackPtr->count = 0;
+   stackPtr->capacity = 0;
+}
+
+// inorder traversal with an explicit stack instead of recursion
+int inOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr)
+{
+   TreeCursor cursor;
+   int value;
+
+   openTreeCursor(&cursor, treePtr);
+
+   while (nextInOrder(&cursor, &value)) {
+      visit(value, contextPtr);
+   }
+
+   // the cursor stops early only if its stack could not grow
+   int completed = cursor.nextPtr == NULL;
+   closeTreeCursor(&cursor);
+   return completed;
+}
+
+// preorder traversal with an explicit stack instead of recursion
+int preOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr)
+{
+   struct nodeStack pending = { NULL, 0, 0 };
+   int completed = 1;
+
+   if (treePtr != NULL) {
+      completed = pushNode(&pending, treePtr);
+   }
+
+   while (completed && pending.count > 0) {
+      TreeNodePtr nodePtr = pending.nodes[--pending.count];
+      visit(nodePtr->data, contextPtr);
+
+      // push right first so the left subtree is visited first
+      if (nodePtr->rightPtr != NULL) {
+         completed = pushNode(&pending, nodePtr->rightPtr);
+      }
+
+      if (completed && nodePtr->leftPtr != NULL) {
+         completed = pushNode(&pending, nodePtr->leftPtr);
+      }
+   }
+
+   freeNodeStack(&pending);
+   return completed;
+}
+
+// postorder traversal with an explicit stack instead of recursion
+int postOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr)
+{
+   struct nodeStack pending = { NULL, 0, 0 };
+   TreeNodePtr currentPtr = treePtr;
+   TreeNodePtr lastVisitedPtr = NULL;
+   int completed = 1;
+
+   while (completed && (currentPtr != NULL || pending.count > 0)) {
+      if (currentPtr != NULL) {
+         // walk left, remembering the path
+         completed = pushNode(&pending, currentPtr);
+         currentPtr = currentPtr->leftPtr;
+      }
+      else {
+         TreeNodePtr topPtr = pending.nodes[pending.count - 1];
+
+         if (topPtr->rightPtr != NULL && topPtr->rightPtr != lastVisitedPtr) {
+            currentPtr = topPtr->rightPtr; // right subtree not done yet
+         }
+         else {
+            visit(topPtr->data, contextPtr);
+            lastVisitedPtr = topPtr;
+            --pending.count;
+         }
+      }
+   }
+
+   freeNodeStack(&pending);
+   return completed;
+}
+
+// inorder traversal in constant extra space (Morris threading): each left
+// subtree's rightmost node temporarily points back to its ancestor, and
+// every thread is removed again before the traversal returns
+void inOrderMorris(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr)
+{
+   TreeNodePtr currentPtr = treePtr;
+
+   while (currentPtr != NULL) {
+      if (currentPtr->leftPtr == NULL) {
+         visit(currentPtr->data, contextPtr);
+         currentPtr = currentPtr->rightPtr;
+      }
+      else {
+         // find the in-order predecessor of currentPtr
+         TreeNodePtr predecessorPtr = currentPtr->leftPtr;
+
+         while (predecessorPtr->rightPtr != NULL &&
+            predecessorPtr->rightPtr != currentPtr) {
+            predecessorPtr = predecessorPtr->rightPtr;
+         }
+
+         if (predecessorPtr->rightPtr == NULL) {
+            // first arrival: thread back to currentPtr and go left
+            predecessorPtr->rightPtr = currentPtr;
+            currentPtr = currentPtr->leftPtr;
+         }
+         else {
+            // second arrival: the left subtree is done, remove the thread
+            predecessorPtr->rightPtr = NULL;
+            visit(currentPtr->data, contextPtr);
+            currentPtr = currentPtr->rightPtr;
+         }
+      }
+   }
+}
+
+// start an in-order walk of treePtr
+void openTreeCursor(TreeCursor *cursorPtr, TreeNodePtr treePtr)
+{
+   cursorPtr->pending.nodes = NULL;
+   cursorPtr->pending.count = 0;
+   cursorPtr->pending.capacity = 0;
+   cursorPtr->nextPtr = treePtr;
+}
+
+// store the next value in *valuePtr and return 1, or return 0 when the walk
+// is over (or its stack could not grow, which leaves nextPtr set)
+int nextInOrder(TreeCursor *cursorPtr, int *valuePtr)
+{
+   // descend to the leftmost node not yet visited
+   while (cursorPtr->nextPtr != NULL) {
+      if (!pushNode(&cursorPtr->pending, cursorPtr->nextPtr)) {
+         return 0;
+      }
+
+      cursorPtr->nextPtr = cursorPtr->nextPtr->leftPtr;
+   }
+
+   if (cursorPtr->pending.count == 0) {
+      return 0;
+   }
+
+   TreeNodePtr nodePtr = cursorPtr->pending.nodes[--cursorPtr->pending.count];
+   *valuePtr = nodePtr->data;
+   cursorPtr->nextPtr = nodePtr->rightPtr;
+   return 1;
+}
+
+// release the cursor's stack
+void closeTreeCursor(TreeCursor *cursorPtr)
+{
+   freeNodeStack(&cursorPtr->pending);
+   cursorPtr->nextPtr = NULL;
+}
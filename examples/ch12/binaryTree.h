@@ -0,0 +1,88 @@
+// binaryTree.h
+// Binary search tree of Fig. 12.19 with an optional self-balancing (AVL)
+// mode that keeps the depth O(log n) for any insertion order, and subtree
+// sizes for order-statistic queries.
+// Tree functions are defined in binaryTree.c
+
+// prevent multiple inclusions of header
+#ifndef BINARYTREE_H
+#define BINARYTREE_H
+
+#include <stddef.h>
+
+// self-referential structure
+struct treeNode {
+   struct treeNode *leftPtr; // pointer to left subtree
+   int data; // node value
+   struct treeNode *rightPtr; // pointer to right subtree
+   int height; // levels in this subtree, 1 for a leaf
+   unsigned int size; // nodes in this subtree, 1 for a leaf
+};
+
+typedef struct treeNode TreeNode; // synonym for struct treeNode
+typedef TreeNode *TreeNodePtr; // synonym for TreeNode*
+
+// with -DUSE_NODE_POOL every TreeNode comes from treeNodePool
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+extern NodePool treeNodePool;
+#endif
+
+// called once per node by the iterative traversals with the node's value
+// and the caller's context, e.g. to fold a sum without printing
+typedef void (*TreeVisitor)(int value, void *contextPtr);
+
+// explicit stack of nodes still to be visited
+struct nodeStack {
+   TreeNodePtr *nodes; // grows as needed on the heap
+   size_t count; // nodes on the stack
+   size_t capacity; // room in nodes
+};
+
+// in-order cursor: each call to nextInOrder resumes where the previous
+// one stopped; the tree must not change while a cursor is open
+struct treeCursor {
+   struct nodeStack pending; // ancestors whose value is still to come
+   TreeNodePtr nextPtr; // root of the subtree to descend next
+};
+
+typedef struct treeCursor TreeCursor; // synonym for struct treeCursor
+
+// prototypes for the unbalanced tree of Fig. 12.19
+void insertNode(TreeNodePtr *treePtr, int value);
+void inOrder(TreeNodePtr treePtr);
+void preOrder(TreeNodePtr treePtr);
+void postOrder(TreeNodePtr treePtr);
+
+// prototypes for the balanced (AVL) mode; a tree must be built with either
+// insertNode or insertNodeBalanced, not both
+int insertNodeBalanced(TreeNodePtr *treePtr, int value);
+int buildTreeFromSorted(TreeNodePtr *treePtr, const int sorted[],
+   size_t count);
+int deleteNodeBalanced(TreeNodePtr *treePtr, int value);
+
+// prototypes for either mode
+TreeNodePtr searchTree(TreeNodePtr treePtr, int value);
+int treeHeight(TreeNodePtr treePtr);
+size_t treeSize(TreeNodePtr treePtr);
+void freeTree(TreeNodePtr *treePtr);
+
+// prototypes for order statistics, which use the subtree sizes and take
+// time proportional to the tree height (O(log n) in balanced mode)
+TreeNodePtr selectKth(TreeNodePtr treePtr, size_t k);
+size_t rankOf(TreeNodePtr treePtr, int value);
+size_t rangeCount(TreeNodePtr treePtr, int low, int high);
+
+// prototypes for iterative traversals, which never recurse; they return 0
+// if memory for the explicit stack ran out before the traversal finished
+int inOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr);
+int preOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr);
+int postOrderVisit(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr);
+void inOrderMorris(TreeNodePtr treePtr, TreeVisitor visit, void *contextPtr);
+
+// prototypes for the pausable in-order cursor
+void openTreeCursor(TreeCursor *cursorPtr, TreeNodePtr treePtr);
+int nextInOrder(TreeCursor *cursorPtr, int *valuePtr);
+void closeTreeCursor(TreeCursor *cursorPtr);
+
+#endif
@@ -0,0 +1,162 @@
+// ch12BalancedTreeBenchmark.c
+// Inserts sorted and random keys into the unbalanced Fig. 12.19 tree and
+// into the balanced (AVL) mode, reporting inserts per second, lookups per
+// second and the resulting tree height.
+// NOTE: This file must be compiled with binaryTree.c, for example
+//    gcc -O2 ch12BalancedTreeBenchmark.c binaryTree.c -o ch12BalancedTreeBenchmark
+// Usage: ch12BalancedTreeBenchmark [numberOfKeys]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "binaryTree.h"
+
+#define DEFAULT_KEYS 10000000
+
+// sorted input makes the unbalanced tree a list: n insertions cost O(n^2)
+// and the recursion in insertNode is n calls deep, so cap that case
+#define UNBALANCED_SORTED_LIMIT 20000
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers; rand() is too coarse for 10M keys
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// fill keys with 0 .. count - 1, shuffled unless sorted is requested
+static void makeKeys(int keys[], size_t count, int sorted)
+{
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < count; ++i) {
+      keys[i] = (int) i;
+   }
+
+   // Fisher-Yates shuffle
+   for (size_t i = count - 1; !sorted && i > 0; --i) {
+      size_t j = nextRandom(&state) % (i + 1);
+      int temp = keys[i];
+      keys[i] = keys[j];
+      keys[j] = temp;
+   }
+}
+
+// build one tree from keys, look every key up again, and report
+static void run(const char *order, const char *mode, const int keys[],
+   size_t count, int balanced)
+{
+   TreeNodePtr rootPtr = NULL;
+
+   double start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      if (balanced) {
+         insertNodeBalanced(&rootPtr, keys[i]);
+      }
+      else {
+         insertNode(&rootPtr, keys[i]);
+      }
+   }
+
+   double insertSeconds = secondsNow() - start;
+   size_t found = 0;
+
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      found += searchTree(rootPtr, keys[i]) != NULL;
+   }
+
+   double searchSeconds = secondsNow() - start;
+
+   printf("%-8s%-12s%12zu%14.2f%14.2f%10d%s\n", order, mode, count,
+      count / insertSeconds / 1e6, count / searchSeconds / 1e6,
+      treeHeight(rootPtr), found == count ? "" : "  KEYS MISSING");
+
+   freeTree(&rootPtr);
+}
+
+// delete every other key from a balanced tree and check what is left
+static int checkBalancedDelete(const int keys[], size_t count)
+{
+   TreeNodePtr rootPtr = NULL;
+   int passed = 1;
+
+   for (size_t i = 0; i < count; ++i) {
+      insertNodeBalanced(&rootPtr, keys[i]);
+   }
+
+   for (size_t i = 0; i < count; i += 2) {
+      passed &= deleteNodeBalanced(&rootPtr, keys[i]);
+   }
+
+   for (size_t i = 0; i < count; ++i) {
+      int shouldBeFound = i % 2 == 1;
+      passed &= (searchTree(rootPtr, keys[i]) != NULL) == shouldBeFound;
+   }
+
+   // an AVL tree of n nodes is at most about 1.44 log2(n) levels deep
+   size_t remaining = count / 2;
+   int limit = 2;
+
+   while (remaining > 1) {
+      remaining /= 2;
+      ++limit;
+   }
+
+   passed &= treeHeight(rootPtr) <= limit * 3 / 2;
+   freeTree(&rootPtr);
+   return passed;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t count = DEFAULT_KEYS;
+
+   if (argc > 1) {
+      count = strtoul(argv[1], NULL, 10);
+   }
+
+   int *keys = malloc(count * sizeof(int));
+
+   if (count < 2 || keys == NULL) {
+      puts("Cannot allocate the keys.");
+      return EXIT_FAILURE;
+   }
+
+   size_t sortedLimit =
+      count < UNBALANCED_SORTED_LIMIT ? count : UNBALANCED_SORTED_LIMIT;
+
+   puts("Millions of operations per second");
+   printf("%-8s%-12s%12s%14s%14s%10s\n", "Order", "Tree", "Keys", "insert",
+      "search", "Height");
+
+   makeKeys(keys, count, 1);
+   run("sorted", "unbalanced", keys, sortedLimit, 0);
+   run("sorted", "balanced", keys, count, 1);
+
+   makeKeys(keys, count, 0);
+   run("random", "unbalanced", keys, count, 0);
+   run("random", "balanced", keys, count, 1);
+
+   size_t checkCount = count < 100000 ? count : 100000;
+   printf("\nBalanced delete check on %zu keys: %s\n", checkCount,
+      checkBalancedDelete(keys, checkCount) ? "passed" : "FAILED");
+
+   if (sortedLimit < count) {
+      printf("Unbalanced sorted run capped at %zu keys: it is O(n^2) and "
+         "recurses once per level.\n", sortedLimit);
+   }
+
+   free(keys);
+}
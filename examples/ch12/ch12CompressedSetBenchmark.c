@@ -0,0 +1,269 @@
+// ch12CompressedSetBenchmark.c
+// Stores random distinct IDs in the sorted list of ch12SingleLLAddDelete
+// and in the compressed set, and reports bytes per value and millions of
+// inserts, membership tests, deletes and values walked per second.
+// NOTE: This file must be compiled with compressedSet.c, for example
+//    gcc -O2 ch12CompressedSetBenchmark.c compressedSet.c -o ch12CompressedSetBenchmark
+// Usage: ch12CompressedSetBenchmark [values] [averageGap]
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "compressedSet.h"
+
+#define DEFAULT_VALUES 10000000
+#define DEFAULT_GAP 8 // IDs are spread over values * gap numbers
+
+// building the linked list is O(n^2), so it is only run at this size
+#define LINKED_LIST_VALUES 20000
+
+// ch12SingleLLAddDelete list node
+typedef struct node {
+   int data;
+   struct node *nextNodePtr;
+} Node;
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// ch12SingleLLAddDelete insertNode: walk to the sorted position
+static void insertNode(Node **headPtr, int number)
+{
+   Node *newNodePtr = malloc(sizeof(Node));
+   newNodePtr->data = number;
+
+   Node *previousPtr = NULL;
+   Node *currentPtr = *headPtr;
+
+   while (currentPtr != NULL && currentPtr->data <= number) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextNodePtr;
+   }
+
+   if (previousPtr == NULL) {
+      *headPtr = newNodePtr;
+   }
+   else {
+      previousPtr->nextNodePtr = newNodePtr;
+   }
+
+   newNodePtr->nextNodePtr = currentPtr;
+}
+
+// ch12SingleLLAddDelete deleteNode; returns 1 if number was found
+static int deleteNode(Node **headPtr, int numberToDelete)
+{
+   Node *previousPtr = NULL;
+   Node *currentPtr = *headPtr;
+
+   while (currentPtr != NULL && currentPtr->data < numberToDelete) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextNodePtr;
+   }
+
+   if (currentPtr == NULL || currentPtr->data != numberToDelete) {
+      return 0;
+   }
+
+   if (previousPtr == NULL) {
+      *headPtr = currentPtr->nextNodePtr;
+   }
+   else {
+      previousPtr->nextNodePtr = currentPtr->nextNodePtr;
+   }
+
+   free(currentPtr);
+   return 1;
+}
+
+// return 1 if number is in the sorted list
+static int containsNode(const Node *currentPtr, int number)
+{
+   while (currentPtr != NULL && currentPtr->data < number) {
+      currentPtr = currentPtr->nextNodePtr;
+   }
+
+   return currentPtr != NULL && currentPtr->data == number;
+}
+
+// inOrderCompressed callback: add the value to a running sum
+static void addValue(int value, void *contextPtr)
+{
+   *(long long *) contextPtr += value;
+}
+
+// print one row of the results table
+static void printRow(const char *name, size_t count, double bytes,
+   double inserts, double lookups, double walks, double deletes)
+{
+   printf("%-16s%10zu%8.2f%10.3f%10.3f%10.1f%10.3f\n", name, count, bytes,
+      inserts, lookups, walks, deletes);
+}
+
+// time the list on ids[0 .. count - 1]; returns the sum of the values
+static long long runList(const int ids[], size_t count)
+{
+   Node *headPtr = NULL;
+   double start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      insertNode(&headPtr, ids[i]);
+   }
+
+   double inserts = count / (secondsNow() - start) / 1e6;
+   size_t found = 0;
+   start = secondsNow();
+
+   // every other lookup is for a value just past an ID, usually absent
+   for (size_t i = 0; i < count; ++i) {
+      found += containsNode(headPtr, ids[i] + (int) (i % 2));
+   }
+
+   double lookups = count / (secondsNow() - start) / 1e6;
+   long long sum = 0;
+   start = secondsNow();
+
+   for (const Node *currentPtr = headPtr; currentPtr != NULL;
+      currentPtr = currentPtr->nextNodePtr) {
+      sum += currentPtr->data;
+   }
+
+   double walks = count / (secondsNow() - start) / 1e6;
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; i += 2) {
+      deleteNode(&headPtr, ids[i]);
+   }
+
+   double deletes = (count + 1) / 2 / (secondsNow() - start) / 1e6;
+
+   printRow("linked list", count, (double) sizeof(Node), inserts, lookups,
+      walks, deletes);
+
+   while (headPtr != NULL) {
+      Node *tempPtr = headPtr;
+      headPtr = headPtr->nextNodePtr;
+      free(tempPtr);
+   }
+
+   return sum + (long long) found;
+}
+
+// the same work on the compressed set; returns the sum of the values
+static long long runCompressed(const int ids[], size_t count)
+{
+   CompressedSet set;
+   initCompressedSet(&set);
+   double start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      insertCompressed(&set, ids[i]);
+   }
+
+   double inserts = count / (secondsNow() - start) / 1e6;
+   double bytes = (double) compressedSetBytes(&set) / set.count;
+   size_t found = 0;
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      found += containsCompressed(&set, ids[i] + (int) (i % 2));
+   }
+
+   double lookups = count / (secondsNow() - start) / 1e6;
+   long long sum = 0;
+   start = secondsNow();
+   inOrderCompressed(&set, addValue, &sum);
+   double walks = count / (secondsNow() - start) / 1e6;
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; i += 2) {
+      deleteCompressed(&set, ids[i]);
+   }
+
+   double deletes = (count + 1) / 2 / (secondsNow() - start) / 1e6;
+
+   printRow("compressed set", count, bytes, inserts, lookups, walks,
+      deletes);
+
+   if (set.count != count / 2) {
+      puts("Compressed set lost or kept values it should not have.");
+   }
+
+   freeCompressedSet(&set);
+   return sum + (long long) found;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t count = DEFAULT_VALUES;
+   unsigned int gap = DEFAULT_GAP;
+
+   if (argc > 1) {
+      count = strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      gap = (unsigned int) strtoul(argv[2], NULL, 10);
+   }
+
+   if (gap < 1) {
+      gap = 1;
+   }
+
+   if ((unsigned long long) count * gap > INT_MAX) {
+      puts("values * averageGap must be below 2^31.");
+      return EXIT_FAILURE;
+   }
+
+   int *ids = malloc(count * sizeof(int));
+
+   if (ids == NULL) {
+      puts("Cannot allocate the IDs.");
+      return EXIT_FAILURE;
+   }
+
+   // distinct IDs: one random ID from each run of gap numbers, shuffled
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < count; ++i) {
+      ids[i] = (int) (i * gap + nextRandom(&state) % gap);
+   }
+
+   for (size_t i = count - 1; i > 0; --i) {
+      size_t j = nextRandom(&state) % (i + 1);
+      int temp = ids[i];
+      ids[i] = ids[j];
+      ids[j] = temp;
+   }
+
+   size_t listCount = count < LINKED_LIST_VALUES ? count : LINKED_LIST_VALUES;
+
+   printf("Random IDs, one per %u numbers; millions per second\n", gap);
+   printf("%-16s%10s%8s%10s%10s%10s%10s\n", "Set", "Values", "B/value",
+      "insert", "contains", "walk", "delete");
+
+   // the first listCount IDs are spread over the whole range too
+   int agree = runList(ids, listCount) == runCompressed(ids, listCount);
+   runCompressed(ids, count);
+
+   printf("\nList and compressed set agree on %zu values: %s\n", listCount,
+      agree ? "yes" : "NO");
+   printf("B/value counts the list node or the compressed words and block "
+      "headers,\nwithout malloc overhead.\n");
+   free(ids);
+   return agree ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,254 @@
+// ch12ConcurrentTreeBenchmark.c
+// Mixed search/insert benchmark of the concurrent tree against the
+// balanced Fig. 12.19 tree guarded by one mutex, from one thread up to
+// maxThreads. A check run then inserts from several threads at once and
+// verifies that every value is found exactly once in ascending order.
+// NOTE: This file must be compiled with concurrentTree.c and binaryTree.c,
+// for example
+//    gcc -O2 ch12ConcurrentTreeBenchmark.c concurrentTree.c binaryTree.c -o ch12ConcurrentTreeBenchmark
+// Usage: ch12ConcurrentTreeBenchmark [maxThreads] [operationsPerRun]
+//        [searchPercent]
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+#include "binaryTree.h"
+#include "concurrentTree.h"
+
+#define DEFAULT_OPERATIONS 4000000
+#define DEFAULT_SEARCH_PERCENT 90
+#define INITIAL_VALUES 1000000
+#define MAX_THREADS 64
+#define CHECK_THREADS 4
+#define CHECK_VALUES_PER_THREAD 250000
+
+static ConcurrentTree concurrentTree;
+
+static TreeNodePtr lockedRootPtr = NULL;
+static mtx_t treeMutex;
+
+// arguments for one benchmark or check thread
+struct workerArgs {
+   unsigned int threadIndex;
+   size_t operations;
+   unsigned int searchPercent;
+   int useConcurrent;
+   size_t found; // searches that found their value
+};
+
+// running state of the in-order check
+struct walkState {
+   long long previous;
+   size_t count;
+   int sorted;
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// each operation searches for or inserts a random key
+static int mixedWorker(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   unsigned long long state = 2060 + args->threadIndex;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      unsigned long long bits = nextRandom(&state);
+      int key = (int) (bits >> 34);
+      int search = bits % 100 < args->searchPercent;
+
+      if (args->useConcurrent) {
+         if (search) {
+            args->found += searchConcurrent(&concurrentTree, key);
+         }
+         else {
+            insertConcurrent(&concurrentTree, key);
+         }
+      }
+      else {
+         mtx_lock(&treeMutex);
+
+         if (search) {
+            args->found += searchTree(lockedRootPtr, key) != NULL;
+         }
+         else {
+            insertNodeBalanced(&lockedRootPtr, key);
+         }
+
+         mtx_unlock(&treeMutex);
+      }
+   }
+
+   return 0;
+}
+
+// run operations split over threadCount threads on a tree holding the
+// same initial values; returns millions of operations per second
+static double runMixed(unsigned int threadCount, size_t operations,
+   unsigned int searchPercent, int useConcurrent)
+{
+   thrd_t threads[MAX_THREADS];
+   struct workerArgs args[MAX_THREADS];
+   unsigned long long state = 99;
+
+   for (size_t i = 0; i < INITIAL_VALUES; ++i) {
+      int key = (int) (nextRandom(&state) >> 34);
+
+      if (useConcurrent) {
+         insertConcurrent(&concurrentTree, key);
+      }
+      else {
+         insertNodeBalanced(&lockedRootPtr, key);
+      }
+   }
+
+   double start = secondsNow();
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      args[t] = (struct workerArgs)
+         {t, operations / threadCount, searchPercent, useConcurrent, 0};
+      thrd_create(&threads[t], mixedWorker, &args[t]);
+   }
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      thrd_join(threads[t], NULL);
+   }
+
+   double seconds = secondsNow() - start;
+
+   if (useConcurrent) {
+      freeConcurrentTree(&concurrentTree);
+   }
+   else {
+      freeTree(&lockedRootPtr);
+   }
+
+   return operations / threadCount * threadCount / seconds / 1e6;
+}
+
+// insert this thread's share of the check values, searching for each
+// value right after inserting it
+static int checkWorker(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   unsigned long long state = 7 + args->threadIndex;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      // spread the values: value v is inserted by thread v % CHECK_THREADS
+      size_t slot = nextRandom(&state) % args->operations;
+      int value = (int) (slot * CHECK_THREADS + args->threadIndex);
+
+      insertConcurrent(&concurrentTree, value);
+      args->found += searchConcurrent(&concurrentTree, value);
+   }
+
+   return 0;
+}
+
+// inOrderConcurrent callback: count values and check ascending order
+static void checkValue(int value, void *contextPtr)
+{
+   struct walkState *walkPtr = contextPtr;
+
+   if (value <= walkPtr->previous) {
+      walkPtr->sorted = 0;
+   }
+
+   walkPtr->previous = value;
+   ++walkPtr->count;
+}
+
+// every value a thread inserted must be found, and the tree must hold
+// each value once
+static int checkTree(void)
+{
+   thrd_t threads[CHECK_THREADS];
+   struct workerArgs args[CHECK_THREADS];
+
+   for (unsigned int t = 0; t < CHECK_THREADS; ++t) {
+      args[t] = (struct workerArgs) {t, CHECK_VALUES_PER_THREAD, 0, 1, 0};
+      thrd_create(&threads[t], checkWorker, &args[t]);
+   }
+
+   size_t found = 0;
+
+   for (unsigned int t = 0; t < CHECK_THREADS; ++t) {
+      thrd_join(threads[t], NULL);
+      found += args[t].found;
+   }
+
+   // threads draw slots at random, so count the distinct values drawn
+   size_t total = (size_t) CHECK_THREADS * CHECK_VALUES_PER_THREAD;
+   size_t distinct = 0;
+
+   for (size_t value = 0; value < total; ++value) {
+      distinct += searchConcurrent(&concurrentTree, (int) value);
+   }
+
+   struct walkState walk = {-1, 0, 1};
+   inOrderConcurrent(&concurrentTree, checkValue, &walk);
+
+   int passed = found == total && walk.sorted && walk.count == distinct;
+
+   printf("Check, %d threads inserting %zu values: %s\n\n", CHECK_THREADS,
+      total, passed ? "passed" : "FAILED");
+
+   freeConcurrentTree(&concurrentTree);
+   return passed;
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned int maxThreads = (unsigned int) sysconf(_SC_NPROCESSORS_ONLN);
+   size_t operations = DEFAULT_OPERATIONS;
+   unsigned int searchPercent = DEFAULT_SEARCH_PERCENT;
+
+   if (argc > 1) {
+      maxThreads = (unsigned int) strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      operations = strtoul(argv[2], NULL, 10);
+   }
+
+   if (argc > 3) {
+      searchPercent = (unsigned int) strtoul(argv[3], NULL, 10);
+   }
+
+   if (maxThreads < 1 || maxThreads > MAX_THREADS) {
+      maxThreads = maxThreads < 1 ? 1 : MAX_THREADS;
+   }
+
+   mtx_init(&treeMutex, mtx_plain);
+   initConcurrentTree(&concurrentTree);
+
+   int passed = checkTree();
+
+   printf("Millions of operations per second, %u%% searches, %u%% "
+      "inserts\n", searchPercent, 100 - searchPercent);
+   printf("%8s%14s%14s\n", "Threads", "mutex", "concurrent");
+
+   for (unsigned int t = 1; t <= maxThreads; ++t) {
+      double lockedRate = runMixed(t, operations, searchPercent, 0);
+      double concurrentRate = runMixed(t, operations, searchPercent, 1);
+      printf("%8u%14.2f%14.2f\n", t, lockedRate, concurrentRate);
+   }
+
+   mtx_destroy(&treeMutex);
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
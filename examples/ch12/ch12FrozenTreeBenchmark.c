@@ -0,0 +1,103 @@
+// ch12FrozenTreeBenchmark.c
+// Lookups per second in the pointer tree and in its frozen (Eytzinger)
+// copy, for trees from L1-cache size to far beyond the last-level cache.
+// NOTE: This file must be compiled with binaryTree.c and frozenTree.c, e.g.
+//    gcc -O2 ch12FrozenTreeBenchmark.c binaryTree.c frozenTree.c -o ch12FrozenTreeBenchmark
+// Usage: ch12FrozenTreeBenchmark [largestNumberOfKeys]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "binaryTree.h"
+#include "frozenTree.h"
+
+#define SMALLEST_KEYS 1024 // 4 KB of frozen keys fits in any L1 cache
+#define DEFAULT_LARGEST_KEYS (1 << 24) // 64 MB frozen, 512 MB+ as nodes
+#define LOOKUPS 4000000
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t largest = DEFAULT_LARGEST_KEYS;
+
+   if (argc > 1) {
+      largest = strtoul(argv[1], NULL, 10);
+   }
+
+   int *sorted = malloc(largest * sizeof(int));
+   int *queries = malloc(LOOKUPS * sizeof(int));
+
+   if (sorted == NULL || queries == NULL) {
+      puts("Cannot allocate the keys.");
+      return EXIT_FAILURE;
+   }
+
+   puts("Millions of lookups per second (about half of them hits)");
+   printf("%12s%12s%14s%14s%10s\n", "Keys", "Frozen KB", "pointer tree",
+      "frozen", "Speedup");
+
+   for (size_t count = SMALLEST_KEYS; count <= largest; count *= 4) {
+      // even keys only, so odd queries miss
+      for (size_t i = 0; i < count; ++i) {
+         sorted[i] = (int) (2 * i);
+      }
+
+      unsigned long long state = 2060;
+
+      for (size_t i = 0; i < LOOKUPS; ++i) {
+         queries[i] = (int) (nextRandom(&state) % (2 * count));
+      }
+
+      TreeNodePtr rootPtr = NULL;
+      FrozenTree frozen;
+
+      if (!buildTreeFromSorted(&rootPtr, sorted, count) ||
+         !freezeTree(&frozen, rootPtr)) {
+         puts("Out of memory.");
+         break;
+      }
+
+      size_t pointerHits = 0;
+      double start = secondsNow();
+
+      for (size_t i = 0; i < LOOKUPS; ++i) {
+         pointerHits += searchTree(rootPtr, queries[i]) != NULL;
+      }
+
+      double pointerSeconds = secondsNow() - start;
+      size_t frozenHits = 0;
+      start = secondsNow();
+
+      for (size_t i = 0; i < LOOKUPS; ++i) {
+         frozenHits += searchFrozenTree(&frozen, queries[i]);
+      }
+
+      double frozenSeconds = secondsNow() - start;
+
+      printf("%12zu%12zu%14.2f%14.2f%9.2fx%s\n", count,
+         count * sizeof(int) / 1024, LOOKUPS / pointerSeconds / 1e6,
+         LOOKUPS / frozenSeconds / 1e6, pointerSeconds / frozenSeconds,
+         pointerHits == frozenHits ? "" : "  RESULTS DIFFER");
+
+      freeFrozenTree(&frozen);
+      freeTree(&rootPtr);
+   }
+
+   free(sorted);
+   free(queries);
+}
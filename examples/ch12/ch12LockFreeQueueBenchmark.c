@@ -0,0 +1,274 @@
+// ch12LockFreeQueueBenchmark.c
+// Stress test and throughput benchmark for the lock-free queue, compared
+// with the fig12_13 queue guarded by one mutex.
+// NOTE: This file must be compiled with lockFreeQueue.c, for example
+//    gcc -O2 ch12LockFreeQueueBenchmark.c lockFreeQueue.c -o ch12LockFreeQueueBenchmark
+// Usage: ch12LockFreeQueueBenchmark [maxThreads] [operationsPerRun]
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+#include "lockFreeQueue.h"
+
+#define DEFAULT_OPERATIONS 4000000
+#define STRESS_ITEMS_PER_PRODUCER 500000
+#define STRESS_PRODUCERS 4
+#define STRESS_CONSUMERS 4
+
+// fig12_13 queue node, shared through a single mutex for the baseline
+struct queueNode {
+   int data;
+   struct queueNode *nextPtr;
+};
+
+typedef struct queueNode QueueNode;
+typedef QueueNode *QueueNodePtr;
+
+static LockFreeQueue lockFreeQueue; // too large for a thread's stack
+
+static QueueNodePtr headPtr = NULL;
+static QueueNodePtr tailPtr = NULL;
+static mtx_t queueMutex;
+
+// arguments for one benchmark or stress thread
+struct workerArgs {
+   unsigned int threadIndex;
+   size_t operations;
+   int useLockFree;
+   atomic_size_t *consumedPtr; // stress test: items taken so far
+   size_t totalItems; // stress test: items all producers will enqueue
+   long long sum; // stress test: sum of the values this consumer took
+   int orderError; // stress test: a producer's items arrived out of order
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// fig12_13 enqueue under the mutex
+static void enqueueLocked(int value)
+{
+   QueueNodePtr newPtr = malloc(sizeof(QueueNode));
+   newPtr->data = value;
+   newPtr->nextPtr = NULL;
+
+   mtx_lock(&queueMutex);
+
+   if (headPtr == NULL) {
+      headPtr = newPtr;
+   }
+   else {
+      tailPtr->nextPtr = newPtr;
+   }
+
+   tailPtr = newPtr;
+   mtx_unlock(&queueMutex);
+}
+
+// fig12_13 dequeue under the mutex; returns 0 if the queue is empty
+static int dequeueLocked(int *valuePtr)
+{
+   mtx_lock(&queueMutex);
+   QueueNodePtr tempPtr = headPtr;
+
+   if (tempPtr != NULL) {
+      headPtr = headPtr->nextPtr;
+
+      if (headPtr == NULL) {
+         tailPtr = NULL;
+      }
+   }
+
+   mtx_unlock(&queueMutex);
+
+   if (tempPtr == NULL) {
+      return 0;
+   }
+
+   *valuePtr = tempPtr->data;
+   free(tempPtr);
+   return 1;
+}
+
+// each operation is one enqueue followed by one dequeue
+static int pairsWorker(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int value;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      if (args->useLockFree) {
+         enqueueLockFree(&lockFreeQueue, args->threadIndex, (int) i);
+         dequeueLockFree(&lockFreeQueue, args->threadIndex, &value);
+      }
+      else {
+         enqueueLocked((int) i);
+         dequeueLocked(&value);
+      }
+   }
+
+   return 0;
+}
+
+// run operations enqueue/dequeue pairs split over threadCount threads and
+// return millions of queue operations per second
+static double runPairs(unsigned int threadCount, size_t operations,
+   int useLockFree)
+{
+   thrd_t threads[MAX_QUEUE_THREADS];
+   struct workerArgs args[MAX_QUEUE_THREADS];
+
+   double start = secondsNow();
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      args[t].threadIndex = t;
+      args[t].operations = operations / threadCount;
+      args[t].useLockFree = useLockFree;
+      thrd_create(&threads[t], pairsWorker, &args[t]);
+   }
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      thrd_join(threads[t], NULL);
+   }
+
+   double seconds = secondsNow() - start;
+   return 2.0 * (operations / threadCount * threadCount) / seconds / 1e6;
+}
+
+// producer t enqueues t, t + P, t + 2P, ... so every value is unique and
+// each producer's values increase
+static int producer(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      int value = (int) (i * STRESS_PRODUCERS + args->threadIndex);
+
+      while (!enqueueLockFree(&lockFreeQueue, args->threadIndex, value)) {
+         thrd_yield();
+      }
+   }
+
+   return 0;
+}
+
+// consumers drain until every produced item has been taken, checking that
+// values from one producer come out in the order they went in
+static int consumer(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int lastSeen[STRESS_PRODUCERS];
+   int value;
+
+   for (size_t p = 0; p < STRESS_PRODUCERS; ++p) {
+      lastSeen[p] = -1;
+   }
+
+   while (atomic_load(args->consumedPtr) < args->totalItems) {
+      if (dequeueLockFree(&lockFreeQueue, args->threadIndex, &value)) {
+         atomic_fetch_add(args->consumedPtr, 1);
+         args->sum += value;
+
+         int source = value % STRESS_PRODUCERS;
+
+         if (value <= lastSeen[source]) {
+            args->orderError = 1;
+         }
+
+         lastSeen[source] = value;
+      }
+      else {
+         thrd_yield();
+      }
+   }
+
+   return 0;
+}
+
+// several producers and consumers share one queue; every item must come out
+// exactly once and in per-producer FIFO order
+static int stressTest(void)
+{
+   thrd_t threads[STRESS_PRODUCERS + STRESS_CONSUMERS];
+   struct workerArgs args[STRESS_PRODUCERS + STRESS_CONSUMERS];
+   atomic_size_t consumed;
+   size_t totalItems = (size_t) STRESS_PRODUCERS * STRESS_ITEMS_PER_PRODUCER;
+
+   atomic_init(&consumed, 0);
+   initLockFreeQueue(&lockFreeQueue);
+
+   for (unsigned int t = 0; t < STRESS_PRODUCERS + STRESS_CONSUMERS; ++t) {
+      args[t].threadIndex = t;
+      args[t].operations = STRESS_ITEMS_PER_PRODUCER;
+      args[t].consumedPtr = &consumed;
+      args[t].totalItems = totalItems;
+      args[t].sum = 0;
+      args[t].orderError = 0;
+      thrd_create(&threads[t], t < STRESS_PRODUCERS ? producer : consumer,
+         &args[t]);
+   }
+
+   long long sum = 0;
+   int orderError = 0;
+
+   for (unsigned int t = 0; t < STRESS_PRODUCERS + STRESS_CONSUMERS; ++t) {
+      thrd_join(threads[t], NULL);
+      sum += args[t].sum;
+      orderError |= args[t].orderError;
+   }
+
+   // the values are exactly 0 .. totalItems - 1
+   long long expected = (long long) totalItems * (totalItems - 1) / 2;
+   int passed = sum == expected && !orderError &&
+      isEmptyLockFree(&lockFreeQueue, 0);
+
+   printf("Stress test, %d producers and %d consumers, %zu items: %s\n\n",
+      STRESS_PRODUCERS, STRESS_CONSUMERS, totalItems,
+      passed ? "passed" : "FAILED");
+
+   destroyLockFreeQueue(&lockFreeQueue);
+   return passed;
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned int maxThreads = (unsigned int) sysconf(_SC_NPROCESSORS_ONLN);
+   size_t operations = DEFAULT_OPERATIONS;
+
+   if (argc > 1) {
+      maxThreads = (unsigned int) strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      operations = strtoul(argv[2], NULL, 10);
+   }
+
+   if (maxThreads < 1 || maxThreads > MAX_QUEUE_THREADS) {
+      maxThreads = maxThreads < 1 ? 1 : MAX_QUEUE_THREADS;
+   }
+
+   mtx_init(&queueMutex, mtx_plain);
+
+   int passed = stressTest();
+
+   puts("Millions of queue operations per second (enqueue/dequeue pairs)");
+   printf("%8s%14s%14s\n", "Threads", "mutex", "lock-free");
+
+   for (unsigned int t = 1; t <= maxThreads; ++t) {
+      double lockedRate = runPairs(t, operations, 0);
+
+      initLockFreeQueue(&lockFreeQueue);
+      double lockFreeRate = runPairs(t, operations, 1);
+      destroyLockFreeQueue(&lockFreeQueue);
+
+      printf("%8u%14.2f%14.2f\n", t, lockedRate, lockFreeRate);
+   }
+
+   mtx_destroy(&queueMutex);
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,245 @@
+// ch12LockFreeStackBenchmark.c
+// Multi-thread benchmark of the Treiber stack against the fig12_08 stack
+// guarded by one mutex, plus a check that popAll and pop lose nothing.
+// NOTE: This file must be compiled with lockFreeStack.c, for example
+//    gcc -O2 ch12LockFreeStackBenchmark.c lockFreeStack.c -o ch12LockFreeStackBenchmark
+// Usage: ch12LockFreeStackBenchmark [maxThreads] [operationsPerRun]
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <time.h>
+#include <unistd.h>
+#include "lockFreeStack.h"
+
+#define DEFAULT_OPERATIONS 4000000
+#define MAX_THREADS 64
+#define CHECK_THREADS 4
+#define CHECK_ITEMS_PER_THREAD 250000
+#define STACK_CAPACITY (CHECK_THREADS * CHECK_ITEMS_PER_THREAD)
+
+// fig12_08 stack node, shared through a single mutex for the baseline
+struct stackNode {
+   int data;
+   struct stackNode *nextPtr;
+};
+
+typedef struct stackNode StackNode;
+typedef StackNode *StackNodePtr;
+
+static LockFreeStack lockFreeStack;
+
+static StackNodePtr stackPtr = NULL;
+static mtx_t stackMutex;
+
+// arguments for one benchmark or check thread
+struct workerArgs {
+   unsigned int threadIndex;
+   size_t operations;
+   int useLockFree;
+   atomic_size_t *takenPtr; // check: values removed so far
+   long long sum; // check: sum of the values this thread removed
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// fig12_08 push under the mutex
+static void pushLocked(int info)
+{
+   StackNodePtr newPtr = malloc(sizeof(StackNode));
+   newPtr->data = info;
+
+   mtx_lock(&stackMutex);
+   newPtr->nextPtr = stackPtr;
+   stackPtr = newPtr;
+   mtx_unlock(&stackMutex);
+}
+
+// fig12_08 pop under the mutex; returns 0 if the stack is empty
+static int popLocked(int *valuePtr)
+{
+   mtx_lock(&stackMutex);
+   StackNodePtr tempPtr = stackPtr;
+
+   if (tempPtr != NULL) {
+      stackPtr = stackPtr->nextPtr;
+   }
+
+   mtx_unlock(&stackMutex);
+
+   if (tempPtr == NULL) {
+      return 0;
+   }
+
+   *valuePtr = tempPtr->data;
+   free(tempPtr);
+   return 1;
+}
+
+// each operation is one push followed by one pop
+static int pairsWorker(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int value;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      if (args->useLockFree) {
+         pushLockFree(&lockFreeStack, (int) i);
+         popLockFree(&lockFreeStack, &value);
+      }
+      else {
+         pushLocked((int) i);
+         popLocked(&value);
+      }
+   }
+
+   return 0;
+}
+
+// run operations push/pop pairs split over threadCount threads and return
+// millions of stack operations per second
+static double runPairs(unsigned int threadCount, size_t operations,
+   int useLockFree)
+{
+   thrd_t threads[MAX_THREADS];
+   struct workerArgs args[MAX_THREADS];
+
+   double start = secondsNow();
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      args[t].threadIndex = t;
+      args[t].operations = operations / threadCount;
+      args[t].useLockFree = useLockFree;
+      thrd_create(&threads[t], pairsWorker, &args[t]);
+   }
+
+   for (unsigned int t = 0; t < threadCount; ++t) {
+      thrd_join(threads[t], NULL);
+   }
+
+   double seconds = secondsNow() - start;
+   return 2.0 * (operations / threadCount * threadCount) / seconds / 1e6;
+}
+
+// popAll callback: add the value to the thread's sum
+static void addValue(int value, void *contextPtr)
+{
+   struct workerArgs *args = contextPtr;
+   args->sum += value;
+}
+
+// push a thread's share of values while removing values with pop and
+// popAll until every value pushed by every thread has been taken
+static int checkWorker(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int value;
+
+   for (size_t i = 0; i < args->operations; ++i) {
+      pushLockFree(&lockFreeStack,
+         (int) (i * CHECK_THREADS + args->threadIndex));
+
+      if (i % 2 == 0 && popLockFree(&lockFreeStack, &value)) {
+         args->sum += value;
+         atomic_fetch_add(args->takenPtr, 1);
+      }
+   }
+
+   // odd threads drain in batches, even threads one value at a time
+   while (atomic_load(args->takenPtr) < STACK_CAPACITY) {
+      if (args->threadIndex % 2 == 1) {
+         atomic_fetch_add(args->takenPtr,
+            popAllLockFree(&lockFreeStack, addValue, args));
+      }
+      else if (popLockFree(&lockFreeStack, &value)) {
+         args->sum += value;
+         atomic_fetch_add(args->takenPtr, 1);
+      }
+      else {
+         thrd_yield();
+      }
+   }
+
+   return 0;
+}
+
+// every value pushed must be removed exactly once
+static int checkStack(void)
+{
+   thrd_t threads[CHECK_THREADS];
+   struct workerArgs args[CHECK_THREADS];
+   atomic_size_t taken;
+
+   atomic_init(&taken, 0);
+   initLockFreeStack(&lockFreeStack, STACK_CAPACITY);
+
+   for (unsigned int t = 0; t < CHECK_THREADS; ++t) {
+      args[t].threadIndex = t;
+      args[t].operations = CHECK_ITEMS_PER_THREAD;
+      args[t].takenPtr = &taken;
+      args[t].sum = 0;
+      thrd_create(&threads[t], checkWorker, &args[t]);
+   }
+
+   long long sum = 0;
+
+   for (unsigned int t = 0; t < CHECK_THREADS; ++t) {
+      thrd_join(threads[t], NULL);
+      sum += args[t].sum;
+   }
+
+   // the values pushed are exactly 0 .. STACK_CAPACITY - 1
+   long long expected = (long long) STACK_CAPACITY * (STACK_CAPACITY - 1) / 2;
+   int passed = sum == expected && atomic_load(&taken) == STACK_CAPACITY &&
+      isEmptyStackLockFree(&lockFreeStack);
+
+   printf("Check, %d threads pushing, popping and popping all, %d values: "
+      "%s\n\n", CHECK_THREADS, STACK_CAPACITY, passed ? "passed" : "FAILED");
+
+   destroyLockFreeStack(&lockFreeStack);
+   return passed;
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned int maxThreads = (unsigned int) sysconf(_SC_NPROCESSORS_ONLN);
+   size_t operations = DEFAULT_OPERATIONS;
+
+   if (argc > 1) {
+      maxThreads = (unsigned int) strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      operations = strtoul(argv[2], NULL, 10);
+   }
+
+   if (maxThreads < 1 || maxThreads > MAX_THREADS) {
+      maxThreads = maxThreads < 1 ? 1 : MAX_THREADS;
+   }
+
+   mtx_init(&stackMutex, mtx_plain);
+
+   int passed = checkStack();
+
+   puts("Millions of stack operations per second (push/pop pairs)");
+   printf("%8s%14s%14s\n", "Threads", "mutex", "lock-free");
+
+   for (unsigned int t = 1; t <= maxThreads; ++t) {
+      double lockedRate = runPairs(t, operations, 0);
+
+      // the stack stays shallow: each thread pops right after it pushes
+      initLockFreeStack(&lockFreeStack, (size_t) t * MAX_THREADS);
+      double lockFreeRate = runPairs(t, operations, 1);
+      destroyLockFreeStack(&lockFreeStack);
+
+      printf("%8u%14.2f%14.2f\n", t, lockedRate, lockFreeRate);
+   }
+
+   mtx_destroy(&stackMutex);
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
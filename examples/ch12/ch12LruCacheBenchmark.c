@@ -0,0 +1,252 @@
+// ch12LruCacheBenchmark.c
+// Replays a Zipf-distributed key trace (a few keys are requested very
+// often, most keys rarely) against the LRU cache at several capacities,
+// filling the cache on every miss. The smallest capacity is also run with
+// a fig12_03-style list that moves each hit to the front; both caches
+// follow the same policy, so their hit counts must match.
+// NOTE: This file must be compiled with lruCache.c, for example
+//    gcc -O2 ch12LruCacheBenchmark.c lruCache.c -o ch12LruCacheBenchmark -lm
+// Usage: ch12LruCacheBenchmark [requests] [distinctKeys] [zipfExponent]
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lruCache.h"
+
+#define DEFAULT_REQUESTS 10000000
+#define DEFAULT_KEYS 1000000
+#define DEFAULT_EXPONENT 0.99
+#define SMALLEST_CAPACITY 1000
+#define CAPACITY_GROWTH 10
+#define CAPACITY_RUNS 3
+
+// fig12_03 list node holding one cached key and value
+struct listNode {
+   int key;
+   int value;
+   struct listNode *nextPtr;
+};
+
+typedef struct listNode ListNode;
+typedef ListNode *ListNodePtr;
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// fill trace with keys 0 .. keys - 1, key k having probability
+// proportional to 1 / (k + 1)^exponent; returns 0 if out of memory
+static int makeZipfTrace(int trace[], size_t requests, size_t keys,
+   double exponent)
+{
+   double *cumulative = malloc(keys * sizeof(double));
+
+   if (cumulative == NULL) {
+      return 0;
+   }
+
+   double total = 0.0;
+
+   for (size_t k = 0; k < keys; ++k) {
+      total += 1.0 / pow((double) (k + 1), exponent);
+      cumulative[k] = total;
+   }
+
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < requests; ++i) {
+      double target = (nextRandom(&state) >> 11) * 0x1.0p-53 * total;
+
+      // binary search for the first cumulative weight above target
+      size_t low = 0;
+      size_t high = keys - 1;
+
+      while (low < high) {
+         size_t middle = low + (high - low) / 2;
+
+         if (cumulative[middle] <= target) {
+            low = middle + 1;
+         }
+         else {
+            high = middle;
+         }
+      }
+
+      trace[i] = (int) low;
+   }
+
+   free(cumulative);
+   return 1;
+}
+
+// look key up in a move-to-front list holding at most capacity nodes and
+// insert it on a miss, dropping the last node; returns 1 on a hit
+static int accessList(ListNodePtr *sPtr, size_t *countPtr, size_t capacity,
+   int key)
+{
+   ListNodePtr previousPtr = NULL;
+   ListNodePtr currentPtr = *sPtr;
+
+   while (currentPtr != NULL && currentPtr->key != key) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextPtr;
+   }
+
+   if (currentPtr != NULL) { // hit: move to the front
+      if (previousPtr != NULL) {
+         previousPtr->nextPtr = currentPtr->nextPtr;
+         currentPtr->nextPtr = *sPtr;
+         *sPtr = currentPtr;
+      }
+
+      return 1;
+   }
+
+   if (*countPtr == capacity) { // reuse the last node, the oldest one
+      previousPtr = NULL;
+      currentPtr = *sPtr;
+
+      while (currentPtr->nextPtr != NULL) {
+         previousPtr = currentPtr;
+         currentPtr = currentPtr->nextPtr;
+      }
+
+      if (previousPtr == NULL) {
+         *sPtr = NULL;
+      }
+      else {
+         previousPtr->nextPtr = NULL;
+      }
+   }
+   else {
+      currentPtr = malloc(sizeof(ListNode));
+      ++*countPtr;
+   }
+
+   currentPtr->key = key;
+   currentPtr->value = key;
+   currentPtr->nextPtr = *sPtr;
+   *sPtr = currentPtr;
+   return 0;
+}
+
+// replay the trace through the list; returns the number of hits
+static size_t runList(const int trace[], size_t requests, size_t capacity)
+{
+   ListNodePtr startPtr = NULL;
+   size_t count = 0;
+   size_t hits = 0;
+   double start = secondsNow();
+
+   for (size_t i = 0; i < requests; ++i) {
+      hits += accessList(&startPtr, &count, capacity, trace[i]);
+   }
+
+   double seconds = secondsNow() - start;
+
+   printf("%-14s%10zu%12.2f%14.3f\n", "list", capacity,
+      100.0 * hits / requests, requests / seconds / 1e6);
+
+   while (startPtr != NULL) {
+      ListNodePtr tempPtr = startPtr;
+      startPtr = startPtr->nextPtr;
+      free(tempPtr);
+   }
+
+   return hits;
+}
+
+// replay the trace through the LRU cache; returns the number of hits
+static size_t runCache(const int trace[], size_t requests, size_t capacity)
+{
+   LruCache cache;
+
+   if (!initLruCache(&cache, capacity)) {
+      puts("Cannot allocate the cache.");
+      return 0;
+   }
+
+   int value;
+   double start = secondsNow();
+
+   for (size_t i = 0; i < requests; ++i) {
+      if (!getLru(&cache, trace[i], &value)) {
+         putLru(&cache, trace[i], trace[i]);
+      }
+   }
+
+   double seconds = secondsNow() - start;
+
+   printf("%-14s%10zu%12.2f%14.3f%12zu\n", "hash + list", capacity,
+      100.0 * cache.hits / requests, requests / seconds / 1e6,
+      cache.evictions);
+
+   size_t hits = cache.hits;
+   destroyLruCache(&cache);
+   return hits;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t requests = DEFAULT_REQUESTS;
+   size_t keys = DEFAULT_KEYS;
+   double exponent = DEFAULT_EXPONENT;
+
+   if (argc > 1) {
+      requests = strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      keys = strtoul(argv[2], NULL, 10);
+   }
+
+   if (argc > 3) {
+      exponent = strtod(argv[3], NULL);
+   }
+
+   int *trace = malloc(requests * sizeof(int));
+
+   if (keys < 1 || trace == NULL || !makeZipfTrace(trace, requests, keys,
+      exponent)) {
+      puts("Cannot build the trace.");
+      free(trace);
+      return EXIT_FAILURE;
+   }
+
+   printf("%zu requests over %zu keys, Zipf exponent %.2f\n", requests,
+      keys, exponent);
+   printf("%-14s%10s%12s%14s%12s\n", "Cache", "Capacity", "Hit rate %",
+      "Mrequests/s", "Evictions");
+
+   size_t listHits = runList(trace, requests, SMALLEST_CAPACITY);
+   size_t cacheHits = 0;
+   size_t capacity = SMALLEST_CAPACITY;
+
+   for (int run = 0; run < CAPACITY_RUNS; ++run) {
+      size_t hits = runCache(trace, requests, capacity);
+
+      if (run == 0) {
+         cacheHits = hits;
+      }
+
+      capacity *= CAPACITY_GROWTH;
+   }
+
+   printf("\nList and LRU cache hits agree at capacity %d: %s\n",
+      SMALLEST_CAPACITY, listHits == cacheHits ? "yes" : "NO");
+   free(trace);
+   return listHits == cacheHits ? EXIT_SUCCESS : EXIT_FAILURE;
+}
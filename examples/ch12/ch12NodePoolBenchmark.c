@@ -0,0 +1,263 @@
+// ch12NodePoolBenchmark.c
+// Compares one malloc per node with the node pool for the Chapter 12
+// stack, queue, list and tree nodes.
+// NOTE: This file must be compiled with nodePool.c, for example
+//    gcc -O2 ch12NodePoolBenchmark.c nodePool.c -o ch12NodePoolBenchmark
+// Usage: ch12NodePoolBenchmark [numberOfNodes]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "nodePool.h"
+
+#define DEFAULT_NODES 10000000 // tens of millions under real load
+#define TREE_NODES_DIVISOR 10 // random tree inserts are far slower per node
+
+// node layouts from fig12_03, fig12_08, fig12_13 and fig12_19
+struct listNode {
+   char data;
+   struct listNode *nextPtr;
+};
+
+struct stackNode {
+   int data;
+   struct stackNode *nextPtr;
+};
+
+struct queueNode {
+   char data;
+   struct queueNode *nextPtr;
+};
+
+struct treeNode {
+   struct treeNode *leftPtr;
+   int data;
+   struct treeNode *rightPtr;
+};
+
+typedef struct listNode ListNode;
+typedef struct stackNode StackNode;
+typedef struct queueNode QueueNode;
+typedef struct treeNode TreeNode;
+
+// the allocator under test: NULL selects malloc/free
+static NodePool *activePoolPtr = NULL;
+
+// allocate size bytes from the active pool or from malloc
+static void *allocate(size_t size)
+{
+   return activePoolPtr != NULL ? allocNode(activePoolPtr) : malloc(size);
+}
+
+// release one node to the active pool or to free
+static void deallocate(void *nodePtr)
+{
+   if (activePoolPtr != NULL) {
+      freeNode(activePoolPtr, nodePtr);
+   }
+   else {
+      free(nodePtr);
+   }
+}
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// push count values, then pop them all, like fig12_08
+static long long stackWorkload(size_t count)
+{
+   StackNode *topPtr = NULL;
+   long long sum = 0;
+
+   for (size_t i = 0; i < count; ++i) {
+      StackNode *newPtr = allocate(sizeof(StackNode));
+      newPtr->data = (int) i;
+      newPtr->nextPtr = topPtr;
+      topPtr = newPtr;
+   }
+
+   while (topPtr != NULL) {
+      StackNode *tempPtr = topPtr;
+      sum += topPtr->data;
+      topPtr = topPtr->nextPtr;
+      deallocate(tempPtr);
+   }
+
+   return sum;
+}
+
+// keep a queue of window nodes moving: each enqueue is matched by a dequeue,
+// like a steady-state fig12_13 queue
+static long long queueWorkload(size_t count)
+{
+   QueueNode *headPtr = NULL;
+   QueueNode *tailPtr = NULL;
+   const size_t window = 1024;
+   long long sum = 0;
+
+   for (size_t i = 0; i < count; ++i) {
+      QueueNode *newPtr = allocate(sizeof(QueueNode));
+      newPtr->data = (char) i;
+      newPtr->nextPtr = NULL;
+
+      if (headPtr == NULL) {
+         headPtr = newPtr;
+      }
+      else {
+         tailPtr->nextPtr = newPtr;
+      }
+
+      tailPtr = newPtr;
+
+      if (i >= window) {
+         QueueNode *tempPtr = headPtr;
+         sum += headPtr->data;
+         headPtr = headPtr->nextPtr;
+         deallocate(tempPtr);
+      }
+   }
+
+   while (headPtr != NULL) {
+      QueueNode *tempPtr = headPtr;
+      sum += headPtr->data;
+      headPtr = headPtr->nextPtr;
+      deallocate(tempPtr);
+   }
+
+   return sum;
+}
+
+// build a list of count nodes, walk it, then free the remaining nodes like
+// freeRemainingNodes in ch12SingleLLAddDelete (one by one, or the whole
+// pool at once)
+static long long listWorkload(size_t count)
+{
+   ListNode *startPtr = NULL;
+   long long sum = 0;
+
+   for (size_t i = 0; i < count; ++i) {
+      ListNode *newPtr = allocate(sizeof(ListNode));
+      newPtr->data = (char) i;
+      newPtr->nextPtr = startPtr;
+      startPtr = newPtr;
+   }
+
+   for (ListNode *currentPtr = startPtr; currentPtr != NULL;
+      currentPtr = currentPtr->nextPtr) {
+      sum += currentPtr->data;
+   }
+
+   if (activePoolPtr != NULL) {
+      releaseNodePool(activePoolPtr);
+   }
+   else {
+      while (startPtr != NULL) {
+         ListNode *nextPtr = startPtr->nextPtr;
+         free(startPtr);
+         startPtr = nextPtr;
+      }
+   }
+
+   return sum;
+}
+
+// insert a random key into the tree iteratively (same shape as fig12_19)
+static void treeInsert(TreeNode **treePtr, int value)
+{
+   while (*treePtr != NULL) {
+      if (value < (*treePtr)->data) {
+         treePtr = &(*treePtr)->leftPtr;
+      }
+      else if (value > (*treePtr)->data) {
+         treePtr = &(*treePtr)->rightPtr;
+      }
+      else {
+         return; // duplicate data value ignored
+      }
+   }
+
+   *treePtr = allocate(sizeof(TreeNode));
+   (*treePtr)->data = value;
+   (*treePtr)->leftPtr = NULL;
+   (*treePtr)->rightPtr = NULL;
+}
+
+// free a tree node by node
+static void treeFree(TreeNode *treePtr)
+{
+   if (treePtr != NULL) {
+      treeFree(treePtr->leftPtr);
+      treeFree(treePtr->rightPtr);
+      free(treePtr);
+   }
+}
+
+// insert count random keys into a tree, then free it
+static long long treeWorkload(size_t count)
+{
+   TreeNode *rootPtr = NULL;
+
+   srand(2060);
+
+   for (size_t i = 0; i < count; ++i) {
+      treeInsert(&rootPtr, rand());
+   }
+
+   long long rootValue = rootPtr != NULL ? rootPtr->data : 0;
+
+   if (activePoolPtr != NULL) {
+      releaseNodePool(activePoolPtr);
+   }
+   else {
+      treeFree(rootPtr);
+   }
+
+   return rootValue;
+}
+
+// time one workload with malloc and with a pool of nodeSize nodes
+static void compare(const char *name, long long (*workload)(size_t),
+   size_t nodeSize, size_t count)
+{
+   NodePool pool;
+   initNodePool(&pool, nodeSize, 0);
+
+   activePoolPtr = NULL;
+   double start = secondsNow();
+   long long mallocResult = workload(count);
+   double mallocSeconds = secondsNow() - start;
+
+   activePoolPtr = &pool;
+   start = secondsNow();
+   long long poolResult = workload(count);
+   double poolSeconds = secondsNow() - start;
+   releaseNodePool(&pool);
+
+   printf("%-6s%12zu%14.1f%14.1f%10.2fx%s\n", name, count,
+      count / mallocSeconds / 1e6, count / poolSeconds / 1e6,
+      mallocSeconds / poolSeconds,
+      mallocResult == poolResult ? "" : "  RESULTS DIFFER");
+}
+
+int main(int argc, char *argv[])
+{
+   size_t count = DEFAULT_NODES;
+
+   if (argc > 1) {
+      count = strtoul(argv[1], NULL, 10);
+   }
+
+   puts("Millions of nodes per second, malloc path vs. node pool path");
+   printf("%-6s%12s%14s%14s%11s\n", "Shape", "Nodes", "malloc", "pool",
+      "Speedup");
+
+   compare("stack", stackWorkload, sizeof(StackNode), count);
+   compare("queue", queueWorkload, sizeof(QueueNode), count);
+   compare("list", listWorkload, sizeof(ListNode), count);
+   compare("tree", treeWorkload, sizeof(TreeNode),
+      count / TREE_NODES_DIVISOR);
+}
@@ -0,0 +1,191 @@
+// ch12OrderStatisticsBenchmark.c
+// Checks selectKth, rankOf and rangeCount against a brute-force oracle
+// while keys are inserted and deleted, then compares their speed with
+// answering the same questions by a full in-order walk.
+// NOTE: This file must be compiled with binaryTree.c, for example
+//    gcc -O2 ch12OrderStatisticsBenchmark.c binaryTree.c -o ch12OrderStatisticsBenchmark
+// Usage: ch12OrderStatisticsBenchmark [numberOfKeys]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "binaryTree.h"
+
+#define DEFAULT_KEYS 1000000
+#define CHECK_KEY_RANGE 5000 // keys drawn from 0 .. CHECK_KEY_RANGE - 1
+#define CHECK_ROUNDS 20000
+#define QUERIES 1000000
+#define WALK_QUERIES 20 // full walks are slow; time a few and scale
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// answer a query by brute force over the oracle's membership array
+static int checkQueries(TreeNodePtr rootPtr, const char present[],
+   unsigned long long *statePtr)
+{
+   int low = (int) (nextRandom(statePtr) % CHECK_KEY_RANGE);
+   int high = (int) (nextRandom(statePtr) % CHECK_KEY_RANGE);
+   size_t count = 0;
+   size_t below = 0;
+   size_t inRange = 0;
+
+   for (int key = 0; key < CHECK_KEY_RANGE; ++key) {
+      count += present[key];
+      below += present[key] && key < low;
+      inRange += present[key] && key >= low && key <= high;
+   }
+
+   int passed = treeSize(rootPtr) == count &&
+      rankOf(rootPtr, low) == below &&
+      rangeCount(rootPtr, low, high) == inRange;
+
+   // the k-th smallest is the k-th present key counting upward
+   if (count > 0) {
+      size_t k = 1 + nextRandom(statePtr) % count;
+      size_t seen = 0;
+      int key = -1;
+
+      while (seen < k) {
+         seen += present[++key];
+      }
+
+      TreeNodePtr kthPtr = selectKth(rootPtr, k);
+      passed &= kthPtr != NULL && kthPtr->data == key;
+   }
+
+   passed &= selectKth(rootPtr, count + 1) == NULL;
+   return passed;
+}
+
+// random inserts and deletes, checking every query after each change
+static int checkAgainstOracle(void)
+{
+   char present[CHECK_KEY_RANGE] = { 0 };
+   TreeNodePtr rootPtr = NULL;
+   unsigned long long state = 2060;
+   int passed = 1;
+
+   for (int round = 0; round < CHECK_ROUNDS && passed; ++round) {
+      int key = (int) (nextRandom(&state) % CHECK_KEY_RANGE);
+
+      // grow the tree for the first half, then shrink it
+      if (nextRandom(&state) % 4 < (round < CHECK_ROUNDS / 2 ? 3u : 1u)) {
+         passed &= insertNodeBalanced(&rootPtr, key) == !present[key];
+         present[key] = 1;
+      }
+      else {
+         passed &= deleteNodeBalanced(&rootPtr, key) == present[key];
+         present[key] = 0;
+      }
+
+      passed &= checkQueries(rootPtr, present, &state);
+   }
+
+   freeTree(&rootPtr);
+   return passed;
+}
+
+// in-order walk state for brute-force queries
+struct walkQuery {
+   int low; // rank and range queries
+   int high; // range queries
+   size_t k; // select queries
+   size_t seen;
+   long long answer;
+};
+
+// TreeVisitor: count values in [low, high]
+static void countInRange(int value, void *contextPtr)
+{
+   struct walkQuery *queryPtr = contextPtr;
+   queryPtr->answer += value >= queryPtr->low && value <= queryPtr->high;
+}
+
+// TreeVisitor: remember the k-th value visited
+static void findKth(int value, void *contextPtr)
+{
+   struct walkQuery *queryPtr = contextPtr;
+
+   if (++queryPtr->seen == queryPtr->k) {
+      queryPtr->answer = value;
+   }
+}
+
+int main(int argc, char *argv[])
+{
+   size_t count = DEFAULT_KEYS;
+
+   if (argc > 1) {
+      count = strtoul(argv[1], NULL, 10);
+   }
+
+   printf("Oracle check, %d random inserts/deletes: %s\n\n", CHECK_ROUNDS,
+      checkAgainstOracle() ? "passed" : "FAILED");
+
+   TreeNodePtr rootPtr = NULL;
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < count; ++i) {
+      insertNodeBalanced(&rootPtr, (int) (nextRandom(&state) >> 34));
+   }
+
+   count = treeSize(rootPtr);
+   printf("Queries per second on %zu keys\n", count);
+   printf("%-12s%14s%16s\n", "Query", "augmented", "in-order walk");
+
+   long long sink = 0;
+   double start = secondsNow();
+
+   for (size_t i = 0; i < QUERIES; ++i) {
+      sink += selectKth(rootPtr, 1 + nextRandom(&state) % count)->data;
+   }
+
+   double fastRate = QUERIES / (secondsNow() - start);
+   start = secondsNow();
+
+   for (size_t i = 0; i < WALK_QUERIES; ++i) {
+      struct walkQuery query = { 0, 0, 1 + nextRandom(&state) % count, 0, 0 };
+      inOrderVisit(rootPtr, findKth, &query);
+      sink += query.answer;
+   }
+
+   double walkRate = WALK_QUERIES / (secondsNow() - start);
+   printf("%-12s%14.0f%16.1f\n", "select", fastRate, walkRate);
+
+   start = secondsNow();
+
+   for (size_t i = 0; i < QUERIES; ++i) {
+      int low = (int) (nextRandom(&state) >> 34);
+      sink += rangeCount(rootPtr, low, low + (1 << 24));
+   }
+
+   fastRate = QUERIES / (secondsNow() - start);
+   start = secondsNow();
+
+   for (size_t i = 0; i < WALK_QUERIES; ++i) {
+      int low = (int) (nextRandom(&state) >> 34);
+      struct walkQuery query = { low, low + (1 << 24), 0, 0, 0 };
+      inOrderVisit(rootPtr, countInRange, &query);
+      sink += query.answer;
+   }
+
+   walkRate = WALK_QUERIES / (secondsNow() - start);
+   printf("%-12s%14.0f%16.1f\n", "rangeCount", fastRate, walkRate);
+
+   printf("\n(checksum %lld)\n", sink);
+   freeTree(&rootPtr);
+}
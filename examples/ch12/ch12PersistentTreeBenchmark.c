@@ -0,0 +1,251 @@
+// ch12PersistentTreeBenchmark.c
+// Reader threads search snapshots of a tree while one writer thread keeps
+// inserting, once with the persistent tree and once with the balanced
+// Fig. 12.19 tree guarded by one mutex. Readers also walk some snapshots
+// in order to check that a snapshot never changes under them.
+// NOTE: This file must be compiled with persistentTree.c and binaryTree.c,
+// for example
+//    gcc -O2 ch12PersistentTreeBenchmark.c persistentTree.c binaryTree.c -o ch12PersistentTreeBenchmark
+// Usage: ch12PersistentTreeBenchmark [readers] [inserts]
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <time.h>
+#include "binaryTree.h"
+#include "persistentTree.h"
+
+#define DEFAULT_READERS 3
+#define DEFAULT_INSERTS 500000
+#define INITIAL_VALUES 100000
+#define SEARCHES_PER_SNAPSHOT 64
+#define WALK_EVERY 4096 // snapshots between in-order walks
+
+static PersistentTree persistentTree;
+
+static TreeNodePtr lockedRootPtr = NULL;
+static mtx_t treeMutex;
+
+static atomic_int writerDone;
+
+// arguments for one reader thread
+struct readerArgs {
+   unsigned int readerIndex;
+   int usePersistent;
+   size_t searches; // searches finished
+   size_t snapshots; // snapshots opened (or lock periods)
+   size_t found; // searches that found their value
+   int consistent; // every walked snapshot was sorted and stayed the same
+};
+
+// arguments for the writer thread
+struct writerArgs {
+   size_t inserts;
+   int usePersistent;
+};
+
+// running state of an in-order walk over one snapshot
+struct walkState {
+   long long previous;
+   size_t count;
+   int sorted;
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// random key; 30 bits keep duplicates rare
+static int randomKey(unsigned long long *statePtr)
+{
+   return (int) (nextRandom(statePtr) >> 34);
+}
+
+// inOrderVersion callback: count values and check ascending order
+static void checkValue(int value, void *contextPtr)
+{
+   struct walkState *walkPtr = contextPtr;
+
+   if (value <= walkPtr->previous) {
+      walkPtr->sorted = 0;
+   }
+
+   walkPtr->previous = value;
+   ++walkPtr->count;
+}
+
+// walk a snapshot twice, with searches in between; both walks must agree
+static int checkSnapshot(PersistentNodePtr rootPtr)
+{
+   struct walkState first = {-1, 0, 1};
+   struct walkState second = {-1, 0, 1};
+
+   inOrderVersion(rootPtr, checkValue, &first);
+   thrd_yield(); // give the writer time to publish newer versions
+   inOrderVersion(rootPtr, checkValue, &second);
+
+   return first.sorted && second.sorted && first.count == second.count;
+}
+
+// search random keys in batches until the writer has finished
+static int reader(void *argPtr)
+{
+   struct readerArgs *args = argPtr;
+   unsigned long long state = 12345 + args->readerIndex;
+
+   while (!atomic_load(&writerDone)) {
+      if (args->usePersistent) {
+         PersistentNodePtr rootPtr =
+            openSnapshot(&persistentTree, args->readerIndex);
+
+         for (size_t i = 0; i < SEARCHES_PER_SNAPSHOT; ++i) {
+            args->found += searchVersion(rootPtr, randomKey(&state));
+         }
+
+         if (args->snapshots % WALK_EVERY == 0 && !checkSnapshot(rootPtr)) {
+            args->consistent = 0;
+         }
+
+         releaseVersion(rootPtr);
+      }
+      else {
+         mtx_lock(&treeMutex);
+
+         for (size_t i = 0; i < SEARCHES_PER_SNAPSHOT; ++i) {
+            args->found +=
+               searchTree(lockedRootPtr, randomKey(&state)) != NULL;
+         }
+
+         mtx_unlock(&treeMutex);
+      }
+
+      args->searches += SEARCHES_PER_SNAPSHOT;
+      ++args->snapshots;
+   }
+
+   return 0;
+}
+
+// insert random keys, then tell the readers to stop
+static int writer(void *argPtr)
+{
+   struct writerArgs *args = argPtr;
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < args->inserts; ++i) {
+      if (args->usePersistent) {
+         insertPersistent(&persistentTree, randomKey(&state));
+      }
+      else {
+         mtx_lock(&treeMutex);
+         insertNodeBalanced(&lockedRootPtr, randomKey(&state));
+         mtx_unlock(&treeMutex);
+      }
+   }
+
+   atomic_store(&writerDone, 1);
+   return 0;
+}
+
+// run one writer against readerCount readers and print the rates
+static int runMixed(unsigned int readerCount, size_t inserts,
+   int usePersistent)
+{
+   thrd_t writerThread;
+   thrd_t readerThreads[MAX_SNAPSHOT_READERS];
+   struct writerArgs writerArgs = {inserts, usePersistent};
+   struct readerArgs args[MAX_SNAPSHOT_READERS];
+   unsigned long long state = 99;
+
+   // both trees start from the same values
+   for (size_t i = 0; i < INITIAL_VALUES; ++i) {
+      if (usePersistent) {
+         insertPersistent(&persistentTree, randomKey(&state));
+      }
+      else {
+         insertNodeBalanced(&lockedRootPtr, randomKey(&state));
+      }
+   }
+
+   atomic_store(&writerDone, 0);
+   double start = secondsNow();
+
+   for (unsigned int r = 0; r < readerCount; ++r) {
+      args[r] = (struct readerArgs) {r, usePersistent, 0, 0, 0, 1};
+      thrd_create(&readerThreads[r], reader, &args[r]);
+   }
+
+   thrd_create(&writerThread, writer, &writerArgs);
+   thrd_join(writerThread, NULL);
+   double writerSeconds = secondsNow() - start;
+
+   size_t searches = 0;
+   size_t snapshots = 0;
+   int consistent = 1;
+
+   for (unsigned int r = 0; r < readerCount; ++r) {
+      thrd_join(readerThreads[r], NULL);
+      searches += args[r].searches;
+      snapshots += args[r].snapshots;
+      consistent &= args[r].consistent;
+   }
+
+   double seconds = secondsNow() - start;
+
+   printf("%-26s%14.3f%14.3f%14.3f\n",
+      usePersistent ? "persistent snapshots" : "balanced tree with mutex",
+      inserts / writerSeconds / 1e6, snapshots / seconds / 1e6,
+      searches / seconds / 1e6);
+
+   return consistent;
+}
+
+int main(int argc, char *argv[])
+{
+   unsigned int readerCount = DEFAULT_READERS;
+   size_t inserts = DEFAULT_INSERTS;
+
+   if (argc > 1) {
+      readerCount = (unsigned int) strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      inserts = strtoul(argv[2], NULL, 10);
+   }
+
+   if (readerCount < 1 || readerCount > MAX_SNAPSHOT_READERS) {
+      readerCount = readerCount < 1 ? 1 : MAX_SNAPSHOT_READERS;
+   }
+
+   mtx_init(&treeMutex, mtx_plain);
+   initPersistentTree(&persistentTree);
+
+   printf("One writer, %u readers, %d values plus %zu inserts\n",
+      readerCount, INITIAL_VALUES, inserts);
+   puts("Millions per second");
+   printf("%-26s%14s%14s%14s\n", "Tree", "inserts", "snapshots",
+      "searches");
+
+   runMixed(readerCount, inserts, 0);
+   int consistent = runMixed(readerCount, inserts, 1);
+
+   printf("\nEvery walked snapshot was sorted and unchanged: %s\n",
+      consistent ? "yes" : "NO");
+
+   freeTree(&lockedRootPtr);
+   destroyPersistentTree(&persistentTree);
+   mtx_destroy(&treeMutex);
+   return consistent ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+// ch12PriorityQueueBenchmark.c
+// Compares binary, 4-ary and 8-ary heaps as the priority queue of the
+// Fig. 12.13 enqueue/dequeue shape. The hold run dequeues the most urgent
+// value and enqueues a later one, as an event simulation does; the
+// decreaseKey run lowers random priorities, as Dijkstra's algorithm does.
+// Every queue is drained at the end to check the dequeue order, and a
+// handle kept from before its value was dequeued must be refused.
+// NOTE: This file must be compiled with priorityQueue.c, for example
+//    gcc -O2 ch12PriorityQueueBenchmark.c priorityQueue.c -o ch12PriorityQueueBenchmark
+// Usage: ch12PriorityQueueBenchmark [operations] [queuedValues]
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "priorityQueue.h"
+
+#define DEFAULT_OPERATIONS 10000000
+#define DEFAULT_QUEUED 1000000
+#define PRIORITY_RANGE 1000000 // later events are up to this much later
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// time both workloads on one heap arity; returns 1 if the drain was in
+// priority order and held every value and a stale handle was refused
+static int runArity(unsigned int arity, size_t operations, size_t queued)
+{
+   PriorityQueue queue;
+   unsigned long long state = 2060;
+   size_t *handles = malloc(queued * sizeof(size_t));
+
+   if (handles == NULL || !initPriorityQueue(&queue, arity, queued)) {
+      puts("Cannot allocate the queue.");
+      free(handles);
+      return 0;
+   }
+
+   double start = secondsNow();
+
+   for (size_t i = 0; i < queued; ++i) {
+      enqueuePriority(&queue, (int) i,
+         (int) (nextRandom(&state) % PRIORITY_RANGE), &handles[i]);
+   }
+
+   double fillRate = queued / (secondsNow() - start) / 1e6;
+
+   // hold: each pair of operations moves one event later in time; the
+   // new entry reuses the freed slot under a new handle
+   int value;
+   int priority;
+   size_t staleHandle = handles[0];
+   start = secondsNow();
+
+   for (size_t i = 0; i < operations / 2; ++i) {
+      dequeuePriority(&queue, &value, &priority);
+      enqueuePriority(&queue, value,
+         priority + (int) (nextRandom(&state) % PRIORITY_RANGE),
+         &handles[value]);
+   }
+
+   double holdRate = operations / 2 * 2 / (secondsNow() - start) / 1e6;
+
+   // decreaseKey: make random queued values more urgent; handles[value]
+   // is the handle of the latest enqueue of each value
+   start = secondsNow();
+
+   for (size_t i = 0; i < operations; ++i) {
+      size_t handle = handles[nextRandom(&state) % queued];
+      queuedPriority(&queue, handle, &priority);
+      decreaseKey(&queue, handle,
+         priority - (int) (nextRandom(&state) % PRIORITY_RANGE));
+   }
+
+   double decreaseRate = operations / (secondsNow() - start) / 1e6;
+
+   // value 0 was enqueued again if the hold run dequeued it, so its
+   // first handle must no longer name a queued value
+   int refused = staleHandle == handles[0] ||
+      !decreaseKey(&queue, staleHandle, INT_MIN);
+
+   // drain: priorities must never go down
+   size_t drained = 0;
+   int previous = INT_MIN;
+   int ordered = 1;
+   start = secondsNow();
+
+   while (dequeuePriority(&queue, &value, &priority)) {
+      if (priority < previous) {
+         ordered = 0;
+      }
+
+      previous = priority;
+      ++drained;
+   }
+
+   double drainRate = drained / (secondsNow() - start) / 1e6;
+
+   printf("%8u%12.2f%12.2f%14.2f%12.2f%s%s\n", arity, fillRate, holdRate,
+      decreaseRate, drainRate,
+      ordered && drained == queued ? "" : "  WRONG ORDER",
+      refused ? "" : "  STALE HANDLE ACCEPTED");
+
+   destroyPriorityQueue(&queue);
+   free(handles);
+   return ordered && drained == queued && refused;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t operations = DEFAULT_OPERATIONS;
+   size_t queued = DEFAULT_QUEUED;
+
+   if (argc > 1) {
+      operations = strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      queued = strtoul(argv[2], NULL, 10);
+   }
+
+   if (queued < 1) {
+      queued = 1;
+   }
+
+   printf("%zu queued values, %zu operations per run\n", queued,
+      operations);
+   puts("Millions of operations per second");
+   printf("%8s%12s%12s%14s%12s\n", "Arity", "enqueue", "hold",
+      "decreaseKey", "drain");
+
+   int passed = runArity(2, operations, queued);
+   passed &= runArity(4, operations, queued);
+   passed &= runArity(8, operations, queued);
+
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
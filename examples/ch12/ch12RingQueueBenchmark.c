@@ -0,0 +1,299 @@
+// ch12RingQueueBenchmark.c
+// Two-thread benchmark of the single-producer/single-consumer ring queue,
+// one value at a time and in batches, against the fig12_13 queue guarded
+// by one mutex. The consumer checks that every value arrives in order.
+// A ping-pong between two ring queues measures round-trip latency.
+// NOTE: This file must be compiled with ringQueue.c, for example
+//    gcc -O2 ch12RingQueueBenchmark.c ringQueue.c -o ch12RingQueueBenchmark
+// Usage: ch12RingQueueBenchmark [valuesPerRun] [roundTrips]
+#include <stdio.h>
+#include <stdlib.h>
+#include <threads.h>
+#include <time.h>
+#include "ringQueue.h"
+
+#define DEFAULT_VALUES 20000000
+#define DEFAULT_ROUND_TRIPS 200000
+#define RING_CAPACITY 4096
+#define BATCH_SIZE 64
+
+// ways of passing values from the producer to the consumer
+enum transfer { LOCKED, RING, RING_BATCHED };
+
+// fig12_13 queue node, shared through a single mutex for the baseline
+struct queueNode {
+   int data;
+   struct queueNode *nextPtr;
+};
+
+typedef struct queueNode QueueNode;
+typedef QueueNode *QueueNodePtr;
+
+static QueueNodePtr headPtr = NULL;
+static QueueNodePtr tailPtr = NULL;
+static mtx_t queueMutex;
+
+static RingQueue requests; // producer to consumer, and ping to pong
+static RingQueue replies; // pong to ping
+
+// arguments for the producer and consumer threads
+struct workerArgs {
+   enum transfer how;
+   size_t values; // values to pass
+   int inOrder; // consumer: every value arrived in sequence
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// fig12_13 enqueue under the mutex
+static void enqueueLocked(int value)
+{
+   QueueNodePtr newPtr = malloc(sizeof(QueueNode));
+   newPtr->data = value;
+   newPtr->nextPtr = NULL;
+
+   mtx_lock(&queueMutex);
+
+   if (headPtr == NULL) {
+      headPtr = newPtr;
+   }
+   else {
+      tailPtr->nextPtr = newPtr;
+   }
+
+   tailPtr = newPtr;
+   mtx_unlock(&queueMutex);
+}
+
+// fig12_13 dequeue under the mutex; returns 0 if the queue is empty
+static int dequeueLocked(int *valuePtr)
+{
+   mtx_lock(&queueMutex);
+   QueueNodePtr tempPtr = headPtr;
+
+   if (tempPtr != NULL) {
+      headPtr = headPtr->nextPtr;
+
+      if (headPtr == NULL) {
+         tailPtr = NULL;
+      }
+   }
+
+   mtx_unlock(&queueMutex);
+
+   if (tempPtr == NULL) {
+      return 0;
+   }
+
+   *valuePtr = tempPtr->data;
+   free(tempPtr);
+   return 1;
+}
+
+// enqueue 0 .. values - 1, waiting whenever the ring is full
+static int producer(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int batch[BATCH_SIZE];
+   size_t sent = 0;
+
+   while (sent < args->values) {
+      if (args->how == LOCKED) {
+         enqueueLocked((int) sent);
+         ++sent;
+      }
+      else if (args->how == RING) {
+         if (enqueueRing(&requests, (int) sent)) {
+            ++sent;
+         }
+         else {
+            thrd_yield();
+         }
+      }
+      else {
+         size_t count = args->values - sent;
+
+         if (count > BATCH_SIZE) {
+            count = BATCH_SIZE;
+         }
+
+         for (size_t i = 0; i < count; ++i) {
+            batch[i] = (int) (sent + i);
+         }
+
+         // a full ring may accept only part of the batch
+         size_t done = 0;
+
+         while (done < count) {
+            size_t added =
+               enqueueNRing(&requests, &batch[done], count - done);
+
+            if (added == 0) {
+               thrd_yield();
+            }
+
+            done += added;
+         }
+
+         sent += count;
+      }
+   }
+
+   return 0;
+}
+
+// dequeue until every value has arrived, checking the sequence
+static int consumer(void *argPtr)
+{
+   struct workerArgs *args = argPtr;
+   int batch[BATCH_SIZE];
+   size_t received = 0;
+
+   args->inOrder = 1;
+
+   while (received < args->values) {
+      size_t count = 0;
+
+      if (args->how == LOCKED) {
+         count = dequeueLocked(&batch[0]);
+      }
+      else if (args->how == RING) {
+         count = dequeueRing(&requests, &batch[0]);
+      }
+      else {
+         count = dequeueNRing(&requests, batch, BATCH_SIZE);
+      }
+
+      if (count == 0) {
+         thrd_yield();
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+         if (batch[i] != (int) (received + i)) {
+            args->inOrder = 0;
+         }
+      }
+
+      received += count;
+   }
+
+   return 0;
+}
+
+// pass values from one thread to another and return millions of values
+// per second; *inOrderPtr is set to 0 if any value arrived out of order
+static double runTransfer(enum transfer how, size_t values, int *inOrderPtr)
+{
+   thrd_t producerThread;
+   thrd_t consumerThread;
+   struct workerArgs producerArgs = {how, values, 1};
+   struct workerArgs consumerArgs = {how, values, 1};
+
+   double start = secondsNow();
+
+   thrd_create(&consumerThread, consumer, &consumerArgs);
+   thrd_create(&producerThread, producer, &producerArgs);
+   thrd_join(producerThread, NULL);
+   thrd_join(consumerThread, NULL);
+
+   double seconds = secondsNow() - start;
+
+   if (!consumerArgs.inOrder) {
+      *inOrderPtr = 0;
+   }
+
+   return values / seconds / 1e6;
+}
+
+// send each request straight back as a reply
+static int pong(void *argPtr)
+{
+   size_t roundTrips = *(size_t *) argPtr;
+   int value;
+
+   for (size_t i = 0; i < roundTrips; ++i) {
+      while (!dequeueRing(&requests, &value)) {
+         thrd_yield();
+      }
+
+      while (!enqueueRing(&replies, value)) {
+         thrd_yield();
+      }
+   }
+
+   return 0;
+}
+
+// average microseconds from sending a value until its reply arrives
+static double runPingPong(size_t roundTrips, int *inOrderPtr)
+{
+   thrd_t pongThread;
+   int value;
+
+   thrd_create(&pongThread, pong, &roundTrips);
+   double start = secondsNow();
+
+   for (size_t i = 0; i < roundTrips; ++i) {
+      enqueueRing(&requests, (int) i);
+
+      while (!dequeueRing(&replies, &value)) {
+         thrd_yield();
+      }
+
+      if (value != (int) i) {
+         *inOrderPtr = 0;
+      }
+   }
+
+   double seconds = secondsNow() - start;
+   thrd_join(pongThread, NULL);
+   return seconds / roundTrips * 1e6;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t values = DEFAULT_VALUES;
+   size_t roundTrips = DEFAULT_ROUND_TRIPS;
+
+   if (argc > 1) {
+      values = strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      roundTrips = strtoul(argv[2], NULL, 10);
+   }
+
+   if (!initRingQueue(&requests, RING_CAPACITY) ||
+      !initRingQueue(&replies, RING_CAPACITY)) {
+      puts("Cannot allocate the ring queues.");
+      return EXIT_FAILURE;
+   }
+
+   mtx_init(&queueMutex, mtx_plain);
+
+   int inOrder = 1;
+
+   printf("One producer, one consumer, %zu values\n", values);
+   printf("%-28s%14s\n", "Queue", "Mvalues/s");
+   printf("%-28s%14.2f\n", "fig12_13 queue with mutex",
+      runTransfer(LOCKED, values, &inOrder));
+   printf("%-28s%14.2f\n", "ring, one at a time",
+      runTransfer(RING, values, &inOrder));
+   printf("%-28s%14.2f\n", "ring, batches of 64",
+      runTransfer(RING_BATCHED, values, &inOrder));
+
+   printf("\nRing round trip: %.3f microseconds\n",
+      runPingPong(roundTrips, &inOrder));
+   printf("Every value arrived in order: %s\n", inOrder ? "yes" : "NO");
+
+   mtx_destroy(&queueMutex);
+   destroyRingQueue(&requests);
+   destroyRingQueue(&replies);
+   return inOrder ? EXIT_SUCCESS : EXIT_FAILURE;
+}
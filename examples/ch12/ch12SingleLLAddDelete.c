@@ -25,6 +25,18 @@ typedef struct node
 	struct node* nextNodePtr;
 }Node;
 
+// Compile with -DUSE_NODE_POOL (and nodePool.c) to take nodes from a node pool
+// so freeRemainingNodes can release all of them at once
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool nodePool = NODE_POOL_INITIALIZER(Node);
+#define NEW_NODE() POOL_NEW(&nodePool, Node)
+#define FREE_NODE(nodePtr) freeNode(&nodePool, (nodePtr))
+#else
+#define NEW_NODE() malloc(sizeof(Node))
+#define FREE_NODE(nodePtr) free(nodePtr)
+#endif
+
 void exploreDoublePointers();
 void printList(Node* listPtr);
 void insertNode(Node** headPtr, int number);
@@ -101,7 +113,7 @@ int main(void)
 void insertNode(Node** headPtr, int number)
 {
 	// 
-	Node* newNodePtr = malloc(sizeof(Node));
+	Node* newNodePtr = NEW_NODE();
 
 	// 
 	if (newNodePtr != NULL)
@@ -164,7 +176,7 @@ void deleteNode(Node** headPtr, int numberToDelete)
 			//
 			*headPtr = (*headPtr)->nextNodePtr;
 			// 
-			free(currentPtr);
+			FREE_NODE(currentPtr);
 			currentPtr = NULL;
 		}
 		else //
@@ -183,7 +195,7 @@ void deleteNode(Node** headPtr, int numberToDelete)
 				// 
 				previousPtr->nextNodePtr = currentPtr->nextNodePtr;
 				//
-				free(currentPtr);
+				FREE_NODE(currentPtr);
 				currentPtr = NULL;
 			}
 			//
@@ -230,6 +242,10 @@ void printList(Node* listPtr)
 // 
 void freeRemainingNodes(Node** headPtr)
 {
+#ifdef USE_NODE_POOL
+	// every node belongs to the pool, so release the slabs without walking the list
+	releaseNodePool(&nodePool);
+#else
 	Node* currentPtr = *headPtr;
 	Node* nextNodePtr = NULL;
 
@@ -239,6 +255,7 @@ void freeRemainingNodes(Node** headPtr)
 		free(currentPtr);
 		currentPtr = nextNodePtr;
 	}
+#endif
 
 	*headPtr = NULL;
 }
@@ -0,0 +1,213 @@
+// ch12SkipListBenchmark.c
+// Builds sorted lists of random values with the Fig. 12.3 insert (a walk
+// from the start of the list) and with the skip list, then searches and
+// deletes half of the values again.
+// NOTE: This file must be compiled with skipList.c, for example
+//    gcc -O2 ch12SkipListBenchmark.c skipList.c -o ch12SkipListBenchmark
+// Usage: ch12SkipListBenchmark [largestNumberOfValues]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "skipList.h"
+
+#define SMALLEST_VALUES 10000
+#define DEFAULT_LARGEST_VALUES 1000000
+
+// building the linked list is O(n^2); 100000 values already take minutes
+#define LINKED_LIST_LIMIT 50000
+
+// fig12_03 list node, holding an int instead of a char
+struct listNode {
+   int data;
+   struct listNode *nextPtr;
+};
+
+typedef struct listNode ListNode;
+typedef ListNode *ListNodePtr;
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// fig12_03 insert: walk to the sorted position
+static void insert(ListNodePtr *sPtr, int value)
+{
+   ListNodePtr newPtr = malloc(sizeof(ListNode));
+   newPtr->data = value;
+
+   ListNodePtr previousPtr = NULL;
+   ListNodePtr currentPtr = *sPtr;
+
+   while (currentPtr != NULL && value > currentPtr->data) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextPtr;
+   }
+
+   if (previousPtr == NULL) {
+      newPtr->nextPtr = *sPtr;
+      *sPtr = newPtr;
+   }
+   else {
+      previousPtr->nextPtr = newPtr;
+      newPtr->nextPtr = currentPtr;
+   }
+}
+
+// fig12_03 delete; returns 1 if value was found
+static int delete(ListNodePtr *sPtr, int value)
+{
+   ListNodePtr previousPtr = NULL;
+   ListNodePtr currentPtr = *sPtr;
+
+   while (currentPtr != NULL && currentPtr->data != value) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextPtr;
+   }
+
+   if (currentPtr == NULL) {
+      return 0;
+   }
+
+   if (previousPtr == NULL) {
+      *sPtr = currentPtr->nextPtr;
+   }
+   else {
+      previousPtr->nextPtr = currentPtr->nextPtr;
+   }
+
+   free(currentPtr);
+   return 1;
+}
+
+// free what is left of a linked list
+static void freeList(ListNodePtr *sPtr)
+{
+   while (*sPtr != NULL) {
+      ListNodePtr tempPtr = *sPtr;
+      *sPtr = tempPtr->nextPtr;
+      free(tempPtr);
+   }
+}
+
+// time inserting every value, then deleting every other one
+static void runLinkedList(const int values[], size_t count)
+{
+   ListNodePtr startPtr = NULL;
+   double start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      insert(&startPtr, values[i]);
+   }
+
+   double insertSeconds = secondsNow() - start;
+   size_t deleted = 0;
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; i += 2) {
+      deleted += delete(&startPtr, values[i]);
+   }
+
+   double deleteSeconds = secondsNow() - start;
+
+   printf("%-12s%12zu%14.3f%14.3f%s\n", "linked list", count,
+      count / insertSeconds / 1e6, (count + 1) / 2 / deleteSeconds / 1e6,
+      deleted == (count + 1) / 2 ? "" : "  VALUES MISSING");
+
+   freeList(&startPtr);
+}
+
+// the same work on the skip list, checking membership afterwards
+static void runSkipList(const int values[], size_t count)
+{
+   SkipList list;
+   initSkipList(&list);
+
+   double start = secondsNow();
+
+   for (size_t i = 0; i < count; ++i) {
+      insertSkipList(&list, values[i]);
+   }
+
+   double insertSeconds = secondsNow() - start;
+   size_t deleted = 0;
+   start = secondsNow();
+
+   for (size_t i = 0; i < count; i += 2) {
+      deleted += deleteSkipList(&list, values[i]);
+   }
+
+   double deleteSeconds = secondsNow() - start;
+   int correct = deleted == (count + 1) / 2 && list.count == count / 2;
+
+   for (size_t i = 1; i < count; i += 2) {
+      correct &= searchSkipList(&list, values[i]);
+   }
+
+   printf("%-12s%12zu%14.3f%14.3f%s\n", "skip list", count,
+      count / insertSeconds / 1e6, (count + 1) / 2 / deleteSeconds / 1e6,
+      correct ? "" : "  WRONG CONTENTS");
+
+   freeSkipList(&list);
+}
+
+int main(int argc, char *argv[])
+{
+   size_t largest = DEFAULT_LARGEST_VALUES;
+
+   if (argc > 1) {
+      largest = strtoul(argv[1], NULL, 10);
+   }
+
+   int *values = malloc(largest * sizeof(int));
+
+   if (values == NULL) {
+      puts("Cannot allocate the values.");
+      return EXIT_FAILURE;
+   }
+
+   // distinct values in random order
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < largest; ++i) {
+      values[i] = (int) i;
+   }
+
+   for (size_t i = largest - 1; i > 0; --i) {
+      size_t j = nextRandom(&state) % (i + 1);
+      int temp = values[i];
+      values[i] = values[j];
+      values[j] = temp;
+   }
+
+   puts("Millions of operations per second");
+   printf("%-12s%12s%14s%14s\n", "List", "Values", "insert", "delete");
+
+   for (size_t count = SMALLEST_VALUES; count <= largest; count *= 10) {
+      if (count <= LINKED_LIST_LIMIT) {
+         runLinkedList(values, count);
+      }
+      else {
+         printf("%-12s%12zu%14s%14s\n", "linked list", count, "skipped",
+            "skipped");
+      }
+
+      runSkipList(values, count);
+   }
+
+   printf("\nLinked list runs above %d values are skipped: building the "
+      "list is O(n^2).\n", LINKED_LIST_LIMIT);
+   free(values);
+}
@@ -0,0 +1,357 @@
+// ch12TraversalBenchmark.c
+// Checks the iterative traversals of binaryTree.c against the recursive
+// preorder, inorder and postorder walks of Fig. 12.19 and times them, on
+// a random tree and on trees degenerated into one long left or right
+// spine, which are too deep for the recursive walks. Also checks that a
+// Morris walk leaves the tree unchanged and that an in-order cursor can
+// stop part way and resume where it left off.
+// NOTE: This file must be compiled with binaryTree.c, for example
+//    gcc -O2 ch12TraversalBenchmark.c binaryTree.c -o ch12TraversalBenchmark
+// Usage: ch12TraversalBenchmark [randomKeys] [spineDepth]
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "binaryTree.h"
+
+#define DEFAULT_KEYS 1000000
+#define DEFAULT_DEPTH 1000000
+#define CURSOR_STEPS 3 // the cursor is paused this many times
+
+// values in the order one traversal visited them
+struct valueList {
+   int *values;
+   size_t count;
+};
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// TreeVisitor: append value to a valueList
+static void appendValue(int value, void *contextPtr)
+{
+   struct valueList *listPtr = contextPtr;
+   listPtr->values[listPtr->count++] = value;
+}
+
+// the recursive walks of Fig. 12.19, recording instead of printing
+static void recursivePreOrder(TreeNodePtr treePtr, struct valueList *listPtr)
+{
+   if (treePtr != NULL) {
+      appendValue(treePtr->data, listPtr);
+      recursivePreOrder(treePtr->leftPtr, listPtr);
+      recursivePreOrder(treePtr->rightPtr, listPtr);
+   }
+}
+
+static void recursiveInOrder(TreeNodePtr treePtr, struct valueList *listPtr)
+{
+   if (treePtr != NULL) {
+      recursiveInOrder(treePtr->leftPtr, listPtr);
+      appendValue(treePtr->data, listPtr);
+      recursiveInOrder(treePtr->rightPtr, listPtr);
+   }
+}
+
+static void recursivePostOrder(TreeNodePtr treePtr, struct valueList *listPtr)
+{
+   if (treePtr != NULL) {
+      recursivePostOrder(treePtr->leftPtr, listPtr);
+      recursivePostOrder(treePtr->rightPtr, listPtr);
+      appendValue(treePtr->data, listPtr);
+   }
+}
+
+// return 1 if both lists hold the same values in the same order
+static int sameValues(const struct valueList *aPtr,
+   const struct valueList *bPtr)
+{
+   return aPtr->count == bPtr->count &&
+      memcmp(aPtr->values, bPtr->values, aPtr->count * sizeof(int)) == 0;
+}
+
+// walk the tree in order with one cursor, pausing it CURSOR_STEPS times
+// for a full walk of a second cursor over the same tree; adds the values
+// both cursors visited to *visitedPtr
+static int cursorWalk(TreeNodePtr treePtr, struct valueList *listPtr,
+   struct valueList *scratchPtr, const struct valueList *expectedPtr,
+   size_t *visitedPtr)
+{
+   TreeCursor cursor;
+   int value;
+   size_t pauseEvery = expectedPtr->count / (CURSOR_STEPS + 1) + 1;
+   int passed = 1;
+
+   openTreeCursor(&cursor, treePtr);
+
+   while (nextInOrder(&cursor, &value)) {
+      appendValue(value, listPtr);
+
+      if (listPtr->count % pauseEvery == 0) {
+         TreeCursor otherCursor;
+         scratchPtr->count = 0;
+         openTreeCursor(&otherCursor, treePtr);
+
+         while (nextInOrder(&otherCursor, &value)) {
+            appendValue(value, scratchPtr);
+         }
+
+         closeTreeCursor(&otherCursor);
+         passed &= sameValues(scratchPtr, expectedPtr);
+         *visitedPtr += scratchPtr->count;
+      }
+   }
+
+   *visitedPtr += listPtr->count;
+   passed &= cursor.nextPtr == NULL; // not stopped by a full stack
+   closeTreeCursor(&cursor);
+   return passed;
+}
+
+// check and time every traversal of treePtr against the expected orders;
+// returns 1 if all of them matched
+static int runTree(const char *name, TreeNodePtr treePtr, size_t count,
+   const struct valueList expected[3])
+{
+   struct valueList got = { malloc(count * sizeof(int)), 0 };
+   struct valueList scratch = { malloc(count * sizeof(int)), 0 };
+
+   if (got.values == NULL || scratch.values == NULL) {
+      puts("Cannot allocate the value lists.");
+      free(got.values);
+      free(scratch.values);
+      return 0;
+   }
+
+   const struct valueList *preOrderPtr = &expected[0];
+   const struct valueList *inOrderPtr = &expected[1];
+   const struct valueList *postOrderPtr = &expected[2];
+   int passed = 1;
+
+   printf("%s, %zu nodes\n", name, count);
+
+   double start = secondsNow();
+   int completed = preOrderVisit(treePtr, appendValue, &got);
+   double rate = count / (secondsNow() - start) / 1e6;
+   int matched = completed && sameValues(&got, preOrderPtr);
+   printf("%-16s%10.1f  %s\n", "preOrderVisit", rate,
+      matched ? "matches" : "WRONG");
+   passed &= matched;
+
+   got.count = 0;
+   start = secondsNow();
+   completed = inOrderVisit(treePtr, appendValue, &got);
+   rate = count / (secondsNow() - start) / 1e6;
+   matched = completed && sameValues(&got, inOrderPtr);
+   printf("%-16s%10.1f  %s\n", "inOrderVisit", rate,
+      matched ? "matches" : "WRONG");
+   passed &= matched;
+
+   got.count = 0;
+   start = secondsNow();
+   completed = postOrderVisit(treePtr, appendValue, &got);
+   rate = count / (secondsNow() - start) / 1e6;
+   matched = completed && sameValues(&got, postOrderPtr);
+   printf("%-16s%10.1f  %s\n", "postOrderVisit", rate,
+      matched ? "matches" : "WRONG");
+   passed &= matched;
+
+   // the preorder and inorder of distinct keys fix the shape of a tree, so
+   // walking both again shows the Morris threads were all removed
+   got.count = 0;
+   start = secondsNow();
+   inOrderMorris(treePtr, appendValue, &got);
+   rate = count / (secondsNow() - start) / 1e6;
+   matched = sameValues(&got, inOrderPtr);
+   got.count = 0;
+   scratch.count = 0;
+   int unchanged = preOrderVisit(treePtr, appendValue, &got) &&
+      inOrderVisit(treePtr, appendValue, &scratch) &&
+      sameValues(&got, preOrderPtr) && sameValues(&scratch, inOrderPtr);
+   printf("%-16s%10.1f  %s%s\n", "inOrderMorris", rate,
+      matched ? "matches" : "WRONG",
+      unchanged ? ", tree unchanged" : ", TREE CHANGED");
+   passed &= matched && unchanged;
+
+   size_t visited = 0;
+   got.count = 0;
+   start = secondsNow();
+   completed = cursorWalk(treePtr, &got, &scratch, inOrderPtr, &visited);
+   rate = visited / (secondsNow() - start) / 1e6;
+   matched = completed && sameValues(&got, inOrderPtr);
+   printf("%-16s%10.1f  %s\n", "paused cursor", rate,
+      matched ? "matches" : "WRONG");
+   passed &= matched;
+
+   puts("");
+   free(got.values);
+   free(scratch.values);
+   return passed;
+}
+
+// build a chain of depth nodes holding 0 .. depth - 1 down the left or
+// right spine and store how many were built in *builtPtr; each
+// insertNode starts at the empty child slot below the previous node, so
+// building the chain takes linear time but leaves the subtree sizes of
+// the ancestors stale, which the traversals never read
+static TreeNodePtr buildSpine(size_t depth, int leftSpine, size_t *builtPtr)
+{
+   TreeNodePtr rootPtr = NULL;
+   TreeNodePtr *slotPtr = &rootPtr;
+
+   for (*builtPtr = 0; *builtPtr < depth; ++*builtPtr) {
+      size_t i = *builtPtr;
+      int value = leftSpine ? (int) (depth - 1 - i) : (int) i;
+      insertNode(slotPtr, value);
+
+      if (*slotPtr == NULL) {
+         break;
+      }
+
+      slotPtr = leftSpine ? &(*slotPtr)->leftPtr : &(*slotPtr)->rightPtr;
+   }
+
+   return rootPtr;
+}
+
+// allocate the three expected orders of a count-node tree
+static int allocateExpected(struct valueList expected[3], size_t count)
+{
+   for (int i = 0; i < 3; ++i) {
+      expected[i].values = malloc(count * sizeof(int));
+      expected[i].count = count;
+   }
+
+   return expected[0].values != NULL && expected[1].values != NULL &&
+      expected[2].values != NULL;
+}
+
+// free the three expected orders
+static void freeExpected(struct valueList expected[3])
+{
+   for (int i = 0; i < 3; ++i) {
+      free(expected[i].values);
+   }
+}
+
+// a spine is too deep for the recursive walks; its orders are known:
+// a right spine visits preorder and inorder ascending and postorder
+// descending, a left spine visits preorder descending and the others
+// ascending
+static int runSpine(size_t depth, int leftSpine)
+{
+   struct valueList expected[3];
+   size_t built;
+   TreeNodePtr rootPtr = buildSpine(depth, leftSpine, &built);
+   int passed = 0;
+
+   if (allocateExpected(expected, depth) && built == depth) {
+      for (size_t i = 0; i < depth; ++i) {
+         int ascending = (int) i;
+         int descending = (int) (depth - 1 - i);
+         expected[0].values[i] = leftSpine ? descending : ascending;
+         expected[1].values[i] = ascending;
+         expected[2].values[i] = leftSpine ? ascending : descending;
+      }
+
+      passed = runTree(leftSpine ? "Left spine" : "Right spine", rootPtr,
+         depth, expected);
+   }
+   else {
+      puts("Cannot build the spine.");
+   }
+
+   freeExpected(expected);
+   freeTree(&rootPtr);
+   return passed;
+}
+
+// a random tree is shallow enough to check against the recursive walks
+static int runRandom(size_t count)
+{
+   struct valueList expected[3] = { { NULL, 0 }, { NULL, 0 }, { NULL, 0 } };
+   TreeNodePtr rootPtr = NULL;
+   unsigned long long state = 2060;
+   int passed = 0;
+   int *keys = malloc(count * sizeof(int));
+
+   if (keys != NULL && allocateExpected(expected, count)) {
+      // insert a shuffled 0 .. count - 1 so every key is distinct
+      for (size_t i = 0; i < count; ++i) {
+         keys[i] = (int) i;
+      }
+
+      for (size_t i = count; i > 1; --i) {
+         size_t j = nextRandom(&state) % i;
+         int swap = keys[i - 1];
+         keys[i - 1] = keys[j];
+         keys[j] = swap;
+      }
+
+      for (size_t i = 0; i < count; ++i) {
+         insertNode(&rootPtr, keys[i]);
+      }
+
+      for (int i = 0; i < 3; ++i) {
+         expected[i].count = 0;
+      }
+
+      recursivePreOrder(rootPtr, &expected[0]);
+      recursiveInOrder(rootPtr, &expected[1]);
+      recursivePostOrder(rootPtr, &expected[2]);
+      passed = runTree("Random tree", rootPtr, count, expected);
+   }
+   else {
+      puts("Cannot allocate the keys.");
+   }
+
+   freeExpected(expected);
+   freeTree(&rootPtr);
+   free(keys);
+   return passed;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t count = DEFAULT_KEYS;
+   size_t depth = DEFAULT_DEPTH;
+
+   if (argc > 1) {
+      count = strtoul(argv[1], NULL, 10);
+   }
+
+   if (argc > 2) {
+      depth = strtoul(argv[2], NULL, 10);
+   }
+
+   if (count < 1) {
+      count = 1;
+   }
+
+   if (depth < 1) {
+      depth = 1;
+   }
+
+   puts("Millions of nodes visited per second\n");
+
+   int passed = runRandom(count);
+   passed &= runSpine(depth, 1);
+   passed &= runSpine(depth, 0);
+
+   puts(passed ? "All traversals matched." : "A TRAVERSAL FAILED.");
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,192 @@
+// ch12UnrolledListBenchmark.c
+// Builds sorted lists of random values with the Fig. 12.3 insert and with
+// the unrolled list, then times walks over every value in order.
+// NOTE: This file must be compiled with unrolledList.c, for example
+//    gcc -O2 ch12UnrolledListBenchmark.c unrolledList.c -o ch12UnrolledListBenchmark
+// Usage: ch12UnrolledListBenchmark [largestNumberOfValues]
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "unrolledList.h"
+
+#define SMALLEST_VALUES 1000
+#define GROWTH 4 // each run holds this many times the values of the last
+
+// inserting in sorted order is O(n^2) for both lists, so the default
+// stops where the linked list still finishes in seconds
+#define DEFAULT_LARGEST_VALUES 64000
+
+// each walk measurement visits about this many values in total
+#define VALUES_VISITED 50000000
+
+// fig12_03 list node, holding an int instead of a char
+struct listNode {
+   int data;
+   struct listNode *nextPtr;
+};
+
+typedef struct listNode ListNode;
+typedef ListNode *ListNodePtr;
+
+// wall-clock seconds from a monotonic clock
+static double secondsNow(void)
+{
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+// xorshift64 pseudorandom numbers
+static unsigned long long nextRandom(unsigned long long *statePtr)
+{
+   *statePtr ^= *statePtr << 13;
+   *statePtr ^= *statePtr >> 7;
+   *statePtr ^= *statePtr << 17;
+   return *statePtr;
+}
+
+// fig12_03 insert: walk to the sorted position
+static void insert(ListNodePtr *sPtr, int value)
+{
+   ListNodePtr newPtr = malloc(sizeof(ListNode));
+   newPtr->data = value;
+
+   ListNodePtr previousPtr = NULL;
+   ListNodePtr currentPtr = *sPtr;
+
+   while (currentPtr != NULL && value > currentPtr->data) {
+      previousPtr = currentPtr;
+      currentPtr = currentPtr->nextPtr;
+   }
+
+   if (previousPtr == NULL) {
+      newPtr->nextPtr = *sPtr;
+      *sPtr = newPtr;
+   }
+   else {
+      previousPtr->nextPtr = newPtr;
+      newPtr->nextPtr = currentPtr;
+   }
+}
+
+// free what is left of a linked list
+static void freeList(ListNodePtr *sPtr)
+{
+   while (*sPtr != NULL) {
+      ListNodePtr tempPtr = *sPtr;
+      *sPtr = tempPtr->nextPtr;
+      free(tempPtr);
+   }
+}
+
+// the walk printList does, summing instead of printing
+static long long sumList(ListNodePtr currentPtr)
+{
+   long long sum = 0;
+
+   while (currentPtr != NULL) {
+      sum += currentPtr->data;
+      currentPtr = currentPtr->nextPtr;
+   }
+
+   return sum;
+}
+
+// the walk printUnrolled does, summing instead of printing
+static long long sumUnrolled(const UnrolledList *listPtr)
+{
+   long long sum = 0;
+
+   for (const UnrolledBlock *blockPtr = listPtr->headPtr; blockPtr != NULL;
+      blockPtr = blockPtr->nextPtr) {
+      for (int index = 0; index < blockPtr->count; ++index) {
+         sum += blockPtr->data[index];
+      }
+   }
+
+   return sum;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t largest = DEFAULT_LARGEST_VALUES;
+
+   if (argc > 1) {
+      largest = strtoul(argv[1], NULL, 10);
+   }
+
+   int *values = malloc(largest * sizeof(int));
+
+   if (values == NULL) {
+      puts("Cannot allocate the values.");
+      return EXIT_FAILURE;
+   }
+
+   unsigned long long state = 2060;
+
+   for (size_t i = 0; i < largest; ++i) {
+      values[i] = (int) (nextRandom(&state) >> 34);
+   }
+
+   int passed = 1;
+
+   puts("Millions of values per second");
+   printf("%10s%14s%14s%14s%14s%12s\n", "Values", "list insert",
+      "block insert", "list walk", "block walk", "bytes/value");
+
+   for (size_t count = SMALLEST_VALUES; count <= largest; count *= GROWTH) {
+      ListNodePtr startPtr = NULL;
+      UnrolledList list;
+      initUnrolledList(&list);
+
+      double start = secondsNow();
+
+      for (size_t i = 0; i < count; ++i) {
+         insert(&startPtr, values[i]);
+      }
+
+      double listInsert = count / (secondsNow() - start) / 1e6;
+      start = secondsNow();
+
+      for (size_t i = 0; i < count; ++i) {
+         insertUnrolled(&list, values[i]);
+      }
+
+      double blockInsert = count / (secondsNow() - start) / 1e6;
+
+      // repeat the walks so small lists are timed over many passes
+      size_t passes = VALUES_VISITED / count + 1;
+      long long listSum = 0;
+      long long blockSum = 0;
+      start = secondsNow();
+
+      for (size_t pass = 0; pass < passes; ++pass) {
+         listSum += sumList(startPtr);
+      }
+
+      double listWalk = passes * count / (secondsNow() - start) / 1e6;
+      start = secondsNow();
+
+      for (size_t pass = 0; pass < passes; ++pass) {
+         blockSum += sumUnrolled(&list);
+      }
+
+      double blockWalk = passes * count / (secondsNow() - start) / 1e6;
+
+      if (listSum != blockSum || list.count != count) {
+         passed = 0;
+      }
+
+      printf("%10zu%14.3f%14.3f%14.1f%14.1f%12.1f\n", count, listInsert,
+         blockInsert, listWalk, blockWalk,
+         (double) list.blocks * sizeof(UnrolledBlock) / count);
+
+      freeList(&startPtr);
+      freeUnrolled(&list);
+   }
+
+   printf("\nBoth lists hold the same values: %s\n",
+      passed ? "yes" : "NO");
+   free(values);
+   return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,370 @@
+// compressedSet.c
+// Compressed sorted set function definitions.
+// An update decodes its block into an array, changes the array and packs
+// it again, so it costs O(COMPRESSED_BLOCK_VALUES) whatever the set size.
+// Every gap in a block has the same width, so unpacking is a loop over
+// fixed-width fields with no data-dependent branches.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "compressedSet.h" // include definition of CompressedSet
+
+// start with no blocks
+void initCompressedSet(CompressedSet *setPtr)
+{
+   setPtr->blocks = NULL;
+   setPtr->blockCount = 0;
+   setPtr->blockCapacity = 0;
+   setPtr->count = 0;
+}
+
+// bits needed to hold gap
+static unsigned int bitsFor(uint32_t gap)
+{
+   unsigned int bits = 0;
+
+   while (gap != 0) {
+      ++bits;
+      gap >>= 1;
+   }
+
+   return bits;
+}
+
+// words holding count - 1 gaps of bitWidth bits, plus one word so that
+// every gap can be read with one 64-bit window
+static size_t wordsFor(unsigned int count, unsigned int bitWidth)
+{
+   return ((size_t) (count - 1) * bitWidth + 31) / 32 + 1;
+}
+
+// pack values[0 .. count - 1] into a new block header; returns 0 if no
+// memory is available, leaving *blockPtr unchanged
+static int packBlock(CompressedBlock *blockPtr, const int values[],
+   unsigned int count)
+{
+   uint32_t widest = 0;
+
+   for (unsigned int i = 1; i < count; ++i) {
+      widest |= (uint32_t) values[i] - (uint32_t) values[i - 1] - 1;
+   }
+
+   unsigned int bitWidth = bitsFor(widest);
+   uint32_t *words = calloc(wordsFor(count, bitWidth), sizeof(uint32_t));
+
+   if (words == NULL) {
+      return 0;
+   }
+
+   for (unsigned int i = 1; i < count; ++i) {
+      uint64_t gap = (uint32_t) values[i] - (uint32_t) values[i - 1] - 1;
+      size_t bit = (size_t) (i - 1) * bitWidth;
+      uint64_t shifted = gap << (bit % 32);
+
+      words[bit / 32] |= (uint32_t) shifted;
+      words[bit / 32 + 1] |= (uint32_t) (shifted >> 32);
+   }
+
+   free(blockPtr->words);
+   blockPtr->first = values[0];
+   blockPtr->last = values[count - 1];
+   blockPtr->count = count;
+   blockPtr->bitWidth = bitWidth;
+   blockPtr->words = words;
+   return 1;
+}
+
+// gap i of a block, already plus one
+static uint32_t gapAt(const CompressedBlock *blockPtr, unsigned int i)
+{
+   size_t bit = (size_t) i * blockPtr->bitWidth;
+   uint64_t window = blockPtr->words[bit / 32] |
+      (uint64_t) blockPtr->words[bit / 32 + 1] << 32;
+   uint64_t mask = ((uint64_t) 1 << blockPtr->bitWidth) - 1;
+
+   return (uint32_t) ((window >> (bit % 32)) & mask) + 1;
+}
+
+// decode every value of a block into values[]
+static void unpackBlock(const CompressedBlock *blockPtr, int values[])
+{
+   uint32_t current = (uint32_t) blockPtr->first;
+   values[0] = blockPtr->first;
+
+   for (unsigned int i = 1; i < blockPtr->count; ++i) {
+      current += gapAt(blockPtr, i - 1);
+      values[i] = (int) current;
+   }
+}
+
+// index of the last block whose first value is <= value, or 0
+static size_t findBlock(const CompressedSet *setPtr, int value)
+{
+   size_t low = 0;
+   size_t high = setPtr->blockCount;
+
+   // binary search over the block headers
+   while (high - low > 1) {
+      size_t middle = low + (high - low) / 2;
+
+      if (setPtr->blocks[middle].first <= value) {
+         low = middle;
+      }
+      else {
+         high = middle;
+      }
+   }
+
+   return low;
+}
+
+// open an empty header at index; returns 0 if no memory is available
+static int openBlock(CompressedSet *setPtr, size_t index)
+{
+   if (setPtr->blockCount == setPtr->blockCapacity) {
+      size_t capacity =
+         setPtr->blockCapacity == 0 ? 16 : 2 * setPtr->blockCapacity;
+      CompressedBlock *blocks =
+         realloc(setPtr->blocks, capacity * sizeof(CompressedBlock));
+
+      if (blocks == NULL) {
+         return 0;
+      }
+
+      setPtr->blocks = blocks;
+      setPtr->blockCapacity = capacity;
+   }
+
+   memmove(&setPtr->blocks[index + 1], &setPtr->blocks[index],
+      (setPtr->blockCount - index) * sizeof(CompressedBlock));
+   setPtr->blocks[index].words = NULL;
+   ++setPtr->blockCount;
+   return 1;
+}
+
+// free a block and close its gap in the headers
+static void closeBlock(CompressedSet *setPtr, size_t index)
+{
+   free(setPtr->blocks[index].words);
+   --setPtr->blockCount;
+   memmove(&setPtr->blocks[index], &setPtr->blocks[index + 1],
+      (setPtr->blockCount - index) * sizeof(CompressedBlock));
+}
+
+// insert value; returns 1 if inserted, 0 if it was already in the set or
+// no memory is available
+int insertCompressed(CompressedSet *setPtr, int value)
+{
+   int values[COMPRESSED_BLOCK_VALUES + 1];
+
+   if (setPtr->blockCount == 0) {
+      if (!openBlock(setPtr, 0) ||
+         !packBlock(&setPtr->blocks[0], &value, 1)) {
+         setPtr->blockCount = 0;
+         printf("No memory to insert %d\n", value);
+         return 0;
+      }
+
+      setPtr->count = 1;
+      return 1;
+   }
+
+   size_t index = findBlock(setPtr, value);
+   CompressedBlock *blockPtr = &setPtr->blocks[index];
+   unsigned int count = blockPtr->count;
+
+   unpackBlock(blockPtr, values);
+
+   // find the position of value and move larger values up by one
+   unsigned int position = 0;
+
+   while (position < count && values[position] < value) {
+      ++position;
+   }
+
+   if (position < count && values[position] == value) { // already present
+      return 0;
+   }
+
+   memmove(&values[position + 1], &values[position],
+      (count - position) * sizeof(int));
+   values[position] = value;
+   ++count;
+
+   int packed;
+
+   if (count <= COMPRESSED_BLOCK_VALUES) {
+      packed = packBlock(blockPtr, values, count);
+   }
+   else { // split: the upper half goes into a new block after this one
+      unsigned int keep = count / 2;
+      packed = openBlock(setPtr, index + 1);
+
+      if (packed) {
+         blockPtr = &setPtr->blocks[index]; // blocks may have moved
+         packed = packBlock(&setPtr->blocks[index + 1], &values[keep],
+            count - keep);
+
+         if (packed) {
+            packed = packBlock(blockPtr, values, keep);
+         }
+
+         if (!packed) {
+            closeBlock(setPtr, index + 1);
+         }
+      }
+   }
+
+   if (!packed) {
+      printf("No memory to insert %d\n", value);
+      return 0;
+   }
+
+   ++setPtr->count;
+   return 1;
+}
+
+// delete value; returns 1 if it was in the set
+int deleteCompressed(CompressedSet *setPtr, int value)
+{
+   int values[2 * COMPRESSED_BLOCK_VALUES];
+
+   if (!containsCompressed(setPtr, value)) {
+      return 0;
+   }
+
+   size_t index = findBlock(setPtr, value);
+   CompressedBlock *blockPtr = &setPtr->blocks[index];
+   unsigned int count = blockPtr->count;
+
+   unpackBlock(blockPtr, values);
+
+   unsigned int position = 0;
+
+   while (values[position] != value) {
+      ++position;
+   }
+
+   --count;
+   memmove(&values[position], &values[position + 1],
+      (count - position) * sizeof(int));
+
+   int packed = 1;
+
+   if (count == 0) {
+      closeBlock(setPtr, index);
+   }
+   else if (count < COMPRESSED_BLOCK_VALUES / 4 &&
+      index + 1 < setPtr->blockCount &&
+      count + setPtr->blocks[index + 1].count <= COMPRESSED_BLOCK_VALUES) {
+      // a block under a quarter full takes in the next block
+      CompressedBlock *nextPtr = &setPtr->blocks[index + 1];
+      unpackBlock(nextPtr, &values[count]);
+      packed = packBlock(blockPtr, values, count + nextPtr->count);
+
+      if (packed) {
+         closeBlock(setPtr, index + 1);
+      }
+   }
+   else {
+      packed = packBlock(blockPtr, values, count);
+   }
+
+   // removing a value joins two gaps, which may need wider fields
+   if (!packed) {
+      printf("No memory to delete %d\n", value);
+      return 0;
+   }
+
+   --setPtr->count;
+   return 1;
+}
+
+// return 1 if value is in the set, 0 otherwise
+int containsCompressed(const CompressedSet *setPtr, int value)
+{
+   if (setPtr->blockCount == 0) {
+      return 0;
+   }
+
+   const CompressedBlock *blockPtr =
+      &setPtr->blocks[findBlock(setPtr, value)];
+
+   if (value < blockPtr->first || value > blockPtr->last) {
+      return 0;
+   }
+
+   // add up gaps until the running value reaches value
+   uint32_t current = (uint32_t) blockPtr->first;
+   uint32_t target = (uint32_t) value;
+   unsigned int i = 0;
+
+   while (current - (uint32_t) blockPtr->first <
+      target - (uint32_t) blockPtr->first) {
+      current += gapAt(blockPtr, i);
+      ++i;
+   }
+
+   return current == target;
+}
+
+// call visit for every value in ascending order
+void inOrderCompressed(const CompressedSet *setPtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr)
+{
+   int values[COMPRESSED_BLOCK_VALUES];
+
+   for (size_t b = 0; b < setPtr->blockCount; ++b) {
+      unpackBlock(&setPtr->blocks[b], values);
+
+      for (unsigned int i = 0; i < setPtr->blocks[b].count; ++i) {
+         visit(values[i], contextPtr);
+      }
+   }
+}
+
+// print one value of the set
+static void printValue(int value, void *contextPtr)
+{
+   (void) contextPtr;
+   printf("%d --> ", value);
+}
+
+// print the set in ascending order
+void printCompressedSet(const CompressedSet *setPtr)
+{
+   // if set is empty
+   if (setPtr->count == 0) {
+      puts("Set is empty.\n");
+   }
+   else {
+      puts("The set is:");
+      inOrderCompressed(setPtr, printValue, NULL);
+      puts("NULL\n");
+   }
+}
+
+// heap bytes the set holds: block headers plus packed words
+size_t compressedSetBytes(const CompressedSet *setPtr)
+{
+   size_t bytes = setPtr->blockCapacity * sizeof(CompressedBlock);
+
+   for (size_t b = 0; b < setPtr->blockCount; ++b) {
+      const CompressedBlock *blockPtr = &setPtr->blocks[b];
+      bytes += wordsFor(blockPtr->count, blockPtr->bitWidth) *
+         sizeof(uint32_t);
+   }
+
+   return bytes;
+}
+
+// free every block
+void freeCompressedSet(CompressedSet *setPtr)
+{
+   for (size_t b = 0; b < setPtr->blockCount; ++b) {
+      free(setPtr->blocks[b].words);
+   }
+
+   free(setPtr->blocks);
+   initCompressedSet(setPtr);
+}
@@ -0,0 +1,51 @@
+// compressedSet.h
+// Compressed sorted set of ints for the values ch12SingleLLAddDelete keeps
+// in one 16-byte node each. Values are stored in blocks of up to
+// COMPRESSED_BLOCK_VALUES: a block keeps its first value and packs the gaps
+// between neighbouring values with the same number of bits for every gap,
+// so close values take a few bits each and runs of consecutive values take
+// none. The array of block headers, sorted by first value, serves as the
+// skip index: a binary search over it finds the one block to decode.
+// Set functions are defined in compressedSet.c
+
+// prevent multiple inclusions of header
+#ifndef COMPRESSEDSET_H
+#define COMPRESSEDSET_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define COMPRESSED_BLOCK_VALUES 128 // most values in one block
+
+// one block of sorted values
+struct compressedBlock {
+   int first; // smallest value in the block
+   int last; // largest value, to skip the block without decoding it
+   unsigned int count; // values in the block
+   unsigned int bitWidth; // bits per packed gap, 0 to 32
+   uint32_t *words; // the count - 1 gaps, each stored minus one
+};
+
+typedef struct compressedBlock CompressedBlock; // synonym
+
+struct compressedSet {
+   CompressedBlock *blocks; // block headers in ascending order
+   size_t blockCount; // blocks in use
+   size_t blockCapacity; // room in blocks
+   size_t count; // values in the set
+};
+
+typedef struct compressedSet CompressedSet; // synonym
+
+// prototypes
+void initCompressedSet(CompressedSet *setPtr);
+int insertCompressed(CompressedSet *setPtr, int value);
+int deleteCompressed(CompressedSet *setPtr, int value);
+int containsCompressed(const CompressedSet *setPtr, int value);
+void inOrderCompressed(const CompressedSet *setPtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr);
+void printCompressedSet(const CompressedSet *setPtr);
+size_t compressedSetBytes(const CompressedSet *setPtr);
+void freeCompressedSet(CompressedSet *setPtr);
+
+#endif
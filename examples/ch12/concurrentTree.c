@@ -0,0 +1,121 @@
+// concurrentTree.c
+// Concurrent insert-only binary search tree function definitions.
+// A new node is fully written before the compare-and-swap that links it
+// publishes it with release ordering; readers load child pointers with
+// acquire ordering and so always see a node's data. An insert whose
+// compare-and-swap fails lost a race for the same empty link and simply
+// continues the descent from the node that won.
+#include <stdlib.h>
+#include "concurrentTree.h" // include definition of ConcurrentTree
+
+// start with an empty tree
+void initConcurrentTree(ConcurrentTree *treePtr)
+{
+   atomic_init(&treePtr->rootPtr, NULL);
+}
+
+// insert value unless it is already present; returns 1 if inserted, 0
+// for a duplicate or when out of memory
+int insertConcurrent(ConcurrentTree *treePtr, int value)
+{
+   ConcurrentNodePtr newPtr = NULL;
+   _Atomic(ConcurrentNodePtr) *linkPtr = &treePtr->rootPtr;
+
+   for (;;) {
+      ConcurrentNodePtr nodePtr =
+         atomic_load_explicit(linkPtr, memory_order_acquire);
+
+      if (nodePtr == NULL) {
+         // create the node only once the value is known to be new
+         if (newPtr == NULL) {
+            newPtr = malloc(sizeof(ConcurrentNode));
+
+            if (newPtr == NULL) {
+               return 0;
+            }
+
+            atomic_init(&newPtr->leftPtr, NULL);
+            newPtr->data = value;
+            atomic_init(&newPtr->rightPtr, NULL);
+         }
+
+         if (atomic_compare_exchange_strong_explicit(linkPtr, &nodePtr,
+            newPtr, memory_order_acq_rel, memory_order_acquire)) {
+            return 1;
+         }
+
+         // another thread filled the link; descend into its node
+      }
+
+      if (value < nodePtr->data) {
+         linkPtr = &nodePtr->leftPtr;
+      }
+      else if (value > nodePtr->data) {
+         linkPtr = &nodePtr->rightPtr;
+      }
+      else { // duplicate data value ignored
+         free(newPtr);
+         return 0;
+      }
+   }
+}
+
+// return 1 if value is in the tree, 0 otherwise
+int searchConcurrent(ConcurrentTree *treePtr, int value)
+{
+   ConcurrentNodePtr nodePtr =
+      atomic_load_explicit(&treePtr->rootPtr, memory_order_acquire);
+
+   while (nodePtr != NULL && nodePtr->data != value) {
+      nodePtr = atomic_load_explicit(value < nodePtr->data ?
+         &nodePtr->leftPtr : &nodePtr->rightPtr, memory_order_acquire);
+   }
+
+   return nodePtr != NULL;
+}
+
+// visit the values of a subtree in ascending order
+static void inOrderSubtree(ConcurrentNodePtr nodePtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr)
+{
+   while (nodePtr != NULL) {
+      inOrderSubtree(atomic_load_explicit(&nodePtr->leftPtr,
+         memory_order_acquire), visit, contextPtr);
+      visit(nodePtr->data, contextPtr);
+      nodePtr = atomic_load_explicit(&nodePtr->rightPtr,
+         memory_order_acquire); // loop instead of a second recursive call
+   }
+}
+
+// call visit for every value in ascending order; values inserted during
+// the walk may or may not be visited, but the order is always ascending
+void inOrderConcurrent(ConcurrentTree *treePtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr)
+{
+   inOrderSubtree(atomic_load_explicit(&treePtr->rootPtr,
+      memory_order_acquire), visit, contextPtr);
+}
+
+// free every node
+void freeConcurrentTree(ConcurrentTree *treePtr)
+{
+   ConcurrentNodePtr nodePtr = atomic_load(&treePtr->rootPtr);
+
+   // rotate left subtrees up so the tree becomes a list, freeing as it goes
+   while (nodePtr != NULL) {
+      ConcurrentNodePtr leftPtr = atomic_load(&nodePtr->leftPtr);
+
+      if (leftPtr != NULL) {
+         atomic_store(&nodePtr->leftPtr, atomic_load(&leftPtr->rightPtr));
+         atomic_store(&leftPtr->rightPtr, nodePtr);
+         nodePtr = leftPtr;
+      }
+      else {
+         ConcurrentNodePtr rightPtr = atomic_load(&nodePtr->rightPtr);
+         free(nodePtr);
+         nodePtr = rightPtr;
+      }
+   }
+
+   atomic_store(&treePtr->rootPtr, NULL);
+}
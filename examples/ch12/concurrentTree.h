@@ -0,0 +1,40 @@
+// concurrentTree.h
+// Binary search tree of Fig. 12.19 that many threads may search and insert
+// into at the same time without locks. Like Fig. 12.19 the tree only
+// grows: a node, once linked in, is never changed or removed, so a
+// reader can follow child pointers with no lock and no reclamation
+// scheme, and an insert links its new leaf with one compare-and-swap.
+// Tree functions are defined in concurrentTree.c
+
+// prevent multiple inclusions of header
+#ifndef CONCURRENTTREE_H
+#define CONCURRENTTREE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+// self-referential structure; a child pointer changes only from NULL
+struct concurrentNode {
+   _Atomic(struct concurrentNode *) leftPtr; // pointer to left subtree
+   int data; // node value, fixed once linked
+   _Atomic(struct concurrentNode *) rightPtr; // pointer to right subtree
+};
+
+typedef struct concurrentNode ConcurrentNode; // synonym
+typedef ConcurrentNode *ConcurrentNodePtr; // synonym for ConcurrentNode*
+
+struct concurrentTree {
+   _Atomic(ConcurrentNodePtr) rootPtr;
+};
+
+typedef struct concurrentTree ConcurrentTree; // synonym
+
+// prototypes; init and free may not run while other threads use the tree
+void initConcurrentTree(ConcurrentTree *treePtr);
+int insertConcurrent(ConcurrentTree *treePtr, int value);
+int searchConcurrent(ConcurrentTree *treePtr, int value);
+void inOrderConcurrent(ConcurrentTree *treePtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr);
+void freeConcurrentTree(ConcurrentTree *treePtr);
+
+#endif
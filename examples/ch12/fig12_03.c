@@ -12,6 +12,18 @@ struct listNode {
 typedef struct listNode ListNode; // synonym for struct listNode
 typedef ListNode *ListNodePtr; // synonym for ListNode*
 
+// nodes come from a node pool when compiled with -DUSE_NODE_POOL
+// NOTE: the pooled build must also be compiled with nodePool.c
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool listNodePool = NODE_POOL_INITIALIZER(ListNode);
+#define NEW_NODE() POOL_NEW(&listNodePool, ListNode)
+#define FREE_NODE(nodePtr) freeNode(&listNodePool, (nodePtr))
+#else
+#define NEW_NODE() malloc(sizeof(ListNode))
+#define FREE_NODE(nodePtr) free(nodePtr)
+#endif
+
 // prototypes
 void insert(ListNodePtr *sPtr, char value);
 char delete(ListNodePtr *sPtr, char value);
@@ -69,6 +81,10 @@ int main(void)
       scanf("%u", &choice);
    } 
 
+#ifdef USE_NODE_POOL
+   releaseNodePool(&listNodePool); // free every remaining node at once
+#endif
+
    puts("End of run.");
 } 
 
@@ -84,7 +100,7 @@ void instructions(void)
 // insert a new value into the list in sorted order
 void insert(ListNodePtr *sPtr, char value)
 { 
-   ListNodePtr newPtr = malloc(sizeof(ListNode)); // create node
+   ListNodePtr newPtr = NEW_NODE(); // create node
 
    if (newPtr != NULL) { // is space available
       newPtr->data = value; // place value in node
@@ -121,7 +137,7 @@ char delete(ListNodePtr *sPtr, char value)
    if (value == (*sPtr)->data) { 
       ListNodePtr tempPtr = *sPtr; // hold onto node being removed
       *sPtr = (*sPtr)->nextPtr; // de-thread the node
-      free(tempPtr); // free the de-threaded node
+      FREE_NODE(tempPtr); // free the de-threaded node
       return value;
    } 
    else { 
@@ -138,7 +154,7 @@ char delete(ListNodePtr *sPtr, char value)
       if (currentPtr != NULL) { 
          ListNodePtr tempPtr = currentPtr;
          previousPtr->nextPtr = currentPtr->nextPtr;
-         free(tempPtr);
+         FREE_NODE(tempPtr);
          return value;
       } 
    } 
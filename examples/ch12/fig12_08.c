@@ -12,6 +12,18 @@ struct stackNode {
 typedef struct stackNode StackNode; // synonym for struct stackNode
 typedef StackNode *StackNodePtr; // synonym for StackNode*
 
+// nodes come from a node pool when compiled with -DUSE_NODE_POOL
+// NOTE: the pooled build must also be compiled with nodePool.c
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool stackNodePool = NODE_POOL_INITIALIZER(StackNode);
+#define NEW_NODE() POOL_NEW(&stackNodePool, StackNode)
+#define FREE_NODE(nodePtr) freeNode(&stackNodePool, (nodePtr))
+#else
+#define NEW_NODE() malloc(sizeof(StackNode))
+#define FREE_NODE(nodePtr) free(nodePtr)
+#endif
+
 // prototypes
 void push(StackNodePtr *topPtr, int info);
 int pop(StackNodePtr *topPtr);
@@ -60,6 +72,10 @@ int main(void)
       scanf("%u", &choice);
    } 
 
+#ifdef USE_NODE_POOL
+   releaseNodePool(&stackNodePool); // free every remaining node at once
+#endif
+
    puts("End of run.");
 } 
 
@@ -75,7 +91,7 @@ void instructions(void)
 // insert a node at the stack top
 void push(StackNodePtr *topPtr, int info)
 { 
-   StackNodePtr newPtr = malloc(sizeof(StackNode));
+   StackNodePtr newPtr = NEW_NODE();
 
    // insert the node at stack top
    if (newPtr != NULL) {           
@@ -94,7 +110,7 @@ int pop(StackNodePtr *topPtr)
    StackNodePtr tempPtr = *topPtr;             
    int popValue = (*topPtr)->data;  
    *topPtr = (*topPtr)->nextPtr;
-   free(tempPtr);               
+   FREE_NODE(tempPtr);          
    return popValue;
 } 
 
@@ -12,6 +12,18 @@ struct queueNode {
 typedef struct queueNode QueueNode;
 typedef QueueNode *QueueNodePtr;
 
+// nodes come from a node pool when compiled with -DUSE_NODE_POOL
+// NOTE: the pooled build must also be compiled with nodePool.c
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool queueNodePool = NODE_POOL_INITIALIZER(QueueNode);
+#define NEW_NODE() POOL_NEW(&queueNodePool, QueueNode)
+#define FREE_NODE(nodePtr) freeNode(&queueNodePool, (nodePtr))
+#else
+#define NEW_NODE() malloc(sizeof(QueueNode))
+#define FREE_NODE(nodePtr) free(nodePtr)
+#endif
+
 // function prototypes
 void printQueue(QueueNodePtr currentPtr);
 int isEmpty(QueueNodePtr headPtr);
@@ -62,6 +74,10 @@ int main(void)
       scanf("%u", &choice);
    } 
 
+#ifdef USE_NODE_POOL
+   releaseNodePool(&queueNodePool); // free every remaining node at once
+#endif
+
    puts("End of run.");
 } 
 
@@ -77,7 +93,7 @@ void instructions(void)
 // insert a node at queue tail
 void enqueue(QueueNodePtr *headPtr, QueueNodePtr *tailPtr, char value)
 { 
-   QueueNodePtr newPtr = malloc(sizeof(QueueNode));
+   QueueNodePtr newPtr = NEW_NODE();
 
    if (newPtr != NULL) { // is space available 
       newPtr->data = value;
@@ -110,7 +126,7 @@ char dequeue(QueueNodePtr *headPtr, QueueNodePtr *tailPtr)
       *tailPtr = NULL;
    } 
 
-   free(tempPtr);
+   FREE_NODE(tempPtr);
    return value;
 } 
 
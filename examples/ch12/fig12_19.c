@@ -5,6 +5,12 @@
 #include <stdlib.h>
 #include <time.h>
 
+// -DBALANCED_TREE builds the tree in balanced (AVL) mode with the tree
+// functions of binaryTree.c
+// NOTE: the balanced build must also be compiled with binaryTree.c
+#ifdef BALANCED_TREE
+#include "binaryTree.h" // include definition of TreeNode
+#else
 // self-referential structure                            
 struct treeNode {                                           
    struct treeNode *leftPtr; // pointer to left subtree 
@@ -15,11 +21,22 @@ struct treeNode {
 typedef struct treeNode TreeNode; // synonym for struct treeNode
 typedef TreeNode *TreeNodePtr; // synonym for TreeNode*
 
+// nodes come from a node pool when compiled with -DUSE_NODE_POOL
+// NOTE: the pooled build must also be compiled with nodePool.c
+#ifdef USE_NODE_POOL
+#include "nodePool.h"
+NodePool treeNodePool = NODE_POOL_INITIALIZER(TreeNode);
+#define NEW_NODE() POOL_NEW(&treeNodePool, TreeNode)
+#else
+#define NEW_NODE() malloc(sizeof(TreeNode))
+#endif
+
 // prototypes
 void insertNode(TreeNodePtr *treePtr, int value);
 void inOrder(TreeNodePtr treePtr);
 void preOrder(TreeNodePtr treePtr);
 void postOrder(TreeNodePtr treePtr);
+#endif
 
 // function main begins program execution
 int main(void)
@@ -33,7 +50,13 @@ int main(void)
    for (unsigned int i = 1; i <= 10; ++i) { 
       int item = rand() % 15;
       printf("%3d", item);
+#ifdef BALANCED_TREE
+      if (!insertNodeBalanced(&rootPtr, item)) {
+         printf("%s", "dup");
+      }
+#else
       insertNode(&rootPtr, item);
+#endif
    } 
 
    // traverse the tree preOrder
@@ -47,14 +70,19 @@ int main(void)
    // traverse the tree postOrder
    puts("\n\nThe postOrder traversal is:");
    postOrder(rootPtr);
+
+#ifdef USE_NODE_POOL
+   releaseNodePool(&treeNodePool); // free the whole tree at once
+#endif
 } 
 
+#ifndef BALANCED_TREE
 // insert node into tree
 void insertNode(TreeNodePtr *treePtr, int value)
 { 
    // if tree is empty
    if (*treePtr == NULL) {   
-      *treePtr = malloc(sizeof(TreeNode));
+      *treePtr = NEW_NODE();
 
       // if memory was allocated, then assign data
       if (*treePtr != NULL) { 
@@ -114,6 +142,7 @@ void postOrder(TreeNodePtr treePtr)
       printf("%3d", treePtr->data);      
    }                           
 } 
+#endif
 
 
 
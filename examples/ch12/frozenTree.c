@@ -0,0 +1,142 @@
+// frozenTree.c
+// Frozen (Eytzinger layout) tree function definitions.
+// NOTE: programs using these functions must also be compiled with
+// binaryTree.c
+#include <stdlib.h>
+#include "frozenTree.h" // include definition of FrozenTree
+
+#define CACHE_LINE_BYTES 64
+
+// with 16 ints per cache line, the descendants of keys[k] four levels down
+// are keys[16k] .. keys[16k + 15], one line that can be fetched early
+#define PREFETCH_DISTANCE 16
+
+#ifdef __GNUC__
+#define PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PREFETCH(address)
+#endif
+
+// index of the key where a search that ended at index k last went left
+static size_t lastLeftTurn(size_t k)
+{
+   // the trailing 1 bits of k are the right steps taken after that key,
+   // and the 0 bit just above them is the left step itself
+#ifdef __GNUC__
+   return k >> __builtin_ffsll((long long) ~k);
+#else
+   while (k & 1) {
+      k >>= 1;
+   }
+
+   return k >> 1;
+#endif
+}
+
+// allocate room for count keys, starting on a cache-line boundary
+static int allocateKeys(FrozenTree *frozenPtr, size_t count)
+{
+   size_t bytes = (count + 1) * sizeof(int);
+   bytes = (bytes + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+
+   frozenPtr->keys = aligned_alloc(CACHE_LINE_BYTES, bytes);
+   frozenPtr->count = frozenPtr->keys != NULL ? count : 0;
+   return frozenPtr->keys != NULL;
+}
+
+// place sorted[*nextPtr ...] into the subtree rooted at index k; visiting
+// the implicit tree in order consumes the sorted keys in order
+static void fillInOrder(FrozenTree *frozenPtr, const int sorted[],
+   size_t *nextPtr, size_t k)
+{
+   if (k <= frozenPtr->count) {
+      fillInOrder(frozenPtr, sorted, nextPtr, 2 * k);
+      frozenPtr->keys[k] = sorted[(*nextPtr)++];
+      fillInOrder(frozenPtr, sorted, nextPtr, 2 * k + 1);
+   }
+}
+
+// O(n) bulk load from an array sorted in increasing order
+int buildFrozenTree(FrozenTree *frozenPtr, const int sorted[], size_t count)
+{
+   if (!allocateKeys(frozenPtr, count)) {
+      return 0;
+   }
+
+   size_t next = 0;
+   fillInOrder(frozenPtr, sorted, &next, 1);
+   return 1;
+}
+
+// growable array the in-order traversal appends to
+struct keyBuffer {
+   int *keys;
+   size_t count;
+   size_t capacity;
+   int outOfMemory;
+};
+
+// TreeVisitor that appends a value to a keyBuffer
+static void appendKey(int value, void *contextPtr)
+{
+   struct keyBuffer *bufferPtr = contextPtr;
+
+   if (bufferPtr->count == bufferPtr->capacity && !bufferPtr->outOfMemory) {
+      size_t newCapacity =
+         bufferPtr->capacity == 0 ? 1024 : 2 * bufferPtr->capacity;
+      int *newKeys = realloc(bufferPtr->keys, newCapacity * sizeof(int));
+
+      if (newKeys == NULL) {
+         bufferPtr->outOfMemory = 1;
+      }
+      else {
+         bufferPtr->keys = newKeys;
+         bufferPtr->capacity = newCapacity;
+      }
+   }
+
+   if (!bufferPtr->outOfMemory) {
+      bufferPtr->keys[bufferPtr->count++] = value;
+   }
+}
+
+// copy a pointer tree into the frozen layout; the tree itself is unchanged
+int freezeTree(FrozenTree *frozenPtr, TreeNodePtr treePtr)
+{
+   struct keyBuffer buffer = { NULL, 0, 0, 0 };
+
+   int built = inOrderVisit(treePtr, appendKey, &buffer) &&
+      !buffer.outOfMemory &&
+      buildFrozenTree(frozenPtr, buffer.keys, buffer.count);
+
+   free(buffer.keys);
+   return built;
+}
+
+// return 1 if value is in the frozen tree, 0 otherwise. The loop has no
+// data-dependent branch: each step moves to child 2k or 2k + 1 by adding the
+// comparison result, while the line four levels below is prefetched.
+int searchFrozenTree(const FrozenTree *frozenPtr, int value)
+{
+   const int *keys = frozenPtr->keys;
+   size_t count = frozenPtr->count;
+   size_t k = 1;
+
+   while (k <= count) {
+      PREFETCH(keys + PREFETCH_DISTANCE * k);
+      k = 2 * k + (keys[k] < value);
+   }
+
+   // the first key >= value is where the search last went left
+   k = lastLeftTurn(k);
+
+   return k != 0 && keys[k] == value;
+}
+
+// release the key array
+void freeFrozenTree(FrozenTree *frozenPtr)
+{
+   free(frozenPtr->keys);
+   frozenPtr->keys = NULL;
+   frozenPtr->count = 0;
+}
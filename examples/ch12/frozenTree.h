@@ -0,0 +1,29 @@
+// frozenTree.h
+// Read-only search layout for a finished binary search tree. The keys are
+// stored in one contiguous array in breadth-first (Eytzinger) order, so a
+// lookup walks array indexes 1, 2 or 3, 4 to 7, ... instead of chasing
+// leftPtr/rightPtr, and the next levels can be prefetched.
+// Frozen tree functions are defined in frozenTree.c
+
+// prevent multiple inclusions of header
+#ifndef FROZENTREE_H
+#define FROZENTREE_H
+
+#include <stddef.h>
+#include "binaryTree.h" // include definition of TreeNode from binaryTree.h
+
+// keys[1] is the root and the children of keys[k] are keys[2k], keys[2k+1]
+struct frozenTree {
+   int *keys; // count + 1 entries, cache-line aligned; keys[0] is unused
+   size_t count; // number of keys
+};
+
+typedef struct frozenTree FrozenTree; // synonym for struct frozenTree
+
+// prototypes; the build functions return 0 if no memory is available
+int freezeTree(FrozenTree *frozenPtr, TreeNodePtr treePtr);
+int buildFrozenTree(FrozenTree *frozenPtr, const int sorted[], size_t count);
+int searchFrozenTree(const FrozenTree *frozenPtr, int value);
+void freeFrozenTree(FrozenTree *frozenPtr);
+
+#endif
@@ -0,0 +1,230 @@
+// lockFreeQueue.c
+// Michael-Scott lock-free queue function definitions.
+// A dequeued dummy node is not freed right away because another thread may
+// still be reading it. Each thread announces the nodes it is about to read
+// in its hazard pointers, and retired nodes are freed only once no hazard
+// pointer refers to them.
+#include <stdlib.h>
+#include "lockFreeQueue.h" // include definition of LockFreeQueue
+
+// create the dummy node; returns 0 if no memory is available
+int initLockFreeQueue(LockFreeQueue *queuePtr)
+{
+   LockFreeQueueNode *dummyPtr = malloc(sizeof(LockFreeQueueNode));
+
+   if (dummyPtr == NULL) {
+      return 0;
+   }
+
+   atomic_init(&dummyPtr->nextPtr, NULL);
+   atomic_init(&queuePtr->headPtr, dummyPtr);
+   atomic_init(&queuePtr->tailPtr, dummyPtr);
+
+   for (size_t i = 0; i < MAX_QUEUE_THREADS; ++i) {
+      for (size_t h = 0; h < HAZARDS_PER_THREAD; ++h) {
+         atomic_init(&queuePtr->records[i].hazards[h], NULL);
+      }
+
+      queuePtr->records[i].retiredCount = 0;
+   }
+
+   return 1;
+}
+
+// publish nodePtr in hazard slot h of the calling thread
+static void setHazard(struct hazardRecord *recordPtr, size_t h,
+   LockFreeQueueNode *nodePtr)
+{
+   atomic_store(&recordPtr->hazards[h], nodePtr);
+}
+
+// return 1 if any thread's hazard pointer refers to nodePtr
+static int isHazard(LockFreeQueue *queuePtr, LockFreeQueueNode *nodePtr)
+{
+   for (size_t i = 0; i < MAX_QUEUE_THREADS; ++i) {
+      for (size_t h = 0; h < HAZARDS_PER_THREAD; ++h) {
+         if (atomic_load(&queuePtr->records[i].hazards[h]) == nodePtr) {
+            return 1;
+         }
+      }
+   }
+
+   return 0;
+}
+
+// free every retired node that no thread is reading
+static void scanRetired(LockFreeQueue *queuePtr,
+   struct hazardRecord *recordPtr)
+{
+   size_t kept = 0;
+
+   for (size_t i = 0; i < recordPtr->retiredCount; ++i) {
+      LockFreeQueueNode *nodePtr = recordPtr->retired[i];
+
+      if (isHazard(queuePtr, nodePtr)) {
+         recordPtr->retired[kept++] = nodePtr; // still in use, try later
+      }
+      else {
+         free(nodePtr);
+      }
+   }
+
+   recordPtr->retiredCount = kept;
+}
+
+// hand a removed node to the reclaimer
+static void retireNode(LockFreeQueue *queuePtr,
+   struct hazardRecord *recordPtr, LockFreeQueueNode *nodePtr)
+{
+   recordPtr->retired[recordPtr->retiredCount++] = nodePtr;
+
+   if (recordPtr->retiredCount == RETIRE_THRESHOLD) {
+      scanRetired(queuePtr, recordPtr);
+   }
+}
+
+// insert a node at queue tail; returns 0 if no memory is available
+int enqueueLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex,
+   int value)
+{
+   struct hazardRecord *recordPtr = &queuePtr->records[threadIndex];
+   LockFreeQueueNode *newPtr = malloc(sizeof(LockFreeQueueNode));
+
+   if (newPtr == NULL) {
+      return 0;
+   }
+
+   newPtr->data = value;
+   atomic_init(&newPtr->nextPtr, NULL);
+
+   for (;;) {
+      LockFreeQueueNode *tailPtr = atomic_load(&queuePtr->tailPtr);
+      setHazard(recordPtr, 0, tailPtr);
+
+      // tailPtr may have been retired before the hazard became visible
+      if (tailPtr != atomic_load(&queuePtr->tailPtr)) {
+         continue;
+      }
+
+      LockFreeQueueNode *nextPtr = atomic_load(&tailPtr->nextPtr);
+
+      if (nextPtr != NULL) {
+         // tail is lagging behind; help the other enqueuer finish
+         atomic_compare_exchange_weak(&queuePtr->tailPtr, &tailPtr, nextPtr);
+         continue;
+      }
+
+      // link the new node after the last node, then swing the tail to it
+      if (atomic_compare_exchange_weak(&tailPtr->nextPtr, &nextPtr,
+         newPtr)) {
+         atomic_compare_exchange_strong(&queuePtr->tailPtr, &tailPtr,
+            newPtr);
+         break;
+      }
+   }
+
+   setHazard(recordPtr, 0, NULL);
+   return 1;
+}
+
+// remove a value from queue head; returns 0 if the queue is empty
+int dequeueLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex,
+   int *valuePtr)
+{
+   struct hazardRecord *recordPtr = &queuePtr->records[threadIndex];
+   LockFreeQueueNode *headPtr;
+   int found = 0;
+
+   for (;;) {
+      headPtr = atomic_load(&queuePtr->headPtr);
+      setHazard(recordPtr, 0, headPtr);
+
+      if (headPtr != atomic_load(&queuePtr->headPtr)) {
+         continue;
+      }
+
+      LockFreeQueueNode *tailPtr = atomic_load(&queuePtr->tailPtr);
+      LockFreeQueueNode *nextPtr = atomic_load(&headPtr->nextPtr);
+      setHazard(recordPtr, 1, nextPtr);
+
+      // nextPtr is only safe to read if head has not moved since
+      if (headPtr != atomic_load(&queuePtr->headPtr)) {
+         continue;
+      }
+
+      if (nextPtr == NULL) {
+         break; // queue is empty
+      }
+
+      if (headPtr == tailPtr) {
+         // tail is lagging behind the node being dequeued; help it along
+         atomic_compare_exchange_weak(&queuePtr->tailPtr, &tailPtr, nextPtr);
+         continue;
+      }
+
+      int value = nextPtr->data;
+
+      // the successor becomes the new dummy node
+      if (atomic_compare_exchange_weak(&queuePtr->headPtr, &headPtr,
+         nextPtr)) {
+         *valuePtr = value;
+         found = 1;
+         break;
+      }
+   }
+
+   setHazard(recordPtr, 0, NULL);
+   setHazard(recordPtr, 1, NULL);
+
+   if (found) {
+      retireNode(queuePtr, recordPtr, headPtr);
+   }
+
+   return found;
+}
+
+// return 1 if the queue is empty, 0 otherwise (a snapshot under concurrency)
+int isEmptyLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex)
+{
+   struct hazardRecord *recordPtr = &queuePtr->records[threadIndex];
+   LockFreeQueueNode *headPtr;
+
+   for (;;) {
+      headPtr = atomic_load(&queuePtr->headPtr);
+      setHazard(recordPtr, 0, headPtr);
+
+      // headPtr may have been retired before the hazard became visible
+      if (headPtr == atomic_load(&queuePtr->headPtr)) {
+         break;
+      }
+   }
+
+   int empty = atomic_load(&headPtr->nextPtr) == NULL;
+   setHazard(recordPtr, 0, NULL);
+   return empty;
+}
+
+// free every node; no other thread may be using the queue
+void destroyLockFreeQueue(LockFreeQueue *queuePtr)
+{
+   for (size_t i = 0; i < MAX_QUEUE_THREADS; ++i) {
+      struct hazardRecord *recordPtr = &queuePtr->records[i];
+
+      for (size_t r = 0; r < recordPtr->retiredCount; ++r) {
+         free(recordPtr->retired[r]);
+      }
+
+      recordPtr->retiredCount = 0;
+   }
+
+   LockFreeQueueNode *currentPtr = atomic_load(&queuePtr->headPtr);
+
+   while (currentPtr != NULL) {
+      LockFreeQueueNode *nextPtr = atomic_load(&currentPtr->nextPtr);
+      free(currentPtr);
+      currentPtr = nextPtr;
+   }
+
+   atomic_store(&queuePtr->headPtr, NULL);
+   atomic_store(&queuePtr->tailPtr, NULL);
+}
@@ -0,0 +1,58 @@
+// lockFreeQueue.h
+// Multi-producer/multi-consumer lock-free queue (Michael-Scott algorithm)
+// for sharing the fig12_13 queue between threads. Dequeued nodes are
+// reclaimed with hazard pointers.
+// Queue functions are defined in lockFreeQueue.c
+
+// prevent multiple inclusions of header
+#ifndef LOCKFREEQUEUE_H
+#define LOCKFREEQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define MAX_QUEUE_THREADS 64 // threads that may use one queue at a time
+#define HAZARDS_PER_THREAD 2 // dequeue protects head and head->nextPtr
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// retired nodes are scanned once a thread has this many of them
+#define RETIRE_THRESHOLD (2 * MAX_QUEUE_THREADS * HAZARDS_PER_THREAD)
+
+// self-referential structure; nextPtr is changed with compare-and-swap
+struct lockFreeQueueNode {
+   int data; // each node contains an int
+   _Atomic(struct lockFreeQueueNode *) nextPtr; // next node in queue
+};
+
+typedef struct lockFreeQueueNode LockFreeQueueNode;
+
+// per-thread reclamation state, padded so threads do not share cache lines
+struct hazardRecord {
+   _Alignas(CACHE_LINE_SIZE)
+   _Atomic(LockFreeQueueNode *) hazards[HAZARDS_PER_THREAD];
+   LockFreeQueueNode *retired[RETIRE_THRESHOLD]; // owned by one thread
+   size_t retiredCount;
+};
+
+// headPtr always points to a dummy node; the first value is in its successor
+struct lockFreeQueue {
+   _Alignas(CACHE_LINE_SIZE) _Atomic(LockFreeQueueNode *) headPtr;
+   _Alignas(CACHE_LINE_SIZE) _Atomic(LockFreeQueueNode *) tailPtr;
+   struct hazardRecord records[MAX_QUEUE_THREADS];
+};
+
+typedef struct lockFreeQueue LockFreeQueue;
+
+// prototypes; threadIndex identifies the calling thread, from 0 to
+// MAX_QUEUE_THREADS - 1, and must not be used by two threads at once
+int initLockFreeQueue(LockFreeQueue *queuePtr);
+int enqueueLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex,
+   int value);
+int dequeueLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex,
+   int *valuePtr);
+int isEmptyLockFree(LockFreeQueue *queuePtr, unsigned int threadIndex);
+void destroyLockFreeQueue(LockFreeQueue *queuePtr);
+
+#endif
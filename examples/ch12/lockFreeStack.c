@@ -0,0 +1,157 @@
+// lockFreeStack.c
+// Treiber stack function definitions.
+// Nodes are never returned to malloc while the stack exists; a popped node
+// goes onto a second Treiber stack of free nodes. Reading nextIndex from a
+// node that another thread has just reused is harmless, because the tag
+// in the top word has changed and the compare-and-swap will fail.
+#include <stdlib.h>
+#include "lockFreeStack.h" // include definition of LockFreeStack
+
+// combine a tag and a node number (index + 1, 0 for none)
+static TaggedIndex makeTagged(uint64_t tag, uint32_t nodeNumber)
+{
+   return tag << 32 | nodeNumber;
+}
+
+// node number stored in a tagged top
+static uint32_t nodeNumberOf(TaggedIndex tagged)
+{
+   return (uint32_t) tagged;
+}
+
+// pop one node number from a tagged stack, 0 if it is empty
+static uint32_t popNode(LockFreeStack *stackPtr, _Atomic TaggedIndex *topPtr)
+{
+   TaggedIndex oldTop = atomic_load(topPtr);
+   TaggedIndex newTop;
+   uint32_t number;
+
+   do {
+      number = nodeNumberOf(oldTop);
+
+      if (number == 0) {
+         return 0;
+      }
+
+      uint32_t below = atomic_load_explicit(
+         &stackPtr->nodes[number - 1].nextIndex, memory_order_relaxed);
+      newTop = makeTagged((oldTop >> 32) + 1, below);
+   } while (!atomic_compare_exchange_weak(topPtr, &oldTop, newTop));
+
+   return number;
+}
+
+// push the already linked chain first..last onto a tagged stack
+static void pushChain(LockFreeStack *stackPtr, _Atomic TaggedIndex *topPtr,
+   uint32_t first, uint32_t last)
+{
+   TaggedIndex oldTop = atomic_load(topPtr);
+   TaggedIndex newTop;
+
+   do {
+      atomic_store_explicit(&stackPtr->nodes[last - 1].nextIndex,
+         nodeNumberOf(oldTop), memory_order_relaxed);
+      newTop = makeTagged((oldTop >> 32) + 1, first);
+   } while (!atomic_compare_exchange_weak(topPtr, &oldTop, newTop));
+}
+
+// allocate capacity nodes, all free; returns 0 if no memory is available
+int initLockFreeStack(LockFreeStack *stackPtr, size_t capacity)
+{
+   if (capacity == 0 || capacity >= UINT32_MAX) {
+      return 0;
+   }
+
+   stackPtr->nodes = malloc(capacity * sizeof(LockFreeStackNode));
+
+   if (stackPtr->nodes == NULL) {
+      return 0;
+   }
+
+   // chain every node into the free stack: node i + 1 lies below node i
+   for (size_t i = 0; i < capacity; ++i) {
+      uint32_t below = i + 1 < capacity ? (uint32_t) (i + 2) : 0;
+      atomic_init(&stackPtr->nodes[i].nextIndex, below);
+   }
+
+   stackPtr->capacity = capacity;
+   atomic_init(&stackPtr->top, makeTagged(0, 0));
+   atomic_init(&stackPtr->freeTop, makeTagged(0, 1));
+   return 1;
+}
+
+// insert a value at the stack top; returns 0 if every node is in use
+int pushLockFree(LockFreeStack *stackPtr, int info)
+{
+   uint32_t number = popNode(stackPtr, &stackPtr->freeTop);
+
+   if (number == 0) {
+      return 0;
+   }
+
+   stackPtr->nodes[number - 1].data = info;
+   pushChain(stackPtr, &stackPtr->top, number, number);
+   return 1;
+}
+
+// remove a value from the stack top; returns 0 if the stack is empty
+int popLockFree(LockFreeStack *stackPtr, int *valuePtr)
+{
+   uint32_t number = popNode(stackPtr, &stackPtr->top);
+
+   if (number == 0) {
+      return 0;
+   }
+
+   *valuePtr = stackPtr->nodes[number - 1].data;
+   pushChain(stackPtr, &stackPtr->freeTop, number, number);
+   return 1;
+}
+
+// detach the whole stack with one exchange, pass each value to process from
+// top to bottom, and return all the nodes to the free stack with one
+// compare-and-swap; returns the number of values processed
+size_t popAllLockFree(LockFreeStack *stackPtr,
+   void (*process)(int value, void *contextPtr), void *contextPtr)
+{
+   TaggedIndex oldTop = atomic_load(&stackPtr->top);
+
+   // swap in an empty top, keeping the tag moving forward
+   while (nodeNumberOf(oldTop) != 0 &&
+      !atomic_compare_exchange_weak(&stackPtr->top, &oldTop,
+         makeTagged((oldTop >> 32) + 1, 0))) {
+   }
+
+   uint32_t first = nodeNumberOf(oldTop);
+   uint32_t last = first;
+   size_t count = 0;
+
+   // the detached chain now belongs to this thread alone
+   for (uint32_t number = first; number != 0;
+      number = atomic_load_explicit(&stackPtr->nodes[number - 1].nextIndex,
+         memory_order_relaxed)) {
+      process(stackPtr->nodes[number - 1].data, contextPtr);
+      last = number;
+      ++count;
+   }
+
+   if (first != 0) {
+      pushChain(stackPtr, &stackPtr->freeTop, first, last);
+   }
+
+   return count;
+}
+
+// return 1 if the stack is empty, 0 otherwise (a snapshot under concurrency)
+int isEmptyStackLockFree(LockFreeStack *stackPtr)
+{
+   return nodeNumberOf(atomic_load(&stackPtr->top)) == 0;
+}
+
+// free the node array; no other thread may be using the stack
+void destroyLockFreeStack(LockFreeStack *stackPtr)
+{
+   free(stackPtr->nodes);
+   stackPtr->nodes = NULL;
+   stackPtr->capacity = 0;
+}
@@ -0,0 +1,51 @@
+// lockFreeStack.h
+// Lock-free (Treiber) stack for sharing the fig12_08 stack between threads.
+// Nodes live in one array and are named by index, so the top of the stack
+// fits in 64 bits together with a tag that changes on every update. A
+// compare-and-swap therefore fails if the top was popped and pushed back in
+// between (the ABA problem).
+// Stack functions are defined in lockFreeStack.c
+
+// prevent multiple inclusions of header
+#ifndef LOCKFREESTACK_H
+#define LOCKFREESTACK_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// stack node; nextIndex is 0 at the bottom, otherwise index + 1
+struct lockFreeStackNode {
+   int data; // define data as an int
+   _Atomic uint32_t nextIndex; // node below this one
+};
+
+typedef struct lockFreeStackNode LockFreeStackNode;
+
+// a tagged top: the high 32 bits count updates, the low 32 bits hold
+// index + 1 of the top node (0 when empty)
+typedef uint64_t TaggedIndex;
+
+struct lockFreeStack {
+   _Alignas(CACHE_LINE_SIZE) _Atomic TaggedIndex top; // values
+   _Alignas(CACHE_LINE_SIZE) _Atomic TaggedIndex freeTop; // unused nodes
+   LockFreeStackNode *nodes; // capacity nodes
+   size_t capacity;
+};
+
+typedef struct lockFreeStack LockFreeStack;
+
+// prototypes
+int initLockFreeStack(LockFreeStack *stackPtr, size_t capacity);
+int pushLockFree(LockFreeStack *stackPtr, int info);
+int popLockFree(LockFreeStack *stackPtr, int *valuePtr);
+size_t popAllLockFree(LockFreeStack *stackPtr,
+   void (*process)(int value, void *contextPtr), void *contextPtr);
+int isEmptyStackLockFree(LockFreeStack *stackPtr);
+void destroyLockFreeStack(LockFreeStack *stackPtr);
+
+#endif
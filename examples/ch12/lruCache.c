@@ -0,0 +1,244 @@
+// lruCache.c
+// LRU cache function definitions.
+// The hash table keeps at most half of its slots full. A removed key's
+// slot is refilled by shifting later entries of the same probe run back,
+// so lookups never have to skip deleted markers.
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "lruCache.h" // include definition of LruCache
+
+// allocate the entries and a table of at least twice as many slots;
+// returns 0 if no memory is available
+int initLruCache(LruCache *cachePtr, size_t capacity)
+{
+   size_t tableSize = 2;
+
+   if (capacity < 1) {
+      capacity = 1;
+   }
+
+   while (tableSize < 2 * capacity) {
+      tableSize *= 2;
+   }
+
+   cachePtr->entries = malloc(capacity * sizeof(LruEntry));
+   cachePtr->table = calloc(tableSize, sizeof(LruEntry *));
+   cachePtr->tableMask = tableSize - 1;
+   cachePtr->capacity = capacity;
+   cachePtr->count = 0;
+   cachePtr->headPtr = NULL;
+   cachePtr->tailPtr = NULL;
+   cachePtr->hits = 0;
+   cachePtr->misses = 0;
+   cachePtr->evictions = 0;
+
+   if (cachePtr->entries == NULL || cachePtr->table == NULL) {
+      destroyLruCache(cachePtr);
+      return 0;
+   }
+
+   return 1;
+}
+
+// home slot of key (Fibonacci hashing)
+static size_t homeSlot(const LruCache *cachePtr, int key)
+{
+   uint64_t hash = (uint32_t) key * UINT64_C(0x9E3779B97F4A7C15);
+   return (size_t) (hash >> 32) & cachePtr->tableMask;
+}
+
+// slot holding key, or the empty slot where it would go
+static size_t findSlot(const LruCache *cachePtr, int key)
+{
+   size_t slot = homeSlot(cachePtr, key);
+
+   while (cachePtr->table[slot] != NULL && cachePtr->table[slot]->key != key) {
+      slot = (slot + 1) & cachePtr->tableMask;
+   }
+
+   return slot;
+}
+
+// empty a slot and move later entries of its probe run back into the gap
+static void clearSlot(LruCache *cachePtr, size_t slot)
+{
+   size_t mask = cachePtr->tableMask;
+   size_t next = (slot + 1) & mask;
+
+   cachePtr->table[slot] = NULL;
+
+   while (cachePtr->table[next] != NULL) {
+      size_t home = homeSlot(cachePtr, cachePtr->table[next]->key);
+
+      // the entry may move into the gap unless its home lies after the
+      // gap (cyclically) and at or before the entry's own slot
+      if (((next - home) & mask) >= ((next - slot) & mask)) {
+         cachePtr->table[slot] = cachePtr->table[next];
+         cachePtr->table[next] = NULL;
+         slot = next;
+      }
+
+      next = (next + 1) & mask;
+   }
+}
+
+// take an entry off the recency list
+static void unlinkEntry(LruCache *cachePtr, LruEntry *entryPtr)
+{
+   if (entryPtr->prevPtr == NULL) {
+      cachePtr->headPtr = entryPtr->nextPtr;
+   }
+   else {
+      entryPtr->prevPtr->nextPtr = entryPtr->nextPtr;
+   }
+
+   if (entryPtr->nextPtr == NULL) {
+      cachePtr->tailPtr = entryPtr->prevPtr;
+   }
+   else {
+      entryPtr->nextPtr->prevPtr = entryPtr->prevPtr;
+   }
+}
+
+// put an entry at the front of the recency list
+static void pushFront(LruCache *cachePtr, LruEntry *entryPtr)
+{
+   entryPtr->prevPtr = NULL;
+   entryPtr->nextPtr = cachePtr->headPtr;
+
+   if (cachePtr->headPtr == NULL) {
+      cachePtr->tailPtr = entryPtr;
+   }
+   else {
+      cachePtr->headPtr->prevPtr = entryPtr;
+   }
+
+   cachePtr->headPtr = entryPtr;
+}
+
+// look up key; on a hit store its value, mark it most recently used and
+// return 1, otherwise return 0
+int getLru(LruCache *cachePtr, int key, int *valuePtr)
+{
+   LruEntry *entryPtr = cachePtr->table[findSlot(cachePtr, key)];
+
+   if (entryPtr == NULL) {
+      ++cachePtr->misses;
+      return 0;
+   }
+
+   ++cachePtr->hits;
+   *valuePtr = entryPtr->value;
+
+   if (entryPtr != cachePtr->headPtr) {
+      unlinkEntry(cachePtr, entryPtr);
+      pushFront(cachePtr, entryPtr);
+   }
+
+   return 1;
+}
+
+// add or update key as the most recently used entry; returns 1 if the
+// least recently used entry was evicted to make room
+int putLru(LruCache *cachePtr, int key, int value)
+{
+   size_t slot = findSlot(cachePtr, key);
+   LruEntry *entryPtr = cachePtr->table[slot];
+   int evicted = 0;
+
+   if (entryPtr != NULL) { // update in place
+      entryPtr->value = value;
+      unlinkEntry(cachePtr, entryPtr);
+   }
+   else {
+      if (cachePtr->count < cachePtr->capacity) {
+         entryPtr = &cachePtr->entries[cachePtr->count++];
+      }
+      else { // reuse the least recently used entry
+         entryPtr = cachePtr->tailPtr;
+         unlinkEntry(cachePtr, entryPtr);
+         clearSlot(cachePtr, findSlot(cachePtr, entryPtr->key));
+         slot = findSlot(cachePtr, key); // the clear may have moved it
+         ++cachePtr->evictions;
+         evicted = 1;
+      }
+
+      entryPtr->key = key;
+      entryPtr->value = value;
+      cachePtr->table[slot] = entryPtr;
+   }
+
+   pushFront(cachePtr, entryPtr);
+   return evicted;
+}
+
+// remove key from the cache; returns 1 if it was cached
+int removeLru(LruCache *cachePtr, int key)
+{
+   size_t slot = findSlot(cachePtr, key);
+   LruEntry *entryPtr = cachePtr->table[slot];
+
+   if (entryPtr == NULL) {
+      return 0;
+   }
+
+   unlinkEntry(cachePtr, entryPtr);
+   clearSlot(cachePtr, slot);
+
+   // keep entries[0 .. count - 1] in use by moving the last one into the
+   // freed entry
+   LruEntry *lastPtr = &cachePtr->entries[--cachePtr->count];
+
+   if (lastPtr != entryPtr) {
+      *entryPtr = *lastPtr;
+      cachePtr->table[findSlot(cachePtr, lastPtr->key)] = entryPtr;
+
+      if (entryPtr->prevPtr == NULL) {
+         cachePtr->headPtr = entryPtr;
+      }
+      else {
+         entryPtr->prevPtr->nextPtr = entryPtr;
+      }
+
+      if (entryPtr->nextPtr == NULL) {
+         cachePtr->tailPtr = entryPtr;
+      }
+      else {
+         entryPtr->nextPtr->prevPtr = entryPtr;
+      }
+   }
+
+   return 1;
+}
+
+// print the entries from most to least recently used
+void printLru(const LruCache *cachePtr)
+{
+   // if cache is empty
+   if (cachePtr->headPtr == NULL) {
+      puts("Cache is empty.\n");
+   }
+   else {
+      puts("The cache is:");
+
+      for (const LruEntry *entryPtr = cachePtr->headPtr; entryPtr != NULL;
+         entryPtr = entryPtr->nextPtr) {
+         printf("%d=%d --> ", entryPtr->key, entryPtr->value);
+      }
+
+      puts("NULL\n");
+   }
+}
+
+// free the entries and the table
+void destroyLruCache(LruCache *cachePtr)
+{
+   free(cachePtr->entries);
+   free(cachePtr->table);
+   cachePtr->entries = NULL;
+   cachePtr->table = NULL;
+   cachePtr->count = 0;
+   cachePtr->headPtr = NULL;
+   cachePtr->tailPtr = NULL;
+}
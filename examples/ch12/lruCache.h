@@ -0,0 +1,49 @@
+// lruCache.h
+// Fixed-capacity cache that evicts the least recently used entry. The
+// fig12_03 list cannot unlink a node without walking to it, so entries
+// here are kept on an intrusive doubly linked list in order of use and
+// are found through an open-addressing hash table; get, put and evict
+// all take O(1) time.
+// Cache functions are defined in lruCache.c
+
+// prevent multiple inclusions of header
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <stddef.h>
+
+// cache entry; the links are part of the entry, so moving an entry to the
+// front of the list allocates nothing
+struct lruEntry {
+   int key;
+   int value;
+   struct lruEntry *prevPtr; // more recently used entry
+   struct lruEntry *nextPtr; // less recently used entry
+};
+
+typedef struct lruEntry LruEntry; // synonym for struct lruEntry
+
+struct lruCache {
+   LruEntry *entries; // capacity entries, allocated once
+   LruEntry **table; // linear-probing hash table, NULL slots are empty
+   size_t tableMask; // table size - 1, a power of two
+   size_t capacity; // entries the cache may hold
+   size_t count; // entries in use
+   LruEntry *headPtr; // most recently used entry
+   LruEntry *tailPtr; // least recently used entry, evicted first
+   size_t hits; // get found the key
+   size_t misses; // get did not find the key
+   size_t evictions; // put removed the least recently used entry
+};
+
+typedef struct lruCache LruCache; // synonym for struct lruCache
+
+// prototypes
+int initLruCache(LruCache *cachePtr, size_t capacity);
+int getLru(LruCache *cachePtr, int key, int *valuePtr);
+int putLru(LruCache *cachePtr, int key, int value);
+int removeLru(LruCache *cachePtr, int key);
+void printLru(const LruCache *cachePtr);
+void destroyLruCache(LruCache *cachePtr);
+
+#endif
@@ -0,0 +1,104 @@
+// nodePool.c
+// Fixed-size node pool function definitions.
+// Nodes are carved out of large slabs instead of one malloc per node, freed
+// nodes go on an intrusive free list, and releaseNodePool returns every node
+// at once by freeing whole slabs.
+#include <stdlib.h>
+#include "nodePool.h" // include definition of NodePool from nodePool.h
+
+// round size up to the next multiple of alignment
+static size_t roundUp(size_t size, size_t alignment)
+{
+   return (size + alignment - 1) / alignment * alignment;
+}
+
+// fill in the sizes of a pool; nodesPerSlab of 0 selects the default
+void initNodePool(NodePool *poolPtr, size_t nodeSize, size_t nodesPerSlab)
+{
+   poolPtr->nodeSize = nodeSize;
+   poolPtr->nodesPerSlab = nodesPerSlab;
+   poolPtr->slabPtr = NULL;
+   poolPtr->freePtr = NULL;
+   poolPtr->nextUnusedPtr = NULL;
+   poolPtr->slabEndPtr = NULL;
+}
+
+// allocate a new slab and make it the source of never-used nodes
+static int growNodePool(NodePool *poolPtr)
+{
+   // a free node must be able to hold its link, and every node must stay
+   // aligned for any type that may be stored in it
+   if (poolPtr->nodeSize < sizeof(struct freeNode)) {
+      poolPtr->nodeSize = sizeof(struct freeNode);
+   }
+
+   poolPtr->nodeSize = roundUp(poolPtr->nodeSize, _Alignof(max_align_t));
+
+   if (poolPtr->nodesPerSlab == 0) {
+      poolPtr->nodesPerSlab = DEFAULT_NODES_PER_SLAB;
+   }
+
+   size_t headerSize = roundUp(sizeof(struct slab), _Alignof(max_align_t));
+   struct slab *newSlabPtr =
+      malloc(headerSize + poolPtr->nodeSize * poolPtr->nodesPerSlab);
+
+   if (newSlabPtr == NULL) {
+      return 0;
+   }
+
+   newSlabPtr->nextPtr = poolPtr->slabPtr;
+   poolPtr->slabPtr = newSlabPtr;
+   poolPtr->nextUnusedPtr = (char *) newSlabPtr + headerSize;
+   poolPtr->slabEndPtr =
+      poolPtr->nextUnusedPtr + poolPtr->nodeSize * poolPtr->nodesPerSlab;
+   return 1;
+}
+
+// return one node from the pool, or NULL if no memory is available
+void *allocNode(NodePool *poolPtr)
+{
+   // reuse a freed node first
+   if (poolPtr->freePtr != NULL) {
+      struct freeNode *nodePtr = poolPtr->freePtr;
+      poolPtr->freePtr = nodePtr->nextPtr;
+      return nodePtr;
+   }
+
+   // otherwise take the next never-used node, growing when the slab is full
+   if (poolPtr->nextUnusedPtr == poolPtr->slabEndPtr &&
+      !growNodePool(poolPtr)) {
+      return NULL;
+   }
+
+   void *nodePtr = poolPtr->nextUnusedPtr;
+   poolPtr->nextUnusedPtr += poolPtr->nodeSize;
+   return nodePtr;
+}
+
+// give a node back to the pool it came from
+void freeNode(NodePool *poolPtr, void *nodePtr)
+{
+   if (nodePtr != NULL) {
+      struct freeNode *freedPtr = nodePtr;
+      freedPtr->nextPtr = poolPtr->freePtr;
+      poolPtr->freePtr = freedPtr;
+   }
+}
+
+// free every node of the pool at once; the cost depends on the number of
+// slabs, not on the number of nodes. The pool can be used again afterwards.
+void releaseNodePool(NodePool *poolPtr)
+{
+   struct slab *currentPtr = poolPtr->slabPtr;
+
+   while (currentPtr != NULL) {
+      struct slab *nextPtr = currentPtr->nextPtr;
+      free(currentPtr);
+      currentPtr = nextPtr;
+   }
+
+   poolPtr->slabPtr = NULL;
+   poolPtr->freePtr = NULL;
+   poolPtr->nextUnusedPtr = NULL;
+   poolPtr->slabEndPtr = NULL;
+}
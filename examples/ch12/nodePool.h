@@ -0,0 +1,49 @@
+// nodePool.h
+// Fixed-size node pool for the Chapter 12 lists, stacks, queues and trees.
+// Pool functions are defined in nodePool.c
+
+// prevent multiple inclusions of header
+#ifndef NODEPOOL_H
+#define NODEPOOL_H
+
+#include <stddef.h>
+
+// nodes per slab when a pool does not ask for a specific number
+#define DEFAULT_NODES_PER_SLAB 1024
+
+// a node sitting on the free list reuses its own storage as the link
+struct freeNode {
+   struct freeNode *nextPtr; // next free node
+};
+
+// header at the start of every slab; slabs are chained for bulk release
+struct slab {
+   struct slab *nextPtr; // previously allocated slab
+};
+
+// one pool hands out nodes of a single type (a single nodeSize)
+struct nodePool {
+   size_t nodeSize; // bytes per node, rounded up on first allocation
+   size_t nodesPerSlab; // nodes carved out of each slab
+   struct slab *slabPtr; // most recently allocated slab
+   struct freeNode *freePtr; // nodes returned with freeNode
+   char *nextUnusedPtr; // next never-used node in the newest slab
+   char *slabEndPtr; // one past the last node in the newest slab
+};
+
+typedef struct nodePool NodePool; // synonym for struct nodePool
+
+// static initializer for a pool of Type nodes, e.g.
+// NodePool listPool = NODE_POOL_INITIALIZER(ListNode);
+#define NODE_POOL_INITIALIZER(Type) { sizeof(Type), 0, NULL, NULL, NULL, NULL }
+
+// typed allocation from a pool created for Type
+#define POOL_NEW(poolPtr, Type) ((Type *) allocNode(poolPtr))
+
+// prototypes
+void initNodePool(NodePool *poolPtr, size_t nodeSize, size_t nodesPerSlab);
+void *allocNode(NodePool *poolPtr);
+void freeNode(NodePool *poolPtr, void *nodePtr);
+void releaseNodePool(NodePool *poolPtr);
+
+#endif
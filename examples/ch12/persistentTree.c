@@ -0,0 +1,265 @@
+// persistentTree.c
+// Persistent binary search tree function definitions.
+// A reader takes a reference to the current root as in hazard pointers:
+// it announces the root in its slot and checks that the root has not been
+// replaced in the meantime. The writer, after publishing a new root, waits
+// until no slot announces the old root before dropping the tree's
+// reference to it, so a reader never blocks on the writer.
+#include <stdlib.h>
+#include <threads.h>
+#include "persistentTree.h" // include definition of PersistentTree
+
+// height of a possibly empty subtree
+static int heightOf(PersistentNodePtr nodePtr)
+{
+   return nodePtr == NULL ? 0 : nodePtr->height;
+}
+
+// recompute a node's height from its children
+static void updateHeight(PersistentNodePtr nodePtr)
+{
+   int leftHeight = heightOf(nodePtr->leftPtr);
+   int rightHeight = heightOf(nodePtr->rightPtr);
+   nodePtr->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+}
+
+// take one more reference to a version or subtree
+PersistentNodePtr retainVersion(PersistentNodePtr rootPtr)
+{
+   if (rootPtr != NULL) {
+      atomic_fetch_add_explicit(&rootPtr->refCount, 1, memory_order_relaxed);
+   }
+
+   return rootPtr;
+}
+
+// give back one reference; a node nothing refers to any more is freed
+// together with its references to its children
+void releaseVersion(PersistentNodePtr rootPtr)
+{
+   while (rootPtr != NULL && atomic_fetch_sub_explicit(&rootPtr->refCount,
+      1, memory_order_acq_rel) == 1) {
+      PersistentNodePtr rightPtr = rootPtr->rightPtr;
+      releaseVersion(rootPtr->leftPtr);
+      free(rootPtr);
+      rootPtr = rightPtr; // loop instead of a second recursive call
+   }
+}
+
+// create a node with one reference; NULL if no memory is available
+static PersistentNodePtr newNode(PersistentNodePtr leftPtr, int value,
+   PersistentNodePtr rightPtr)
+{
+   PersistentNodePtr newPtr = malloc(sizeof(PersistentNode));
+
+   if (newPtr != NULL) {
+      newPtr->leftPtr = leftPtr;
+      newPtr->data = value;
+      newPtr->rightPtr = rightPtr;
+      updateHeight(newPtr);
+      atomic_init(&newPtr->refCount, 1);
+   }
+
+   return newPtr;
+}
+
+// The rotations only ever move nodes that the current insert has just
+// copied, so changing them in place cannot affect a published version.
+
+// rotate the subtree at *nodePtrPtr to the right
+static void rotateRight(PersistentNodePtr *nodePtrPtr)
+{
+   PersistentNodePtr oldRootPtr = *nodePtrPtr;
+   PersistentNodePtr newRootPtr = oldRootPtr->leftPtr;
+
+   oldRootPtr->leftPtr = newRootPtr->rightPtr;
+   newRootPtr->rightPtr = oldRootPtr;
+   updateHeight(oldRootPtr);
+   updateHeight(newRootPtr);
+   *nodePtrPtr = newRootPtr;
+}
+
+// rotate the subtree at *nodePtrPtr to the left
+static void rotateLeft(PersistentNodePtr *nodePtrPtr)
+{
+   PersistentNodePtr oldRootPtr = *nodePtrPtr;
+   PersistentNodePtr newRootPtr = oldRootPtr->rightPtr;
+
+   oldRootPtr->rightPtr = newRootPtr->leftPtr;
+   newRootPtr->leftPtr = oldRootPtr;
+   updateHeight(oldRootPtr);
+   updateHeight(newRootPtr);
+   *nodePtrPtr = newRootPtr;
+}
+
+// restore the AVL property at a freshly copied node; the taller child and
+// grandchild are on the insert path, so they are fresh copies as well
+static void rebalance(PersistentNodePtr *nodePtrPtr)
+{
+   PersistentNodePtr nodePtr = *nodePtrPtr;
+   int balance = heightOf(nodePtr->leftPtr) - heightOf(nodePtr->rightPtr);
+
+   if (balance > 1) { // left side too tall
+      if (heightOf(nodePtr->leftPtr->leftPtr) <
+         heightOf(nodePtr->leftPtr->rightPtr)) {
+         rotateLeft(&nodePtr->leftPtr);
+      }
+
+      rotateRight(nodePtrPtr);
+   }
+   else if (balance < -1) { // right side too tall
+      if (heightOf(nodePtr->rightPtr->rightPtr) <
+         heightOf(nodePtr->rightPtr->leftPtr)) {
+         rotateRight(&nodePtr->rightPtr);
+      }
+
+      rotateLeft(nodePtrPtr);
+   }
+}
+
+// copy the path from nodePtr down to where value belongs and add a leaf
+// there; returns the copied subtree, or NULL if no memory is available
+static PersistentNodePtr insertCopy(PersistentNodePtr nodePtr, int value)
+{
+   if (nodePtr == NULL) {
+      return newNode(NULL, value, NULL);
+   }
+
+   PersistentNodePtr copyPtr;
+
+   if (value < nodePtr->data) {
+      PersistentNodePtr leftPtr = insertCopy(nodePtr->leftPtr, value);
+
+      if (leftPtr == NULL) {
+         return NULL;
+      }
+
+      copyPtr = newNode(leftPtr, nodePtr->data, nodePtr->rightPtr);
+
+      if (copyPtr == NULL) {
+         releaseVersion(leftPtr);
+         return NULL;
+      }
+
+      retainVersion(nodePtr->rightPtr); // now shared with the copy
+   }
+   else {
+      PersistentNodePtr rightPtr = insertCopy(nodePtr->rightPtr, value);
+
+      if (rightPtr == NULL) {
+         return NULL;
+      }
+
+      copyPtr = newNode(nodePtr->leftPtr, nodePtr->data, rightPtr);
+
+      if (copyPtr == NULL) {
+         releaseVersion(rightPtr);
+         return NULL;
+      }
+
+      retainVersion(nodePtr->leftPtr); // now shared with the copy
+   }
+
+   rebalance(&copyPtr);
+   return copyPtr;
+}
+
+// return a new version that also holds value; rootPtr stays unchanged and
+// valid. A duplicate value returns rootPtr itself with one more reference.
+// Returns NULL if no memory is available.
+PersistentNodePtr insertVersion(PersistentNodePtr rootPtr, int value)
+{
+   if (searchVersion(rootPtr, value)) {
+      return retainVersion(rootPtr);
+   }
+
+   return insertCopy(rootPtr, value);
+}
+
+// return 1 if value is in the version, 0 otherwise
+int searchVersion(PersistentNodePtr rootPtr, int value)
+{
+   while (rootPtr != NULL && rootPtr->data != value) {
+      rootPtr = value < rootPtr->data ? rootPtr->leftPtr : rootPtr->rightPtr;
+   }
+
+   return rootPtr != NULL;
+}
+
+// call visit for every value of the version in ascending order
+void inOrderVersion(PersistentNodePtr rootPtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr)
+{
+   if (rootPtr != NULL) {
+      inOrderVersion(rootPtr->leftPtr, visit, contextPtr);
+      visit(rootPtr->data, contextPtr);
+      inOrderVersion(rootPtr->rightPtr, visit, contextPtr);
+   }
+}
+
+// start with an empty tree and no readers
+void initPersistentTree(PersistentTree *treePtr)
+{
+   atomic_init(&treePtr->rootPtr, NULL);
+
+   for (size_t i = 0; i < MAX_SNAPSHOT_READERS; ++i) {
+      atomic_init(&treePtr->readers[i].hazardPtr, NULL);
+   }
+}
+
+// publish a version holding value; only one thread may insert at a time.
+// Returns 1 if inserted, 0 for a duplicate or when out of memory.
+int insertPersistent(PersistentTree *treePtr, int value)
+{
+   PersistentNodePtr oldRootPtr = atomic_load(&treePtr->rootPtr);
+
+   if (searchVersion(oldRootPtr, value)) { // duplicate data value ignored
+      return 0;
+   }
+
+   PersistentNodePtr newRootPtr = insertCopy(oldRootPtr, value);
+
+   if (newRootPtr == NULL) {
+      return 0;
+   }
+
+   atomic_store(&treePtr->rootPtr, newRootPtr);
+
+   // a reader that announced the old root may still be taking a reference
+   for (size_t i = 0; i < MAX_SNAPSHOT_READERS; ++i) {
+      while (atomic_load(&treePtr->readers[i].hazardPtr) == oldRootPtr &&
+         oldRootPtr != NULL) {
+         thrd_yield();
+      }
+   }
+
+   releaseVersion(oldRootPtr);
+   return 1;
+}
+
+// return the current version with a reference the reader must give back
+// with releaseVersion; the snapshot never changes, whatever is inserted
+PersistentNodePtr openSnapshot(PersistentTree *treePtr,
+   unsigned int readerIndex)
+{
+   struct snapshotSlot *slotPtr = &treePtr->readers[readerIndex];
+   PersistentNodePtr rootPtr;
+
+   // the announced root cannot be released once it is still current
+   do {
+      rootPtr = atomic_load(&treePtr->rootPtr);
+      atomic_store(&slotPtr->hazardPtr, rootPtr);
+   } while (rootPtr != atomic_load(&treePtr->rootPtr));
+
+   retainVersion(rootPtr);
+   atomic_store(&slotPtr->hazardPtr, NULL);
+   return rootPtr;
+}
+
+// drop the tree's reference to the current version; snapshots that are
+// still open keep their nodes alive
+void destroyPersistentTree(PersistentTree *treePtr)
+{
+   releaseVersion(atomic_load(&treePtr->rootPtr));
+   atomic_store(&treePtr->rootPtr, NULL);
+}
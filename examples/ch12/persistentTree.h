@@ -0,0 +1,69 @@
+// persistentTree.h
+// Persistent (immutable) version of the Fig. 12.19 binary search tree.
+// An insert never changes an existing node: it copies the nodes on the
+// path from the root to the new leaf and shares every other subtree with
+// the previous version, so each insert makes a new root in O(log n) time
+// and space while older roots stay valid. Threads can therefore read a
+// snapshot without locks while one writer keeps inserting. Nodes carry a
+// reference count and are freed when no version uses them any more. The
+// copies are kept AVL balanced by rotations of their own, which only move
+// nodes the current insert has already copied.
+// Tree functions are defined in persistentTree.c
+
+// prevent multiple inclusions of header
+#ifndef PERSISTENTTREE_H
+#define PERSISTENTTREE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define MAX_SNAPSHOT_READERS 64 // threads that may open snapshots at once
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// self-referential structure; fields never change once a version that
+// contains the node has been published
+struct persistentNode {
+   struct persistentNode *leftPtr; // pointer to left subtree
+   int data; // node value
+   struct persistentNode *rightPtr; // pointer to right subtree
+   int height; // levels in this subtree, 1 for a leaf
+   atomic_uint refCount; // parent nodes and roots referring to this node
+};
+
+typedef struct persistentNode PersistentNode; // synonym
+typedef PersistentNode *PersistentNodePtr; // synonym for PersistentNode*
+
+// root a reader is about to take a reference to, on its own cache line
+struct snapshotSlot {
+   _Alignas(CACHE_LINE_SIZE) _Atomic(PersistentNodePtr) hazardPtr;
+};
+
+// the current version, replaced by each insert
+struct persistentTree {
+   _Alignas(CACHE_LINE_SIZE) _Atomic(PersistentNodePtr) rootPtr;
+   struct snapshotSlot readers[MAX_SNAPSHOT_READERS];
+};
+
+typedef struct persistentTree PersistentTree; // synonym
+
+// prototypes for versions; each returned root carries one reference that
+// the caller must give back with releaseVersion
+PersistentNodePtr insertVersion(PersistentNodePtr rootPtr, int value);
+PersistentNodePtr retainVersion(PersistentNodePtr rootPtr);
+void releaseVersion(PersistentNodePtr rootPtr);
+int searchVersion(PersistentNodePtr rootPtr, int value);
+void inOrderVersion(PersistentNodePtr rootPtr,
+   void (*visit)(int value, void *contextPtr), void *contextPtr);
+
+// prototypes for a shared tree with one writer at a time; readerIndex
+// identifies the calling reader, from 0 to MAX_SNAPSHOT_READERS - 1, and
+// must not be used by two threads at once
+void initPersistentTree(PersistentTree *treePtr);
+int insertPersistent(PersistentTree *treePtr, int value);
+PersistentNodePtr openSnapshot(PersistentTree *treePtr,
+   unsigned int readerIndex);
+void destroyPersistentTree(PersistentTree *treePtr);
+
+#endif
@@ -0,0 +1,292 @@
+// priorityQueue.c
+// d-ary heap priority queue function definitions.
+// The children of heap[i] are heap[arity * i + 1] .. heap[arity * i +
+// arity]. Entries are moved by shifting the others into a hole instead
+// of swapping, and positions[] follows every move so that decreaseKey
+// can find an entry by the slot in its handle.
+#include <stdio.h>
+#include <stdlib.h>
+#include "priorityQueue.h" // include definition of PriorityQueue
+
+// allocate room for capacity entries; returns 0 if no memory is available
+int initPriorityQueue(PriorityQueue *queuePtr, unsigned int arity,
+   size_t capacity)
+{
+   if (capacity < 1) {
+      capacity = 1;
+   }
+
+   queuePtr->heap = malloc(capacity * sizeof(HeapEntry));
+   queuePtr->positions = malloc(capacity * sizeof(size_t));
+   queuePtr->generations = malloc(capacity * sizeof(size_t));
+   queuePtr->freeSlots = malloc(capacity * sizeof(size_t));
+   queuePtr->count = 0;
+   queuePtr->capacity = capacity;
+   queuePtr->arity = arity < 2 ? 2 : arity;
+   queuePtr->freeCount = 0;
+   queuePtr->slotsUsed = 0;
+
+   if (capacity > HANDLE_SLOT_MASK || queuePtr->heap == NULL ||
+      queuePtr->positions == NULL || queuePtr->generations == NULL ||
+      queuePtr->freeSlots == NULL) {
+      destroyPriorityQueue(queuePtr);
+      return 0;
+   }
+
+   return 1;
+}
+
+// double the capacity; returns 0 if no memory is available or the
+// slots would no longer fit in a handle
+static int growPriorityQueue(PriorityQueue *queuePtr)
+{
+   if (queuePtr->capacity > HANDLE_SLOT_MASK / 2) {
+      return 0;
+   }
+
+   size_t capacity = 2 * queuePtr->capacity;
+   HeapEntry *heap = realloc(queuePtr->heap, capacity * sizeof(HeapEntry));
+
+   if (heap == NULL) {
+      return 0;
+   }
+
+   queuePtr->heap = heap;
+   size_t *positions =
+      realloc(queuePtr->positions, capacity * sizeof(size_t));
+
+   if (positions == NULL) {
+      return 0;
+   }
+
+   queuePtr->positions = positions;
+   size_t *generations =
+      realloc(queuePtr->generations, capacity * sizeof(size_t));
+
+   if (generations == NULL) {
+      return 0;
+   }
+
+   queuePtr->generations = generations;
+   size_t *freeSlots =
+      realloc(queuePtr->freeSlots, capacity * sizeof(size_t));
+
+   if (freeSlots == NULL) {
+      return 0;
+   }
+
+   queuePtr->freeSlots = freeSlots;
+   queuePtr->capacity = capacity;
+   return 1;
+}
+
+// store entry at index i and record where its slot now is
+static void place(PriorityQueue *queuePtr, size_t i, HeapEntry entry)
+{
+   queuePtr->heap[i] = entry;
+   queuePtr->positions[entry.slot] = i;
+}
+
+// heap index named by handle, or NOT_QUEUED if the handle was never
+// given out or its value has since been dequeued
+static size_t positionOf(const PriorityQueue *queuePtr, size_t handle)
+{
+   size_t slot = handle & HANDLE_SLOT_MASK;
+
+   if (slot >= queuePtr->slotsUsed ||
+      queuePtr->generations[slot] != handle >> HANDLE_SLOT_BITS) {
+      return NOT_QUEUED;
+   }
+
+   return queuePtr->positions[slot];
+}
+
+// move entry up from the hole at index i past every larger parent
+static void siftUp(PriorityQueue *queuePtr, size_t i, HeapEntry entry)
+{
+   while (i > 0) {
+      size_t parent = (i - 1) / queuePtr->arity;
+
+      if (queuePtr->heap[parent].priority <= entry.priority) {
+         break;
+      }
+
+      place(queuePtr, i, queuePtr->heap[parent]);
+      i = parent;
+   }
+
+   place(queuePtr, i, entry);
+}
+
+// move entry down from the hole at index i past every smaller child
+static void siftDown(PriorityQueue *queuePtr, size_t i, HeapEntry entry)
+{
+   size_t arity = queuePtr->arity;
+
+   for (;;) {
+      size_t first = arity * i + 1;
+
+      if (first >= queuePtr->count) {
+         break;
+      }
+
+      // find the child with the smallest priority
+      size_t last = first + arity < queuePtr->count ?
+         first + arity : queuePtr->count;
+      size_t smallest = first;
+
+      for (size_t child = first + 1; child < last; ++child) {
+         if (queuePtr->heap[child].priority <
+            queuePtr->heap[smallest].priority) {
+            smallest = child;
+         }
+      }
+
+      if (queuePtr->heap[smallest].priority >= entry.priority) {
+         break;
+      }
+
+      place(queuePtr, i, queuePtr->heap[smallest]);
+      i = smallest;
+   }
+
+   place(queuePtr, i, entry);
+}
+
+// insert value with the given priority; stores its handle in *handlePtr
+// unless handlePtr is NULL. Returns 0 if no memory is available.
+int enqueuePriority(PriorityQueue *queuePtr, int value, int priority,
+   size_t *handlePtr)
+{
+   if (queuePtr->count == queuePtr->capacity &&
+      !growPriorityQueue(queuePtr)) {
+      printf("%d not inserted. No memory available.\n", value);
+      return 0;
+   }
+
+   HeapEntry entry = {priority, value, 0};
+
+   // reuse the slot of a dequeued entry if there is one
+   if (queuePtr->freeCount > 0) {
+      entry.slot = queuePtr->freeSlots[--queuePtr->freeCount];
+   }
+   else {
+      entry.slot = queuePtr->slotsUsed++;
+      queuePtr->generations[entry.slot] = 0;
+   }
+
+   siftUp(queuePtr, queuePtr->count++, entry);
+
+   if (handlePtr != NULL) {
+      *handlePtr = entry.slot |
+         queuePtr->generations[entry.slot] << HANDLE_SLOT_BITS;
+   }
+
+   return 1;
+}
+
+// remove the value with the smallest priority; returns 0 if the queue is
+// empty. priorityPtr may be NULL.
+int dequeuePriority(PriorityQueue *queuePtr, int *valuePtr,
+   int *priorityPtr)
+{
+   if (queuePtr->count == 0) {
+      return 0;
+   }
+
+   HeapEntry top = queuePtr->heap[0];
+   *valuePtr = top.data;
+
+   if (priorityPtr != NULL) {
+      *priorityPtr = top.priority;
+   }
+
+   // old handles of the slot stop matching its generation
+   queuePtr->positions[top.slot] = NOT_QUEUED;
+   queuePtr->generations[top.slot] =
+      (queuePtr->generations[top.slot] + 1) & HANDLE_SLOT_MASK;
+   queuePtr->freeSlots[queuePtr->freeCount++] = top.slot;
+
+   // the last entry fills the hole at the root
+   if (--queuePtr->count > 0) {
+      siftDown(queuePtr, 0, queuePtr->heap[queuePtr->count]);
+   }
+
+   return 1;
+}
+
+// lower the priority of a queued value; returns 0 if its value has been
+// dequeued or priority is larger than its current priority
+int decreaseKey(PriorityQueue *queuePtr, size_t handle, int priority)
+{
+   size_t i = positionOf(queuePtr, handle);
+
+   if (i == NOT_QUEUED) {
+      return 0;
+   }
+
+   HeapEntry entry = queuePtr->heap[i];
+
+   if (priority > entry.priority) {
+      return 0;
+   }
+
+   entry.priority = priority;
+   siftUp(queuePtr, i, entry);
+   return 1;
+}
+
+// store the priority of the value named by handle in *priorityPtr;
+// returns 0 if its value has been dequeued
+int queuedPriority(const PriorityQueue *queuePtr, size_t handle,
+   int *priorityPtr)
+{
+   size_t i = positionOf(queuePtr, handle);
+
+   if (i == NOT_QUEUED) {
+      return 0;
+   }
+
+   *priorityPtr = queuePtr->heap[i].priority;
+   return 1;
+}
+
+// return 1 if the queue is empty, 0 otherwise
+int isEmptyPriority(const PriorityQueue *queuePtr)
+{
+   return queuePtr->count == 0;
+}
+
+// print the queue in heap order as value(priority)
+void printPriorityQueue(const PriorityQueue *queuePtr)
+{
+   // if queue is empty
+   if (isEmptyPriority(queuePtr)) {
+      puts("Queue is empty.\n");
+   }
+   else {
+      puts("The queue is:");
+
+      for (size_t i = 0; i < queuePtr->count; ++i) {
+         printf("%d(%d) --> ", queuePtr->heap[i].data,
+            queuePtr->heap[i].priority);
+      }
+
+      puts("NULL\n");
+   }
+}
+
+// free the arrays
+void destroyPriorityQueue(PriorityQueue *queuePtr)
+{
+   free(queuePtr->heap);
+   free(queuePtr->positions);
+   free(queuePtr->generations);
+   free(queuePtr->freeSlots);
+   queuePtr->heap = NULL;
+   queuePtr->positions = NULL;
+   queuePtr->generations = NULL;
+   queuePtr->freeSlots = NULL;
+   queuePtr->count = 0;
+   queuePtr->capacity = 0;
+}
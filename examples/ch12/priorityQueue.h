@@ -0,0 +1,61 @@
+// priorityQueue.h
+// Priority-ordered variant of the Fig. 12.13 queue: dequeue returns the
+// value with the smallest priority number instead of the oldest value.
+// The queue is an array-based d-ary heap; a larger arity makes the heap
+// shallower, so enqueue and decreaseKey move values fewer levels, while
+// dequeue compares more children on each level.
+// Queue functions are defined in priorityQueue.c
+
+// prevent multiple inclusions of header
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+#include <limits.h>
+#include <stddef.h>
+
+#define NOT_QUEUED ((size_t) -1) // position of a slot not in the queue
+
+// a handle keeps its slot in the low half and the slot's generation in
+// the high half; dequeue bumps the generation, so a handle is invalid
+// once its value has been dequeued, even after the slot is reused
+#define HANDLE_SLOT_BITS (sizeof(size_t) * CHAR_BIT / 2)
+#define HANDLE_SLOT_MASK (((size_t) 1 << HANDLE_SLOT_BITS) - 1)
+
+// one queued value; slot names it for decreaseKey
+struct heapEntry {
+   int priority; // smaller numbers are dequeued first
+   int data; // each entry contains an int
+   size_t slot; // index into positions and generations
+};
+
+typedef struct heapEntry HeapEntry; // synonym for struct heapEntry
+
+struct priorityQueue {
+   HeapEntry *heap; // heap[0] has the smallest priority
+   size_t count; // entries in heap
+   size_t capacity; // room in heap, positions, generations, freeSlots
+   unsigned int arity; // children per heap node, at least 2
+   size_t *positions; // heap index of each slot, or NOT_QUEUED
+   size_t *generations; // times each slot has been dequeued
+   size_t *freeSlots; // stack of slots that may be reused
+   size_t freeCount; // slots on freeSlots
+   size_t slotsUsed; // slots ever given out
+};
+
+typedef struct priorityQueue PriorityQueue; // synonym
+
+// prototypes
+int initPriorityQueue(PriorityQueue *queuePtr, unsigned int arity,
+   size_t capacity);
+int enqueuePriority(PriorityQueue *queuePtr, int value, int priority,
+   size_t *handlePtr);
+int dequeuePriority(PriorityQueue *queuePtr, int *valuePtr,
+   int *priorityPtr);
+int decreaseKey(PriorityQueue *queuePtr, size_t handle, int priority);
+int queuedPriority(const PriorityQueue *queuePtr, size_t handle,
+   int *priorityPtr);
+int isEmptyPriority(const PriorityQueue *queuePtr);
+void printPriorityQueue(const PriorityQueue *queuePtr);
+void destroyPriorityQueue(PriorityQueue *queuePtr);
+
+#endif
@@ -0,0 +1,168 @@
+// ringQueue.c
+// Single-producer/single-consumer ring queue function definitions.
+// The producer writes a slot and then publishes it with a release store of
+// tail; the consumer's acquire load of tail therefore sees the value. Head
+// works the same way in the other direction to hand slots back. Each
+// thread rereads the other's index only when its cached copy says the
+// queue is full (or empty), so most operations touch no shared cache line.
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ringQueue.h" // include definition of RingQueue
+
+// allocate room for at least capacity values, rounded up to a power of
+// two; returns 0 if the capacity is too large or no memory is available
+int initRingQueue(RingQueue *queuePtr, size_t capacity)
+{
+   size_t size = 1;
+   size_t maxSize = SIZE_MAX / sizeof(int);
+
+   // largest power of two whose slots still fit in a size_t byte count
+   while (maxSize & (maxSize - 1)) {
+      maxSize &= maxSize - 1;
+   }
+
+   if (capacity > maxSize) {
+      return 0;
+   }
+
+   while (size < capacity) {
+      size *= 2;
+   }
+
+   queuePtr->slots = malloc(size * sizeof(int));
+
+   if (queuePtr->slots == NULL) {
+      return 0;
+   }
+
+   queuePtr->mask = size - 1;
+   atomic_init(&queuePtr->head, 0);
+   atomic_init(&queuePtr->tail, 0);
+   queuePtr->cachedHead = 0;
+   queuePtr->cachedTail = 0;
+   return 1;
+}
+
+// free slots the producer may fill, rereading head only when needed
+static size_t freeSlots(RingQueue *queuePtr, size_t tail, size_t wanted)
+{
+   size_t capacity = queuePtr->mask + 1;
+   size_t room = capacity - (tail - queuePtr->cachedHead);
+
+   if (room < wanted) {
+      queuePtr->cachedHead =
+         atomic_load_explicit(&queuePtr->head, memory_order_acquire);
+      room = capacity - (tail - queuePtr->cachedHead);
+   }
+
+   return room;
+}
+
+// values the consumer may take, rereading tail only when needed
+static size_t usedSlots(RingQueue *queuePtr, size_t head, size_t wanted)
+{
+   size_t used = queuePtr->cachedTail - head;
+
+   if (used < wanted) {
+      queuePtr->cachedTail =
+         atomic_load_explicit(&queuePtr->tail, memory_order_acquire);
+      used = queuePtr->cachedTail - head;
+   }
+
+   return used;
+}
+
+// insert a value at the end of the queue; returns 0 if the queue is full
+int enqueueRing(RingQueue *queuePtr, int value)
+{
+   size_t tail = atomic_load_explicit(&queuePtr->tail, memory_order_relaxed);
+
+   if (freeSlots(queuePtr, tail, 1) == 0) {
+      return 0;
+   }
+
+   queuePtr->slots[tail & queuePtr->mask] = value;
+   atomic_store_explicit(&queuePtr->tail, tail + 1, memory_order_release);
+   return 1;
+}
+
+// insert up to count values with one release store; returns the number
+// that fit
+size_t enqueueNRing(RingQueue *queuePtr, const int values[], size_t count)
+{
+   size_t tail = atomic_load_explicit(&queuePtr->tail, memory_order_relaxed);
+   size_t room = freeSlots(queuePtr, tail, count);
+
+   if (count > room) {
+      count = room;
+   }
+
+   // copy in at most two pieces: up to the end of the array, then from 0
+   size_t first = tail & queuePtr->mask;
+   size_t firstCount = queuePtr->mask + 1 - first;
+
+   if (firstCount > count) {
+      firstCount = count;
+   }
+
+   memcpy(&queuePtr->slots[first], values, firstCount * sizeof(int));
+   memcpy(queuePtr->slots, &values[firstCount],
+      (count - firstCount) * sizeof(int));
+
+   atomic_store_explicit(&queuePtr->tail, tail + count, memory_order_release);
+   return count;
+}
+
+// remove the value at the front of the queue; returns 0 if it is empty
+int dequeueRing(RingQueue *queuePtr, int *valuePtr)
+{
+   size_t head = atomic_load_explicit(&queuePtr->head, memory_order_relaxed);
+
+   if (usedSlots(queuePtr, head, 1) == 0) {
+      return 0;
+   }
+
+   *valuePtr = queuePtr->slots[head & queuePtr->mask];
+   atomic_store_explicit(&queuePtr->head, head + 1, memory_order_release);
+   return 1;
+}
+
+// remove up to count values with one release store; returns the number
+// removed
+size_t dequeueNRing(RingQueue *queuePtr, int values[], size_t count)
+{
+   size_t head = atomic_load_explicit(&queuePtr->head, memory_order_relaxed);
+   size_t used = usedSlots(queuePtr, head, count);
+
+   if (count > used) {
+      count = used;
+   }
+
+   size_t first = head & queuePtr->mask;
+   size_t firstCount = queuePtr->mask + 1 - first;
+
+   if (firstCount > count) {
+      firstCount = count;
+   }
+
+   memcpy(values, &queuePtr->slots[first], firstCount * sizeof(int));
+   memcpy(&values[firstCount], queuePtr->slots,
+      (count - firstCount) * sizeof(int));
+
+   atomic_store_explicit(&queuePtr->head, head + count, memory_order_release);
+   return count;
+}
+
+// return 1 if the queue is empty, 0 otherwise
+int isEmptyRing(RingQueue *queuePtr)
+{
+   return atomic_load(&queuePtr->head) == atomic_load(&queuePtr->tail);
+}
+
+// free the slots; no thread may be using the queue
+void destroyRingQueue(RingQueue *queuePtr)
+{
+   free(queuePtr->slots);
+   queuePtr->slots = NULL;
+}
@@ -0,0 +1,43 @@
+// ringQueue.h
+// Bounded single-producer/single-consumer queue for pipelines in which
+// exactly one thread enqueues and one thread dequeues. Values are stored
+// in a power-of-two array instead of one fig12_13 node per value, and the
+// two threads share nothing but the head and tail indices.
+// Queue functions are defined in ringQueue.c
+
+// prevent multiple inclusions of header
+#ifndef RINGQUEUE_H
+#define RINGQUEUE_H
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// head and tail count every value ever dequeued and enqueued; a value's
+// slot is its count masked by capacity - 1. Each index sits on its own
+// cache line with the owning thread's last view of the other index.
+struct ringQueue {
+   _Alignas(CACHE_LINE_SIZE) _Atomic size_t head; // written by consumer
+   size_t cachedTail; // consumer's copy of tail
+   _Alignas(CACHE_LINE_SIZE) _Atomic size_t tail; // written by producer
+   size_t cachedHead; // producer's copy of head
+   _Alignas(CACHE_LINE_SIZE) int *slots; // capacity values
+   size_t mask; // capacity - 1
+};
+
+typedef struct ringQueue RingQueue; // synonym for struct ringQueue
+
+// prototypes; enqueue functions may only be called by the producer thread
+// and dequeue functions only by the consumer thread
+int initRingQueue(RingQueue *queuePtr, size_t capacity);
+int enqueueRing(RingQueue *queuePtr, int value);
+size_t enqueueNRing(RingQueue *queuePtr, const int values[], size_t count);
+int dequeueRing(RingQueue *queuePtr, int *valuePtr);
+size_t dequeueNRing(RingQueue *queuePtr, int values[], size_t count);
+int isEmptyRing(RingQueue *queuePtr);
+void destroyRingQueue(RingQueue *queuePtr);
+
+#endif
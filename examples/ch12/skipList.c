@@ -0,0 +1,173 @@
+// skipList.c
+// Skip list function definitions.
+#include <stdio.h>
+#include <stdlib.h>
+#include "skipList.h" // include definition of SkipList from skipList.h
+
+// start with no nodes
+void initSkipList(SkipList *listPtr)
+{
+   for (int level = 0; level < SKIP_LIST_MAX_LEVEL; ++level) {
+      listPtr->headPtr[level] = NULL;
+   }
+
+   listPtr->levels = 1;
+   listPtr->count = 0;
+   listPtr->randomState = 2060;
+}
+
+// choose a level count: 1, then one more with probability 1/2 each time
+static int randomLevels(SkipList *listPtr)
+{
+   // xorshift64 pseudorandom bits
+   unsigned long long bits = listPtr->randomState;
+   bits ^= bits << 13;
+   bits ^= bits >> 7;
+   bits ^= bits << 17;
+   listPtr->randomState = bits;
+
+   int levels = 1;
+
+   while ((bits & 1) && levels < SKIP_LIST_MAX_LEVEL) {
+      ++levels;
+      bits >>= 1;
+   }
+
+   return levels;
+}
+
+// fill linkPtrs[level] with the address of the link that leads to the
+// first node whose data is >= value, on every level in use
+static void findLinks(SkipList *listPtr, int value,
+   SkipNode **linkPtrs[SKIP_LIST_MAX_LEVEL])
+{
+   SkipNode **currentLinks = listPtr->headPtr;
+
+   // start on the highest level and drop down a level at each overshoot
+   for (int level = listPtr->levels - 1; level >= 0; --level) {
+      while (currentLinks[level] != NULL && currentLinks[level]->data < value) {
+         currentLinks = currentLinks[level]->nextPtr;
+      }
+
+      linkPtrs[level] = &currentLinks[level];
+   }
+}
+
+// insert a new value into the list in sorted order
+void insertSkipList(SkipList *listPtr, int value)
+{
+   int levels = randomLevels(listPtr);
+   SkipNode *newPtr =
+      malloc(sizeof(SkipNode) + levels * sizeof(SkipNode *)); // create node
+
+   if (newPtr != NULL) { // is space available
+      SkipNode **linkPtrs[SKIP_LIST_MAX_LEVEL];
+
+      // a taller node than any before starts new levels at the head
+      for (int level = listPtr->levels; level < levels; ++level) {
+         listPtr->headPtr[level] = NULL;
+      }
+
+      if (levels > listPtr->levels) {
+         listPtr->levels = levels;
+      }
+
+      findLinks(listPtr, value, linkPtrs);
+      newPtr->data = value;
+      newPtr->levels = levels;
+
+      // splice the node in after its predecessor on each of its levels
+      for (int level = 0; level < levels; ++level) {
+         newPtr->nextPtr[level] = *linkPtrs[level];
+         *linkPtrs[level] = newPtr;
+      }
+
+      ++listPtr->count;
+   }
+   else {
+      printf("%d not inserted. No memory available.\n", value);
+   }
+}
+
+// delete a list element; returns 1 if value was found
+int deleteSkipList(SkipList *listPtr, int value)
+{
+   SkipNode **linkPtrs[SKIP_LIST_MAX_LEVEL];
+
+   findLinks(listPtr, value, linkPtrs);
+   SkipNode *tempPtr = *linkPtrs[0];
+
+   if (tempPtr == NULL || tempPtr->data != value) {
+      return 0;
+   }
+
+   // unlink the node on every level it is on
+   for (int level = 0; level < tempPtr->levels; ++level) {
+      *linkPtrs[level] = tempPtr->nextPtr[level];
+   }
+
+   free(tempPtr);
+   --listPtr->count;
+
+   // drop levels that became empty
+   while (listPtr->levels > 1 &&
+      listPtr->headPtr[listPtr->levels - 1] == NULL) {
+      --listPtr->levels;
+   }
+
+   return 1;
+}
+
+// return 1 if value is in the list, 0 otherwise
+int searchSkipList(const SkipList *listPtr, int value)
+{
+   SkipNode *const *currentLinks = listPtr->headPtr;
+
+   for (int level = listPtr->levels - 1; level >= 0; --level) {
+      while (currentLinks[level] != NULL && currentLinks[level]->data < value) {
+         currentLinks = currentLinks[level]->nextPtr;
+      }
+   }
+
+   return currentLinks[0] != NULL && currentLinks[0]->data == value;
+}
+
+// return 1 if the list is empty, 0 otherwise
+int isEmptySkipList(const SkipList *listPtr)
+{
+   return listPtr->headPtr[0] == NULL;
+}
+
+// print the list; level 0 links every node in order
+void printSkipList(const SkipList *listPtr)
+{
+   // if list is empty
+   if (isEmptySkipList(listPtr)) {
+      puts("List is empty.\n");
+   }
+   else {
+      puts("The list is:");
+
+      // while not the end of the list
+      for (const SkipNode *currentPtr = listPtr->headPtr[0];
+         currentPtr != NULL; currentPtr = currentPtr->nextPtr[0]) {
+         printf("%d --> ", currentPtr->data);
+      }
+
+      puts("NULL\n");
+   }
+}
+
+// free every node
+void freeSkipList(SkipList *listPtr)
+{
+   SkipNode *currentPtr = listPtr->headPtr[0];
+
+   while (currentPtr != NULL) {
+      SkipNode *nextPtr = currentPtr->nextPtr[0];
+      free(currentPtr);
+      currentPtr = nextPtr;
+   }
+
+   initSkipList(listPtr);
+}
@@ -0,0 +1,44 @@
+// skipList.h
+// Sorted list with the insert/delete/isEmpty/printList shape of Fig. 12.3,
+// stored as a skip list: each node is also linked on a random number of
+// express levels, so search and update take expected O(log n) steps
+// instead of a walk from the start of the list.
+// Skip list functions are defined in skipList.c
+
+// prevent multiple inclusions of header
+#ifndef SKIPLIST_H
+#define SKIPLIST_H
+
+#include <stddef.h>
+
+#define SKIP_LIST_MAX_LEVEL 32 // enough for 2^32 nodes with p = 1/2
+
+// self-referential structure with one next pointer per level
+struct skipNode {
+   int data; // each skipNode contains an int
+   int levels; // number of entries in nextPtr
+   struct skipNode *nextPtr[]; // next node on levels 0 .. levels - 1
+};
+
+typedef struct skipNode SkipNode; // synonym for struct skipNode
+
+// the head holds the first node of every level
+struct skipList {
+   SkipNode *headPtr[SKIP_LIST_MAX_LEVEL]; // first node on each level
+   int levels; // levels currently in use
+   size_t count; // number of values
+   unsigned long long randomState; // for choosing node levels
+};
+
+typedef struct skipList SkipList; // synonym for struct skipList
+
+// prototypes
+void initSkipList(SkipList *listPtr);
+void insertSkipList(SkipList *listPtr, int value);
+int deleteSkipList(SkipList *listPtr, int value);
+int searchSkipList(const SkipList *listPtr, int value);
+int isEmptySkipList(const SkipList *listPtr);
+void printSkipList(const SkipList *listPtr);
+void freeSkipList(SkipList *listPtr);
+
+#endif
@@ -0,0 +1,209 @@
+// unrolledList.c
+// Unrolled list function definitions.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "unrolledList.h" // include definition of UnrolledList
+
+// start with no blocks
+void initUnrolledList(UnrolledList *listPtr)
+{
+   listPtr->headPtr = NULL;
+   listPtr->count = 0;
+   listPtr->blocks = 0;
+}
+
+// allocate an empty block on a cache-line boundary; NULL if out of memory
+static UnrolledBlock *newBlock(UnrolledList *listPtr)
+{
+   UnrolledBlock *blockPtr =
+      aligned_alloc(CACHE_LINE_SIZE, sizeof(UnrolledBlock));
+
+   if (blockPtr != NULL) {
+      blockPtr->nextPtr = NULL;
+      blockPtr->count = 0;
+      ++listPtr->blocks;
+   }
+
+   return blockPtr;
+}
+
+// index of the first value in the block that is >= value
+static int lowerBound(const UnrolledBlock *blockPtr, int value)
+{
+   int index = 0;
+
+   while (index < blockPtr->count && blockPtr->data[index] < value) {
+      ++index;
+   }
+
+   return index;
+}
+
+// return the address of the link to the block that should hold value:
+// the first block whose last value is >= value, or else the last block
+static UnrolledBlock **findBlock(UnrolledList *listPtr, int value)
+{
+   UnrolledBlock **linkPtr = &listPtr->headPtr;
+
+   while ((*linkPtr)->nextPtr != NULL &&
+      (*linkPtr)->data[(*linkPtr)->count - 1] < value) {
+      linkPtr = &(*linkPtr)->nextPtr;
+   }
+
+   return linkPtr;
+}
+
+// insert a new value into the list in sorted order
+void insertUnrolled(UnrolledList *listPtr, int value)
+{
+   if (listPtr->headPtr == NULL) {
+      listPtr->headPtr = newBlock(listPtr);
+
+      if (listPtr->headPtr == NULL) {
+         printf("%d not inserted. No memory available.\n", value);
+         return;
+      }
+   }
+
+   UnrolledBlock *blockPtr = *findBlock(listPtr, value);
+   int index = lowerBound(blockPtr, value);
+
+   // a full block moves its upper half into a new block after it
+   if (blockPtr->count == (int) UNROLLED_BLOCK_VALUES) {
+      UnrolledBlock *splitPtr = newBlock(listPtr);
+
+      if (splitPtr == NULL) {
+         printf("%d not inserted. No memory available.\n", value);
+         return;
+      }
+
+      int keep = blockPtr->count / 2;
+      splitPtr->count = blockPtr->count - keep;
+      memcpy(splitPtr->data, &blockPtr->data[keep],
+         splitPtr->count * sizeof(int));
+      blockPtr->count = keep;
+      splitPtr->nextPtr = blockPtr->nextPtr;
+      blockPtr->nextPtr = splitPtr;
+
+      if (index > keep) {
+         blockPtr = splitPtr;
+         index -= keep;
+      }
+   }
+
+   // open a gap at index and store the value in it
+   memmove(&blockPtr->data[index + 1], &blockPtr->data[index],
+      (blockPtr->count - index) * sizeof(int));
+   blockPtr->data[index] = value;
+   ++blockPtr->count;
+   ++listPtr->count;
+}
+
+// delete a list element; returns 1 if value was found
+int deleteUnrolled(UnrolledList *listPtr, int value)
+{
+   if (listPtr->headPtr == NULL) {
+      return 0;
+   }
+
+   UnrolledBlock **linkPtr = findBlock(listPtr, value);
+   UnrolledBlock *blockPtr = *linkPtr;
+   int index = lowerBound(blockPtr, value);
+
+   if (index == blockPtr->count || blockPtr->data[index] != value) {
+      return 0;
+   }
+
+   // close the gap
+   --blockPtr->count;
+   memmove(&blockPtr->data[index], &blockPtr->data[index + 1],
+      (blockPtr->count - index) * sizeof(int));
+   --listPtr->count;
+
+   UnrolledBlock *nextPtr = blockPtr->nextPtr;
+
+   if (blockPtr->count == 0) { // unlink an empty block
+      *linkPtr = nextPtr;
+      free(blockPtr);
+      --listPtr->blocks;
+   }
+   else if (blockPtr->count < (int) UNROLLED_MIN_VALUES && nextPtr != NULL) {
+      if (blockPtr->count + nextPtr->count <= (int) UNROLLED_BLOCK_VALUES) {
+         // merge the next block into this one
+         memcpy(&blockPtr->data[blockPtr->count], nextPtr->data,
+            nextPtr->count * sizeof(int));
+         blockPtr->count += nextPtr->count;
+         blockPtr->nextPtr = nextPtr->nextPtr;
+         free(nextPtr);
+         --listPtr->blocks;
+      }
+      else {
+         // borrow the first value of the next block
+         blockPtr->data[blockPtr->count] = nextPtr->data[0];
+         ++blockPtr->count;
+         --nextPtr->count;
+         memmove(nextPtr->data, &nextPtr->data[1],
+            nextPtr->count * sizeof(int));
+      }
+   }
+
+   return 1;
+}
+
+// return 1 if value is in the list, 0 otherwise
+int searchUnrolled(const UnrolledList *listPtr, int value)
+{
+   // skip whole blocks by their last value
+   for (const UnrolledBlock *blockPtr = listPtr->headPtr; blockPtr != NULL;
+      blockPtr = blockPtr->nextPtr) {
+      if (blockPtr->data[blockPtr->count - 1] >= value) {
+         int index = lowerBound(blockPtr, value);
+         return blockPtr->data[index] == value;
+      }
+   }
+
+   return 0;
+}
+
+// return 1 if the list is empty, 0 otherwise
+int isEmptyUnrolled(const UnrolledList *listPtr)
+{
+   return listPtr->headPtr == NULL;
+}
+
+// print the list
+void printUnrolled(const UnrolledList *listPtr)
+{
+   // if list is empty
+   if (isEmptyUnrolled(listPtr)) {
+      puts("List is empty.\n");
+   }
+   else {
+      puts("The list is:");
+
+      // while not the end of the list
+      for (const UnrolledBlock *blockPtr = listPtr->headPtr;
+         blockPtr != NULL; blockPtr = blockPtr->nextPtr) {
+         for (int index = 0; index < blockPtr->count; ++index) {
+            printf("%d --> ", blockPtr->data[index]);
+         }
+      }
+
+      puts("NULL\n");
+   }
+}
+
+// free every block
+void freeUnrolled(UnrolledList *listPtr)
+{
+   UnrolledBlock *blockPtr = listPtr->headPtr;
+
+   while (blockPtr != NULL) {
+      UnrolledBlock *nextPtr = blockPtr->nextPtr;
+      free(blockPtr);
+      blockPtr = nextPtr;
+   }
+
+   initUnrolledList(listPtr);
+}
@@ -0,0 +1,51 @@
+// unrolledList.h
+// Sorted list with the insert/delete/isEmpty/printList shape of Fig. 12.3,
+// stored as an unrolled list: each heap block holds up to
+// UNROLLED_BLOCK_VALUES values in order, so a walk over the list touches
+// one cache line per block instead of one per value.
+// Unrolled list functions are defined in unrolledList.c
+
+// prevent multiple inclusions of header
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <stddef.h>
+
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// values that fit in one cache line beside the link and the count
+#define UNROLLED_BLOCK_VALUES \
+   ((CACHE_LINE_SIZE - sizeof(void *) - sizeof(int)) / sizeof(int))
+
+// blocks other than the only one are kept at least half full
+#define UNROLLED_MIN_VALUES (UNROLLED_BLOCK_VALUES / 2)
+
+// self-referential structure holding a run of sorted values
+struct unrolledBlock {
+   struct unrolledBlock *nextPtr; // pointer to next block
+   int count; // values in use, from data[0]
+   int data[UNROLLED_BLOCK_VALUES]; // sorted values
+};
+
+typedef struct unrolledBlock UnrolledBlock; // synonym for struct unrolledBlock
+
+struct unrolledList {
+   UnrolledBlock *headPtr; // first block, NULL when empty
+   size_t count; // number of values
+   size_t blocks; // number of blocks
+};
+
+typedef struct unrolledList UnrolledList; // synonym for struct unrolledList
+
+// prototypes
+void initUnrolledList(UnrolledList *listPtr);
+void insertUnrolled(UnrolledList *listPtr, int value);
+int deleteUnrolled(UnrolledList *listPtr, int value);
+int searchUnrolled(const UnrolledList *listPtr, int value);
+int isEmptyUnrolled(const UnrolledList *listPtr);
+void printUnrolled(const UnrolledList *listPtr);
+void freeUnrolled(UnrolledList *listPtr);
+
+#endif
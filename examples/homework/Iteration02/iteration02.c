@@ -8,22 +8,39 @@
 
 #include <ctype.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
 #include <math.h>
+#include <stdatomic.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <threads.h>
 #include <time.h>
+#include <unistd.h>
 
 
 //## General Constants
 #define STRING_SIZE 80
 #define TIME_STAMP_SIZE 19
 #define MAX_CRED_PROMPTS 3
-#define MIN_DONATION 0.0
-#define MIN_GOAL 0.0
+#define MIN_DONATION 0
+#define MIN_GOAL 0
 #define TRANSACTION_FEE 0.031
 
+//## Money Constants
+#define CENTS_PER_DOLLAR 100
+#define MAX_CENTS ((Cents) 100000000000) // $1 billion in one amount
+#define MONEY_STRING_SIZE 24
+// the fee is 31 per mille of the donation, rounded half up to the cent
+#define FEE_PER_MILLE 31
+#define FEE_DIVISOR 1000
+
 //## Prompt Messages
 #define DONATION_PROMPT "Enter your donation amount($): "
 #define DONATION_SELECT_PROMPT "Select the organization to donate to: "
@@ -90,11 +107,166 @@ const char NO[STRING_SIZE] = "n";
 //## Zip Constants
 #define ZIP_SIZE 5
 
+//## Character Class Constants
+#define CHAR_UPPER 0x01
+#define CHAR_LOWER 0x02
+#define CHAR_DIGIT 0x04
+#define CHAR_ALPHA (CHAR_UPPER | CHAR_LOWER)
+// the classes isupper(), islower() and isdigit() give in the C locale
+const unsigned char CHAR_CLASSES[UCHAR_MAX + 1] = {
+    ['A'] = CHAR_UPPER, ['B'] = CHAR_UPPER, ['C'] = CHAR_UPPER,
+    ['D'] = CHAR_UPPER, ['E'] = CHAR_UPPER, ['F'] = CHAR_UPPER,
+    ['G'] = CHAR_UPPER, ['H'] = CHAR_UPPER, ['I'] = CHAR_UPPER,
+    ['J'] = CHAR_UPPER, ['K'] = CHAR_UPPER, ['L'] = CHAR_UPPER,
+    ['M'] = CHAR_UPPER, ['N'] = CHAR_UPPER, ['O'] = CHAR_UPPER,
+    ['P'] = CHAR_UPPER, ['Q'] = CHAR_UPPER, ['R'] = CHAR_UPPER,
+    ['S'] = CHAR_UPPER, ['T'] = CHAR_UPPER, ['U'] = CHAR_UPPER,
+    ['V'] = CHAR_UPPER, ['W'] = CHAR_UPPER, ['X'] = CHAR_UPPER,
+    ['Y'] = CHAR_UPPER, ['Z'] = CHAR_UPPER,
+    ['a'] = CHAR_LOWER, ['b'] = CHAR_LOWER, ['c'] = CHAR_LOWER,
+    ['d'] = CHAR_LOWER, ['e'] = CHAR_LOWER, ['f'] = CHAR_LOWER,
+    ['g'] = CHAR_LOWER, ['h'] = CHAR_LOWER, ['i'] = CHAR_LOWER,
+    ['j'] = CHAR_LOWER, ['k'] = CHAR_LOWER, ['l'] = CHAR_LOWER,
+    ['m'] = CHAR_LOWER, ['n'] = CHAR_LOWER, ['o'] = CHAR_LOWER,
+    ['p'] = CHAR_LOWER, ['q'] = CHAR_LOWER, ['r'] = CHAR_LOWER,
+    ['s'] = CHAR_LOWER, ['t'] = CHAR_LOWER, ['u'] = CHAR_LOWER,
+    ['v'] = CHAR_LOWER, ['w'] = CHAR_LOWER, ['x'] = CHAR_LOWER,
+    ['y'] = CHAR_LOWER, ['z'] = CHAR_LOWER,
+    ['0'] = CHAR_DIGIT, ['1'] = CHAR_DIGIT, ['2'] = CHAR_DIGIT,
+    ['3'] = CHAR_DIGIT, ['4'] = CHAR_DIGIT, ['5'] = CHAR_DIGIT,
+    ['6'] = CHAR_DIGIT, ['7'] = CHAR_DIGIT, ['8'] = CHAR_DIGIT,
+    ['9'] = CHAR_DIGIT,
+};
+
 //## Linked List Constants
 #define MEM_ERROR "Not enough memory for new nodes."
 #define LINKED_LIST_EMPTY "There aren't any names in the list."
 #define LINKED_LIST_HEADER "Organization\t\tGoal Amount\t\tCurrent Donations"
 
+//## Column Store Constants
+#define COLUMN_BLOCK_ROWS 4096
+#define REPORT_TOP_ORGS 5
+
+//## Hash Index Constants
+#define INDEX_MIN_CAPACITY 16
+#define INDEX_MAX_LOAD_PERCENT 50
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+//## Command Line Constants
+#define BENCH_INDEX_ARG "--bench-index"
+#define BENCH_DEFAULT_ORGS 100000
+#define BENCH_SCAN_LOOKUPS 200
+#define BENCH_INDEX_LOOKUPS 1000000
+#define BENCH_INSERT_ARG "--bench-insert"
+#define BENCH_INSERT_DEFAULT_ORGS 10000
+#define BENCH_ORG_NAME_FORMAT "Organization %07zu"
+#define BATCH_ARG "--batch"
+#define BENCH_ENGINE_ARG "--bench-engine"
+#define BENCH_MONEY_ARG "--bench-money"
+#define BENCH_MONEY_DEFAULT_DONATIONS 10000000
+#define BENCH_REPORT_ARG "--bench-report"
+#define BENCH_REPORT_DEFAULT_ORGS 1000000
+#define BENCH_REPORT_DEFAULT_TOP 10
+#define FUZZ_VALIDATORS_ARG "--fuzz-validators"
+#define FUZZ_VALIDATORS_DEFAULT_CASES 1000000
+#define FUZZ_MAX_REPORTED_MISMATCHES 10
+#define BENCH_VALIDATORS_ARG "--bench-validators"
+#define BENCH_VALIDATORS_DEFAULT 10000000
+#define BENCH_VALIDATORS_CORPUS 4096
+#define BENCH_ENGINE_ORGS 10000
+#define BENCH_ENGINE_DEFAULT_DONATIONS 4000000
+#define MAKE_BATCH_ARG "--make-batch"
+#define BENCH_RECEIPTS_ARG "--bench-receipts"
+#define BENCH_RECEIPTS_DEFAULT 200000
+#define BENCH_RECEIPT_ORGS 100
+#define SNAPSHOT_ARG "--snapshot"
+#define BENCH_SNAPSHOT_ARG "--bench-snapshot"
+#define BENCH_SNAPSHOT_DEFAULT_ORGS 1000000
+#define BENCH_SNAPSHOT_PATH "bench-snapshot.bin"
+#define BENCH_SNAPSHOT_CHECKS 1000
+#define LOG_ARG "--log"
+#define BENCH_LOG_ARG "--bench-log"
+#define BENCH_LOG_DEFAULT_DONATIONS 50000
+#define BENCH_LOG_ORGS 100
+#define BENCH_LOG_PATH "bench-donations.log"
+#define BENCH_RECOVERY_ARG "--bench-recovery"
+#define BENCH_RECOVERY_DEFAULT_RECORDS 100000000
+#define USAGE_MESSAGE "Usage: iteration02 [" SNAPSHOT_ARG " file | " \
+                      BENCH_INDEX_ARG " [numOrgs] | " \
+                      BENCH_INSERT_ARG " [numOrgs] |\n" \
+                      "                   " BATCH_ARG " [file [threads]] | " \
+                      MAKE_BATCH_ARG " [numOrgs [numDonations]] |\n" \
+                      "                   " BENCH_RECEIPTS_ARG " [numReceipts] | " \
+                      BENCH_SNAPSHOT_ARG " [numOrgs] |\n" \
+                      "                   " BENCH_ENGINE_ARG " [maxThreads " \
+                      "[numDonations]] | " BENCH_MONEY_ARG " [numDonations] |\n" \
+                      "                   " BENCH_REPORT_ARG " [numOrgs [top]] | " \
+                      FUZZ_VALIDATORS_ARG " [numCases] |\n" \
+                      "                   " BENCH_VALIDATORS_ARG " [numValidations] | " \
+                      LOG_ARG " file [groupSize [maxDelayMicros]] |\n" \
+                      "                   " BENCH_LOG_ARG " [numDonations " \
+                      "[maxDelayMicros]] | " BENCH_RECOVERY_ARG " [numRecords]]"
+
+//## Batch Constants
+#define BATCH_STDIN_PATH "-"
+#define BATCH_BUFFER_SIZE (1 << 20)
+#define BATCH_MAX_FIELDS 8
+#define BATCH_MAX_REPORTED_ERRORS 10
+#define BATCH_COMMENT_CHAR '#'
+#define BATCH_ORG_RECORD "org"
+#define BATCH_ORG_FIELDS 7
+#define BATCH_DONATION_RECORD "donation"
+#define BATCH_MIN_DONATION_FIELDS 5
+#define BATCH_MAX_DONATION_FIELDS 6
+#define MAKE_BATCH_DEFAULT_ORGS 100
+#define MAKE_BATCH_DEFAULT_DONATIONS 1000000
+#define MAKE_BATCH_RECEIPT_EVERY 100
+
+//## Receipt Writer Constants
+#define RECEIPT_BUFFER_SIZE (16 * 1024)
+#define RECEIPT_MAX_OPEN_FILES 256
+#define RECEIPT_DATE_LABEL "Donation Date: "
+#define RECEIPT_FORMAT "Organization: %s\nDonation Amount: $%s\n" \
+                       RECEIPT_DATE_LABEL "%s\n\n"
+#define TIME_STAMP_FORMAT "%D - %I:%M%p"
+
+//## Snapshot Constants
+#define SNAPSHOT_MAGIC "ORGSNAP"
+#define SNAPSHOT_VERSION 4
+#define SNAPSHOT_HEADER_SIZE 4096
+#define SNAPSHOT_BASE_ADDRESS ((uintptr_t) 0x200000000000ULL)
+#define SNAPSHOT_TEMP_SUFFIX ".tmp"
+
+//## Donation Log Constants
+#define LOG_MAGIC "DONALOG"
+#define LOG_VERSION 1
+#define LOG_ORG_RECORD 1
+#define LOG_DONATION_RECORD 2
+#define LOG_FILE_MODE 0644
+#define LOG_BUFFER_SIZE (1 << 20)
+#define LOG_DEFAULT_GROUP_SIZE 64
+#define LOG_DEFAULT_MAX_DELAY_MICROS 2000
+#define LOG_ERROR "Could not save the donation to the donation log."
+#define LOG_ORG_ERROR "Could not save the organization to the donation log."
+#define LOG_FAILED_SEQUENCE UINT64_MAX
+#define MICROS_PER_SECOND 1000000L
+#define NANOS_PER_MICRO 1000L
+#define NANOS_PER_SECOND 1000000000L
+
+//## Donation Engine Constants
+#define ENGINE_MAX_WORKERS 64
+#define ENGINE_QUEUE_SIZE 4096
+#define ENGINE_IDLE_SPINS 64 // empty polls before a worker sleeps
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif
+
+// kernels without MAP_FIXED_NOREPLACE take the address as a hint
+#ifndef MAP_FIXED_NOREPLACE
+#define MAP_FIXED_NOREPLACE 0
+#endif
+
 //## Mode Constants
 #define MODE_SUCCESS_ADMIN 42
 #define SETUP_MODE_FLAG 0
@@ -103,6 +275,9 @@ const char NO[STRING_SIZE] = "n";
 #define END_PROGRAM_FLAG -1
 
 
+//! An amount of money in whole cents, so sums and fees are exact.
+typedef int64_t Cents;
+
 //! An donor struct which packages all relevant information to itself.
 typedef struct donor
 {
@@ -118,7 +293,7 @@ typedef struct organization
     char purpose[STRING_SIZE];
     char receiptPath[RECEIPTS_PATH_SIZE];
     char url[LINK_SIZE];
-    double goalAmount;
+    Cents goalAmount;
 
     // owner properties
     char ownerEmail[STRING_SIZE];
@@ -127,8 +302,8 @@ typedef struct organization
 
     // donation tracking
     unsigned int numDonations;
-    double donationSum;
-    double feesSum;
+    Cents donationSum;
+    Cents feesSum;
 
     // donor tracking
     unsigned int numDonors;
@@ -139,8 +314,299 @@ typedef struct orgNode
 {
     Organization org;
     struct orgNode *nextNodePtr;
+
+    // the lowercase name, folded once when the node is linked so sorting
+    // and lookups never have to lowercase it again
+    char key[STRING_SIZE];
+    size_t keyLength;
+    uint64_t keyHash;
+
+    // the org's receipts waiting for the receipt writer, if it has any
+    struct receiptBuffer *receiptsPtr;
+
+    // the number the donation log knows the org by
+    uint32_t logNum;
 } OrgNode;
 
+//! A block of rows of the organization columns.
+typedef struct orgColumnBlock
+{
+    Cents goals[COLUMN_BLOCK_ROWS];
+    Cents raised[COLUMN_BLOCK_ROWS];
+    Cents fees[COLUMN_BLOCK_ROWS];
+    unsigned int numDonations[COLUMN_BLOCK_ROWS];
+    const OrgNode *nodes[COLUMN_BLOCK_ROWS];
+    size_t count;
+    struct orgColumnBlock *nextBlockPtr;
+} OrgColumnBlock;
+
+//! The numbers a report reads for every organization, one array per field,
+//! apart from the strings in the nodes. The nodes hold the running totals;
+//! a report copies them into the columns in list order as it walks the
+//! list once, and then scans only the columns.
+typedef struct orgColumns
+{
+    OrgColumnBlock *headBlockPtr;
+    OrgColumnBlock *tailBlockPtr;
+    size_t count;
+} OrgColumns;
+
+//! An open-addressing hash table which finds org nodes by name, ignoring case.
+typedef struct orgIndex
+{
+    OrgNode **slots;
+    size_t capacity;
+    size_t count;
+    bool slotsMapped; // slots are in a snapshot mapping and are not freed
+} OrgIndex;
+
+//! An organization linked list along with the hash index of its names.
+typedef struct orgList
+{
+    OrgNode *headPtr;
+    OrgIndex index;
+
+    // the snapshot the list was loaded from, whose nodes are used in place
+    void *snapshotPtr;
+    size_t snapshotSize;
+
+    // the log new orgs and donations are saved to, if there is one
+    struct donationLog *logPtr;
+} OrgList;
+
+//! The start of a snapshot file. The file is an image of an org list laid
+//! out to be mapped at baseAddress: the header, the index slots, then the
+//! nodes in list order with their pointers already set for that address.
+typedef struct snapshotHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t nodeSize;
+    uint64_t baseAddress;
+    uint64_t fileSize;
+    uint64_t orgCount;
+    uint64_t slotCount;
+    uint64_t slotsOffset;
+    uint64_t nodesOffset;
+} SnapshotHeader;
+
+//! One organization's formatted receipts. One half fills while the writer
+//! thread writes the other, so formatting never waits on the disk unless
+//! a whole half fills before the previous one is written.
+typedef struct receiptBuffer
+{
+    char receiptPath[RECEIPTS_PATH_SIZE];
+    FILE *file;
+
+    // the org node pointing at this buffer, cleared when the buffer is freed
+    OrgNode *ownerPtr;
+
+    char *fillData;
+    size_t fillUsed;
+    char *flushData;
+    size_t flushUsed;
+    bool queued;
+
+    struct receiptBuffer *nextBufferPtr;
+    struct receiptBuffer *nextQueuedPtr;
+} ReceiptBuffer;
+
+//! A background thread which appends receipt buffers to their files. Only
+//! one thread may queue receipts.
+typedef struct receiptWriter
+{
+    mtx_t mutex;
+    cnd_t workReady;
+    cnd_t flushDone;
+    thrd_t thread;
+    bool stopping;
+    bool writeFailed;
+
+    // every buffer, and the buffers waiting to be written in order
+    ReceiptBuffer *buffersPtr;
+    ReceiptBuffer *queueHeadPtr;
+    ReceiptBuffer *queueTailPtr;
+    size_t openFiles;
+
+    // the receipt time stamp, formatted again only when the second changes
+    time_t stampSecond;
+    char timeStamp[TIME_STAMP_SIZE];
+} ReceiptWriter;
+
+//! The start of a donation log file.
+typedef struct logHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+} LogHeader;
+
+//! A record in the donation log. A donation is just the record; a new
+//! organization's record is followed by a LogOrgPayload.
+typedef struct logRecord
+{
+    uint64_t checksum; // of the rest of the record and its payload
+    uint32_t type;
+    uint32_t orgNum; // organizations are numbered in the order they are logged
+    Cents amount; // the donation, or the new organization's goal
+} LogRecord;
+
+//! What the log keeps of a new organization besides its goal.
+typedef struct logOrgPayload
+{
+    char name[STRING_SIZE];
+    char purpose[STRING_SIZE];
+    char ownerFirstLastName[STRING_SIZE];
+    char ownerEmail[STRING_SIZE];
+    char ownerPwd[STRING_SIZE];
+} LogOrgPayload;
+
+//! An append-only donation log with group commit. Records fill one half of
+//! a buffer while a thread writes the other half and syncs it with a single
+//! fdatasync(), once a group of records is waiting or the oldest of them
+//! has waited the latency bound.
+typedef struct donationLog
+{
+    int fd;
+    mtx_t mutex;
+    cnd_t workReady;
+    cnd_t committed;
+    thrd_t thread;
+
+    char *fillData;
+    size_t fillUsed;
+    char *flushData;
+
+    // records are counted from the start of this session; taken ones have
+    // been handed to the thread, durable ones synced
+    uint64_t appendedRecords;
+    uint64_t takenRecords;
+    uint64_t durableRecords;
+    uint64_t numSyncs;
+
+    size_t groupSize;
+    long maxDelayMicros;
+    struct timespec groupDeadline;
+
+    uint32_t numOrgs; // the number the next new organization gets
+    uint64_t replayedDonations;
+    size_t droppedBytes; // of a torn or corrupt tail, cut off on opening
+
+    bool flushNow;
+    bool stopping;
+    bool failed;
+} DonationLog;
+
+//! A donation waiting for the worker which owns its organization. A task
+//! with no node asks the worker to pause for a snapshot.
+typedef struct donationTask
+{
+    OrgNode *nodePtr;
+    Cents donation;
+    size_t snapshotEpoch;
+} DonationTask;
+
+//! A queue slot whose sequence number says whether it may be written or read.
+typedef struct taskCell
+{
+    atomic_size_t sequence;
+    DonationTask task;
+} TaskCell;
+
+//! A worker thread and its queue. Any thread may add tasks, but only the
+//! worker takes them, so the worker is the only thread which changes the
+//! counters of the organizations it owns.
+typedef struct donationWorker
+{
+    _Alignas(CACHE_LINE_SIZE) atomic_size_t enqueuePos;
+    _Alignas(CACHE_LINE_SIZE) size_t dequeuePos;
+    TaskCell *cells;
+    size_t mask;
+    thrd_t thread;
+    struct donationEngine *enginePtr;
+
+    // set while the worker sleeps on an empty queue; a producer that finds
+    // it set clears it and wakes the worker
+    _Alignas(CACHE_LINE_SIZE) atomic_bool sleeping;
+    mtx_t sleepMutex;
+    cnd_t wakeUp;
+} DonationWorker;
+
+//! A pool of workers over which organizations are sharded by name.
+typedef struct donationEngine
+{
+    DonationWorker *workers;
+    size_t numWorkers;
+    atomic_bool stopping;
+
+    // workers paused for the snapshot in progress, and the number of
+    // snapshots taken, which releases them when it changes; both are
+    // guarded by pauseMutex
+    size_t pausedWorkers;
+    size_t snapshotEpoch;
+    mtx_t snapshotMutex;
+    mtx_t pauseMutex;
+    cnd_t allPaused;
+    cnd_t resumed;
+} DonationEngine;
+
+//! An organization's counters as of a snapshot.
+typedef struct orgTotals
+{
+    const char *name;
+    unsigned int numDonations;
+    unsigned int numDonors;
+    Cents donationSum;
+    Cents feesSum;
+} OrgTotals;
+
+//! Counts of what a batch run did with its records.
+typedef struct batchStats
+{
+    size_t records;
+    size_t orgs;
+    size_t donations;
+    size_t receipts;
+    size_t rejected;
+} BatchStats;
+
+//! Everything a batch run applies its records to.
+typedef struct batchRun
+{
+    OrgList *listPtr;
+    ReceiptWriter *writerPtr;
+    DonationEngine *enginePtr; // NULL to apply donations on the reading thread
+    BatchStats stats;
+    char separator; // '\0' until the first record decides it
+} BatchRun;
+
+//! Totals over every organization in a report.
+typedef struct reportTotals
+{
+    size_t numOrgs;
+    Cents goals;
+    Cents raised;
+    Cents fees;
+    uint64_t numDonations;
+    size_t numAtGoal;
+} ReportTotals;
+
+//! A validator and the original version it has to agree with.
+typedef struct validatorPair
+{
+    const char *name;
+    bool (*byTable)(const char *);
+    bool (*byScans)(const char *);
+} ValidatorPair;
+
+//! An organization in a top-K ranking by amount raised.
+typedef struct topOrg
+{
+    Cents raised;
+    size_t row;
+    const OrgNode *nodePtr;
+} TopOrg;
+
 //## Mode Constants
 #define SETUP_MODE_FLAG 0
 #define DONATIONS_MODE_FLAG 1
@@ -168,13 +634,32 @@ bool matchCredential(const char *cred, const char *prompt, const char
   \param org the organization you wish to have a receipt printed for
   \param donation the amount donated
  */
-void fPrintReceipt(FILE *stream, const Organization *org, double donation);
+void fPrintReceipt(FILE *stream, const Organization *org, Cents donation);
 //! Prints a summary for an organization to a given stream.
 /*! 
   \param stream the stream to print to
   \param org the organization you wish to have a receipt printed for
  */
 void fPrintSummary(FILE *stream, const Organization *org);
+//! Prints a summary from an organization's counters in a snapshot.
+/*! 
+  \param stream the stream to print to
+  \param totalsPtr the organization's counters
+ */
+void fPrintTotals(FILE *stream, const OrgTotals *totalsPtr);
+//! Zeroes an organization's totals and generates its url and receipt path
+//! from its name.
+/*!
+  \param org the organization, whose name is already set
+ */
+void initOrgTotals(Organization *org);
+//! Adds a donation and its credit card processing fee to an organization.
+/*!
+  \param org the organization donated to
+  \param donation the amount donated
+  \return the processing fee taken from the donation
+ */
+Cents addDonation(Organization *org, Cents donation);
 //! Compares two strings in a caseless manner.
 /*!
   \param str1 the string to compare against
@@ -252,30 +737,69 @@ void getValidatedWord(char *word, size_t wordSize, bool (*validate)(const char
                       *), const char *prompt, const char *error);
 
 //## String input validation functions
-//! Determine if a string is an email address
+//! Determine if a string is an email address in one pass, looking each
+//! character's class up in CHAR_CLASSES.
 /*!
   \param email the string to be validated
   \return whether or not the string is an email address
  */
 bool isEmail(const char *email); 
-//! Determine if a string is a valid password
+//! Determine if a string is a valid password in one pass, looking each
+//! character's class up in CHAR_CLASSES.
 /*!
   \param password the string to be validated
   \return whether or not the string is a valid password
  */
 bool isPassword(const char *password);
-//! Determine if a string is a yes or no
+//! Determine if a string is a yes or no without copying it
 /*!
   \param yesNo the string to be validated
   \return whether or not the string is a yes or no
  */
-bool isYesOrNo(const char *yesNo);
-//! Determine if a string is an email address
+bool isYesNo(const char *yesNo);
+//! Determine if a string is a zip code in one pass, looking each
+//! character's class up in CHAR_CLASSES.
 /*!
   \param zip the string to be validated
-  \return whether or not the string is an email address
+  \return whether or not the string is a zip code
  */
 bool isZip(const char *zip);
+//! Determine if a string matches a lowercase string, ignoring case, without
+//! copying either.
+/*!
+  \param str the string to be compared
+  \param lowerStr the lowercase string to compare with
+  \return whether or not the strings match
+ */
+bool isCaselessMatch(const char *str, const char *lowerStr);
+//! The original isEmail(), which makes several passes over the string. Kept
+//! to check and benchmark isEmail() against.
+/*!
+  \param email the string to be validated
+  \return whether or not the string is an email address
+ */
+bool isEmailByScans(const char *email);
+//! The original isPassword(), which takes the string's length for every
+//! character. Kept to check and benchmark isPassword() against.
+/*!
+  \param password the string to be validated
+  \return whether or not the string is a valid password
+ */
+bool isPasswordByScans(const char *password);
+//! The original isYesNo(), which lowercases copies of both strings. Kept to
+//! check and benchmark isYesNo() against.
+/*!
+  \param yesNo the string to be validated, shorter than STRING_SIZE
+  \return whether or not the string is a yes or no
+ */
+bool isYesNoByScans(const char *yesNo);
+//! The original isZip(), which takes the length and then checks every
+//! character. Kept to check and benchmark isZip() against.
+/*!
+  \param zip the string to be validated
+  \return whether or not the string is a zip code
+ */
+bool isZipByScans(const char *zip);
 
 //## String input wrapper functions for getValidatedWord()
 //! Gets a valid email from the user
@@ -304,25 +828,39 @@ bool getYesOrNo(const char *prompt, const char *error);
  */
 void getZip(char *zip, size_t zipSize);
 
-//## Double input toolchain
-//! Converts a string to a positive double and returns the result
+//## Money toolchain
+//! Converts a decimal dollar amount such as "12.5" to cents. Digits past
+//! the cent are rounded half up.
 /*!
   \param str the original string
-  \param num the location of the double to write into
-  \param min the minimum acceptable number that is considered valid
+  \param cents the location of the cents to write into
+  \param min the amount, in cents, the result must be above to be valid
   \return Whether or not the conversion succeeded
  */
-bool strToPosDouble(const char *str, double *num, double min);
-//! Gets a valid positive double input from the user.  Primarily for retrieving
-//! money.
+bool strToCents(const char *str, Cents *cents, Cents min);
+//! Gets a valid amount of money above a minimum from the user.
 /*!
-  \param num the location of the double to write into
+  \param cents the location of the cents to write into
   \param prompt the original user prompt
   \param error the error and follow-up prompt
-  \param min the minimum acceptable number
+  \param min the amount, in cents, the result must be above
+ */
+void getPosCents(Cents *cents, const char *prompt, const char *error,
+                 Cents min);
+//! Calculates the credit card processing fee on a donation.
+/*!
+  \param donation the amount donated
+  \return the fee, rounded half up to the cent
+ */
+Cents feeOf(Cents donation);
+//! Formats cents as dollars and cents, e.g. 123456 as "1234.56", without
+//! going through floating point or printf.
+/*!
+  \param cents the amount to format
+  \param buffer a string of at least MONEY_STRING_SIZE to write into
+  \return the length of the formatted amount
  */
-void getPosDouble(double *num, const char *prompt, const char *error,
-                  double min);
+size_t formatCents(Cents cents, char *buffer);
 
 //## Donation input toolchain
 //! Determines if a string is a donation amount.
@@ -332,113 +870,846 @@ void getPosDouble(double *num, const char *prompt, const char *error,
   \return Whether or not the string is a valid donation amount
  */
 bool isDonation(const char *donation);
+//! The original isDonation(), which lowercases a copy of the string. Kept to
+//! check and benchmark isDonation() against.
+/*!
+  \param donation the string to validate, shorter than STRING_SIZE
+  \return Whether or not the string is a valid donation amount
+ */
+bool isDonationByScans(const char *donation);
 //! Gets a valid donation from the user.
 /*!
-  \param donation the address of the double to write the donation into
+  \param donation the address of the cents to write the donation into
  */
-void getDonation(double *donation);
+void getDonation(Cents *donation);
 
 //## Linked list functions
+//! Initializes an empty organization list and its index.
+/*!
+  \param listPtr the list to initialize
+ */
+void initOrgList(OrgList *listPtr);
 //! Empties a list of all nodes and frees all memory allocated for it from the heap.
 /*!
-  \param headPtr the location of the head of the linked list
+  \param listPtr the list to empty, including its index
  */
-void emptyList(OrgNode **headPtr);
-//! Inserts an organization into a linked list in alphabetical order of name.
+void emptyList(OrgList *listPtr);
+//! Allocates a node whose organization the caller fills in place before
+//! linking it with linkOrgNode().
 /*!
-  \param headPtr the location of the head of the linked list
+  \param listPtr the list the node will be linked into
+  \return the new node, or NULL if there was not enough memory
+ */
+OrgNode *newOrgNode(OrgList *listPtr);
+//! Links a filled node into a linked list in alphabetical order of name.
+/*!
+  \param listPtr the list to link into, whose index is kept in sync
+  \param newNodePtr a node from newOrgNode() whose org has been filled
+ */
+void linkOrgNode(OrgList *listPtr, OrgNode *newNodePtr);
+//! Inserts a copy of an organization into a linked list in alphabetical order
+//! of name, lowercasing both names at every step, as before the folded keys.
+//! Kept to benchmark newOrgNode() and linkOrgNode() against.
+/*!
+  \param listPtr the list to insert into, whose index is kept in sync
   \param org the organization to insert to the list
  */
-void insertOrgToList(OrgNode **headPtr, Organization org);
+void insertOrgToListByCopy(OrgList *listPtr, Organization org);
+//! Attaches a node after another node, or at the head, and indexes it.
+/*!
+  \param listPtr the list to attach to
+  \param newNodePtr the node to attach, whose key has been folded
+  \param prevNodePtr the node to attach after, or NULL for the head
+ */
+void attachOrgNode(OrgList *listPtr, OrgNode *newNodePtr, OrgNode *prevNodePtr);
+//! Finds the node an organization is stored in.
+/*!
+  \param org an organization in a list node
+  \return the node holding the organization
+ */
+OrgNode *nodeOfOrg(Organization *org);
 //! Print the contents of a  linked list.
 /*!
   \param headPtr the location of the head of the linked list
  */
 void printListContents(OrgNode **headPtr);
 //! Selects an organization from a linked list given it's name
+/*!
+  \param orgPtr the pointer to point to the org whose name is name
+  \param listPtr the list to select from, using its index
+  \param name the name to select for in the list
+ */
+void selectOrgFromList(Organization **orgPtr, OrgList *listPtr, const char *name);
+//! Selects an organization by walking the whole list, as before the index.
+//! Kept to benchmark the index against.
 /*!
   \param orgPtr the pointer to point to the org whose name is name
   \param headPtr the location of the head of the linked list
   \param name the name to select for in the list
  */
-void selectOrgFromList(Organization **orgPtr, OrgNode **headPtr, const char *name);
+void selectOrgFromListByScan(Organization **orgPtr, OrgNode **headPtr,
+                             const char *name);
 //! Selects a valid organization from a linked list given user input.
 /*!
   \param orgPtr the org which will contain a valid, selected org
-  \param headPtr the location of the head of the linked list
+  \param listPtr the list to select from
+ */
+void selectValidOrgFromList(Organization **orgPtr, OrgList *listPtr);
+
+//## Hash index functions
+//! Lowercases a name into a key and hashes the key in the same pass.
+/*!
+  \param name the name to fold
+  \param key the string to write the lowercase name into
+  \param hashPtr the address to write the 64-bit FNV-1a hash of the key into
+  \return the length of the key
+ */
+size_t foldKey(const char *name, char key[STRING_SIZE], uint64_t *hashPtr);
+//! Makes sure an index has room for one more node, growing it if needed.
+/*!
+  \param indexPtr the index to grow
+  \return whether or not there was enough memory
+ */
+bool reserveIndexSlot(OrgIndex *indexPtr);
+//! Adds a node to an index, replacing any node with the same name.
+/*!
+  \param indexPtr the index to add to
+  \param nodePtr the node to add
+  \pre reserveIndexSlot() succeeded for this insertion
+ */
+void indexOrgNode(OrgIndex *indexPtr, OrgNode *nodePtr);
+//! Finds the node whose organization has a given name, ignoring case.
+/*!
+  \param indexPtr the index to search
+  \param name the name to find
+  \return the node, or NULL if no organization has the name
+ */
+OrgNode *findIndexedOrg(const OrgIndex *indexPtr, const char *name);
+//! Frees an index's slots and leaves it empty.
+/*!
+  \param indexPtr the index to clear
  */
-void selectValidOrgFromList(Organization **orgPtr, OrgNode **headPtr);
+void clearOrgIndex(OrgIndex *indexPtr);
 
 //## Modes
 //! Sets up an org linked list with user input.
 /*!
-  \param headPtr the pointer to the head of the linked list to fill
+  \param listPtr the list to fill
   \return a mode flag
  */
-int setUp(OrgNode **headPtr);
+int setUp(OrgList *listPtr);
 //! Have a user donate an organization.
 /*!
-  \param headPtr the pointer to the head of the linked list to donate to\
+  \param listPtr the list of organizations to donate to
   \param currOrgPtr the pointer to the current org the program is donating to /
                     using for credentials
   \param donor the pointer to a donor struct to track donors
   \return a mode flag
  */
-int donate(OrgNode **headPtr, Organization **currOrgPtr, Donor *donor);
-//! Enter the reports mode which prints out organization details and ends the
-//! program.
+int donate(OrgList *listPtr, Organization **currOrgPtr, Donor *donor);
+//! Enter the reports mode which prints out organization details, then the
+//! totals and top organizations from columns copied during the same walk,
+//! and ends the program.
 /*!
-  \param headPtr the pointer to the head of the linked list to donate to\
+  \param listPtr the list of organizations to report on
   \param currOrgPtr the pointer to the current org the program is using for 
                     credentials
   \return a mode flag
  */
-int report(OrgNode **headPtr, Organization **currOrgPtr);
+int report(OrgList *listPtr, Organization **currOrgPtr);
 
+//## Snapshots
+//! Saves an org list to a snapshot file, replacing it only once the whole
+//! snapshot has been written.
+/*!
+  \param listPtr the list to save
+  \param path the snapshot file
+  \return whether or not the snapshot was saved
+ */
+bool saveSnapshot(const OrgList *listPtr, const char *path);
+//! Maps a snapshot file and uses its nodes and index in place. The stored
+//! pointers are checked against the mapping before any of them are used,
+//! and moved if the snapshot cannot be mapped at its base address.
+/*!
+  \param listPtr an empty list to load into
+  \param path the snapshot file
+  \return whether or not the snapshot was loaded
+ */
+bool loadSnapshot(OrgList *listPtr, const char *path);
+//! Checks whether a snapshot header describes a file this program can use.
+/*!
+  \param headerPtr the header
+  \param fileSize the size of the file the header came from
+  \return whether or not the header is valid
+ */
+bool isValidSnapshotHeader(const SnapshotHeader *headerPtr, size_t fileSize);
+//! Checks that every pointer stored in a mapped snapshot is one the header
+//! allows: each index slot is empty or points at the start of a node, each
+//! node points at the node after it and no node has receipts.
+//! Every node must also pass isValidSnapshotNode().
+/*!
+  \param headerPtr the header, already checked by isValidSnapshotHeader()
+  \param mapBytes the mapped file
+  \return whether or not the stored pointers and nodes are valid
+ */
+bool isValidSnapshotImage(const SnapshotHeader *headerPtr, const char *mapBytes);
+//! Checks that a mapped node's strings all end within their arrays and that
+//! its folded key, key length and key hash are the ones foldKey() gives for
+//! its name, so lookups and prints never read past the node.
+/*!
+  \param nodePtr the node in the mapped file
+  \return whether or not the node's strings and key are valid
+ */
+bool isValidSnapshotNode(const OrgNode *nodePtr);
+//! Multiplies two sizes unless the product would overflow.
+/*!
+  \param size1 the first size
+  \param size2 the second size
+  \param productPtr where the product is stored
+  \return whether or not the product fit
+ */
+bool multiplySizes(uint64_t size1, uint64_t size2, uint64_t *productPtr);
+//! Checks whether memory is part of a list's snapshot mapping.
+/*!
+  \param listPtr the list
+  \param ptr the memory
+  \return whether or not the memory is in the snapshot
+ */
+bool isInSnapshot(const OrgList *listPtr, const void *ptr);
 
-int main(void)
-{
-    OrgNode *headPtr = NULL;
-    Organization *currOrgPtr;
+//## Receipt writer
+//! Starts a receipt writer and its thread.
+/*!
+  \param writerPtr the writer to start
+  \return whether or not the thread could be started
+ */
+bool startReceiptWriter(ReceiptWriter *writerPtr);
+//! Formats a receipt into its organization's buffer, handing the buffer to
+//! the writer thread when it is full.
+/*!
+  \param writerPtr the writer
+  \param nodePtr the node of the organization donated to
+  \param donation the amount donated
+  \return whether or not there was memory for the organization's buffer
+ */
+bool queueReceipt(ReceiptWriter *writerPtr, OrgNode *nodePtr, Cents donation);
+//! Gives a buffer's filled half to the writer thread, first waiting for it to
+//! finish writing the other half if it has not.
+/*!
+  \param writerPtr the writer
+  \param bufferPtr the buffer to hand off
+ */
+void handOffReceipts(ReceiptWriter *writerPtr, ReceiptBuffer *bufferPtr);
+//! The writer thread: writes queued buffers until the writer is stopped and
+//! nothing is left in the queue.
+/*!
+  \param writerArgPtr the writer
+  \return 0
+ */
+int receiptWriterThread(void *writerArgPtr);
+//! Appends a buffer's handed off half to its file, keeping the file open
+//! while fewer than RECEIPT_MAX_OPEN_FILES are.
+/*!
+  \param writerPtr the writer
+  \param bufferPtr the buffer to write
+  \return whether or not the write succeeded
+ */
+bool writeReceipts(ReceiptWriter *writerPtr, ReceiptBuffer *bufferPtr);
+//! Hands off every partly filled buffer, waits for the thread to write them
+//! and frees the writer's buffers and files.
+/*!
+  \param writerPtr the writer to stop
+  \return whether or not every receipt was written
+ */
+bool stopReceiptWriter(ReceiptWriter *writerPtr);
+//! Gets the time stamp for a receipt, formatting it only once per second.
+/*!
+  \param writerPtr the writer which caches the time stamp
+  \return the formatted time stamp
+ */
+const char *receiptTimeStamp(ReceiptWriter *writerPtr);
 
-    // Ignore this for now: it is an unused variable used to allow donations to 
-    // run when donors are not tracked for the moment.
-    Donor dummyDonor;
+//## Donation log
+//! Opens a donation log, replaying it into an empty list to rebuild every
+//! organization and its counters, and starts its commit thread. A torn or
+//! corrupt tail left by a crash is cut off.
+/*!
+  \param logPtr the log to open
+  \param listPtr an empty list to replay into, which logs to this log from
+                 then on
+  \param path the log file, created if it does not exist
+  \param groupSize the number of records to sync together
+  \param maxDelayMicros the longest a record waits for its group to fill
+  \return whether or not the log could be replayed and opened
+ */
+bool openDonationLog(DonationLog *logPtr, OrgList *listPtr, const char *path,
+                     size_t groupSize, long maxDelayMicros);
+//! Rebuilds organizations and their counters from the records of a log
+//! file, stopping at the first record which is incomplete or corrupt.
+/*!
+  \param logPtr the log, whose file is open
+  \param listPtr the empty list to rebuild
+  \param fileSize the size of the log file
+  \return the size of the records which were intact, or 0 if the file is
+          not a donation log or memory ran out
+ */
+size_t replayDonationLog(DonationLog *logPtr, OrgList *listPtr,
+                         size_t fileSize);
+//! Appends a new organization to the log and gives it its log number.
+/*!
+  \param logPtr the log
+  \param nodePtr the node of the new organization
+  \return the record's sequence number to wait for with waitForLogCommit()
+ */
+uint64_t logOrg(DonationLog *logPtr, OrgNode *nodePtr);
+//! Appends a donation to the log.
+/*!
+  \param logPtr the log
+  \param nodePtr the node of the organization donated to
+  \param donation the amount donated
+  \return the record's sequence number to wait for with waitForLogCommit()
+ */
+uint64_t logDonation(DonationLog *logPtr, const OrgNode *nodePtr,
+                     Cents donation);
+//! Checksums a record and copies it and its payload into the log's buffer,
+//! waking the commit thread once a group is waiting.
+/*!
+  \param logPtr the log
+  \param recordPtr the record, whose checksum is filled in
+  \param payload the bytes which follow the record, or NULL
+  \param payloadSize the number of bytes in payload
+  \return the record's sequence number, or LOG_FAILED_SEQUENCE if the log
+          has failed and the record was not appended
+ */
+uint64_t appendLogRecord(DonationLog *logPtr, LogRecord *recordPtr,
+                         const void *payload, size_t payloadSize);
+//! Waits until a record has been synced to disk.
+/*!
+  \param logPtr the log
+  \param sequence the record's sequence number
+  \return whether or not the record is durable
+ */
+bool waitForLogCommit(DonationLog *logPtr, uint64_t sequence);
+//! The commit thread: writes and syncs groups of records until the log is
+//! closed and every record has been committed.
+/*!
+  \param logArgPtr the log
+  \return 0
+ */
+int donationLogThread(void *logArgPtr);
+//! Calculates a record's checksum, a 64-bit FNV-1a over the words of the
+//! record after the checksum and of its payload.
+/*!
+  \param recordPtr the record
+  \param payload the bytes which follow the record, or NULL
+  \param payloadSize the number of bytes in payload, a multiple of 8
+  \return the checksum
+ */
+uint64_t logChecksum(const LogRecord *recordPtr, const void *payload,
+                     size_t payloadSize);
+//! Commits every record and closes a log.
+/*!
+  \param logPtr the log to close
+  \return whether or not every record was committed
+ */
+bool closeDonationLog(DonationLog *logPtr);
 
-    // new main loop
-    int currFlag = SETUP_MODE_FLAG;
-    
-    // iterate at least one until the program ends
-    do {
-        // find run each mode and go to the mode which its return value
-        // indicates with a flag
-        switch (currFlag) {
-          case SETUP_MODE_FLAG:
-            currFlag = setUp(&headPtr);
-            break;
-        
-          case DONATIONS_MODE_FLAG:
-            currFlag = donate(&headPtr, &currOrgPtr, &dummyDonor);
-            break;
+//## Donation engine
+//! Starts a pool of donation workers.
+/*!
+  \param enginePtr the engine to start
+  \param numWorkers the number of workers, from 1 to ENGINE_MAX_WORKERS
+  \return whether or not every worker could be started
+ */
+bool startDonationEngine(DonationEngine *enginePtr, size_t numWorkers);
+//! Queues a donation for the worker which owns the organization. Safe to
+//! call from any number of threads.
+/*!
+  \param enginePtr the engine
+  \param nodePtr the node of the organization donated to
+  \param donation the amount donated
+ */
+void submitDonation(DonationEngine *enginePtr, OrgNode *nodePtr,
+                    Cents donation);
+//! Adds a task to a worker's queue without locking.
+/*!
+  \param workerPtr the worker
+  \param task the task
+  \return whether or not there was room in the queue
+ */
+bool tryPushDonationTask(DonationWorker *workerPtr, DonationTask task);
+//! Adds a task to a worker's queue, waiting for room if it is full, and
+//! wakes the worker if it is sleeping.
+/*!
+  \param workerPtr the worker
+  \param task the task
+ */
+void pushDonationTask(DonationWorker *workerPtr, DonationTask task);
+//! Wakes a worker if it is sleeping on an empty queue.
+/*!
+  \param workerPtr the worker
+ */
+void wakeDonationWorker(DonationWorker *workerPtr);
+//! Puts a worker to sleep until a task is pushed or the engine is stopped,
+//! unless one already has been. Only the worker may call this.
+/*!
+  \param workerPtr the worker
+ */
+void sleepDonationWorker(DonationWorker *workerPtr);
+//! Takes the next task from a worker's queue. Only the worker may call this.
+/*!
+  \param workerPtr the worker
+  \param taskPtr the address to write the task into
+  \return whether or not there was a task
+ */
+bool popDonationTask(DonationWorker *workerPtr, DonationTask *taskPtr);
+//! Checks for a task without taking it. Only the worker may call this.
+/*!
+  \param workerPtr the worker
+  \return whether or not there is a task
+ */
+bool hasDonationTask(const DonationWorker *workerPtr);
+//! A worker thread: applies donations until the engine is stopped and its
+//! queue is empty. A worker whose queue stays empty for ENGINE_IDLE_SPINS
+//! polls sleeps until a task is pushed, and a worker paused for a snapshot
+//! sleeps until the snapshot has been copied.
+/*!
+  \param workerArgPtr the worker
+  \return 0
+ */
+int donationWorkerThread(void *workerArgPtr);
+//! Takes a consistent snapshot of every organization's counters. Each worker
+//! pauses once it has applied everything queued before the snapshot, and the
+//! counters are copied while they all are paused.
+/*!
+  \param enginePtr the engine
+  \param listPtr the list of organizations
+  \param totals the array to copy counters into, in list order, with room
+                for every organization
+  \return the number of organizations copied
+ */
+size_t snapshotDonationEngine(DonationEngine *enginePtr, const OrgList *listPtr,
+                              OrgTotals totals[]);
+//! Copies every organization's counters, in list order.
+/*!
+  \param listPtr the list of organizations
+  \param totals the array to copy into
+  \return the number of organizations copied
+ */
+size_t copyOrgTotals(const OrgList *listPtr, OrgTotals totals[]);
+//! Waits for every queued donation to be applied and stops the workers.
+/*!
+  \param enginePtr the engine to stop
+ */
+void stopDonationEngine(DonationEngine *enginePtr);
 
-          case REPORT_MODE_FLAG:
-            currFlag = report(&headPtr, &currOrgPtr);
-            break;
-        
-          default:
-            currFlag = END_PROGRAM_FLAG;
-            puts(MODE_ERROR);
-            break;
-        } // flag switch
-    } while (currFlag != END_PROGRAM_FLAG);
+//## Columnar report
+//! Makes sure the last block of a set of columns has a free row, adding a
+//! block if it is full.
+/*!
+  \param columnsPtr the columns
+  \return whether or not there was memory for the row
+ */
+bool reserveOrgColumnRow(OrgColumns *columnsPtr);
+//! Copies an organization's goal and totals into the next row of a set of
+//! columns.
+/*!
+  \param columnsPtr the columns
+  \param nodePtr the node of the organization
+  \return whether or not there was memory for the row
+ */
+bool addOrgColumnRow(OrgColumns *columnsPtr, const OrgNode *nodePtr);
+//! Frees every block of a set of columns.
+/*!
+  \param columnsPtr the columns to free
+ */
+void freeOrgColumns(OrgColumns *columnsPtr);
+//! Totals every column. Each total is its own pass over one array of a
+//! block, which the compiler can vectorize.
+/*!
+  \param columnsPtr the columns
+  \param totalsPtr the totals to write into
+ */
+void totalOrgColumns(const OrgColumns *columnsPtr, ReportTotals *totalsPtr);
+//! Calculates how far every organization is towards its goal.
+/*!
+  \param columnsPtr the columns
+  \param percents the array to write each row's percent of goal into
+ */
+void percentOfGoal(const OrgColumns *columnsPtr, double percents[]);
+//! Finds the organizations which raised the most.
+/*!
+  \param columnsPtr the columns
+  \param numTop the most organizations to find
+  \param top the array to write them into, most raised first
+  \return the number of organizations found
+ */
+size_t topOrgsByRaised(const OrgColumns *columnsPtr, size_t numTop,
+                       TopOrg top[]);
+//! Offers an organization to a min-heap of the most raised so far.
+/*!
+  \param heap the heap, whose first element raised the least
+  \param heapSizePtr the number of organizations in the heap
+  \param numTop the most organizations the heap may hold
+  \param candidate the organization offered
+ */
+void offerTopOrg(TopOrg heap[], size_t *heapSizePtr, size_t numTop,
+                 TopOrg candidate);
+//! Checks whether one ranked organization comes before another, by amount
+//! raised and then by their order in the list.
+/*!
+  \param org1 the first organization
+  \param org2 the second organization
+  \return whether or not org1 ranks above org2
+ */
+bool ranksAbove(TopOrg org1, TopOrg org2);
+//! Compares two ranked organizations for qsort(), highest rank first.
+/*!
+  \param org1Ptr the first organization
+  \param org2Ptr the second organization
+  \return a negative number if the first ranks above the second, positive
+           if below and 0 if they are the same
+ */
+int compareTopOrgs(const void *org1Ptr, const void *org2Ptr);
+//! Prints the totals, the number of organizations at their goal and the top
+//! organizations with their percent of goal.
+/*!
+  \param stream the stream to print to
+  \param totalsPtr the totals
+  \param top the top organizations
+  \param numTop the number of top organizations
+ */
+void fPrintColumnReport(FILE *stream, const ReportTotals *totalsPtr,
+                        const TopOrg top[], size_t numTop);
+//! Totals a set of columns and prints them with their top organizations.
+/*!
+  \param stream the stream to print to
+  \param columnsPtr the columns
+  \param numTop the most organizations to rank
+  \return whether or not there was memory for the ranking
+ */
+bool fPrintOrgReport(FILE *stream, const OrgColumns *columnsPtr,
+                     size_t numTop);
 
-    // old main loop
-    // // run a loop until the program ends
-    // bool endProgram = false;
-    // while (!endProgram) {
-    //     // track the output of donation modes to see if the report mode
-    //     // should be entered
-    //     int donationSuccess = donate(&org, &dummyDonor);
+//## Batch mode
+//! Replays org and donation records from a CSV or TSV file, or stdin, and
+//! writes receipts and summaries as the interactive modes would.
+/*!
+  \param path the file to read, or BATCH_STDIN_PATH for stdin
+  \param numThreads the number of donation engine workers, or 0 to apply
+                    donations on the reading thread
+  \return EXIT_SUCCESS or EXIT_FAILURE
+ */
+int runBatchMode(const char *path, size_t numThreads);
+//! Reads a stream in large blocks and hands each complete line, terminated in
+//! place, to processBatchLine().
+/*!
+  \param stream the stream to read
+  \param runPtr the run the records apply to
+  \return whether or not the whole stream was read
+ */
+bool ingestBatch(FILE *stream, BatchRun *runPtr);
+//! Splits one line into fields and applies it, skipping blank lines and
+//! comments. The first record decides whether fields are tab or comma
+//! separated.
+/*!
+  \param line the line, which is split in place
+  \param lineNum the line's number for error messages
+  \param runPtr the run the record applies to
+ */
+void processBatchLine(char *line, size_t lineNum, BatchRun *runPtr);
+//! Splits a line into fields by ending each one in place, without copying.
+/*!
+  \param line the line to split
+  \param separator the character between fields
+  \param fields the array to point at each field
+  \param maxFields the size of fields
+  \return the number of fields, or maxFields + 1 if there were too many
+ */
+size_t splitFields(char *line, char separator, char *fields[], size_t maxFields);
+//! Registers an organization from an org record.
+/*!
+  \param listPtr the list to register in
+  \param fields org, name, goal, purpose, owner name, email and password
+  \return NULL on success, otherwise what was wrong with the record
+ */
+const char *batchRegisterOrg(OrgList *listPtr, char *fields[]);
+//! Applies a donation record, appending a receipt if it asks for one.
+/*!
+  \param runPtr the run the record applies to
+  \param fields donation, org name, amount, donor name, zip and optionally
+                (y)es or (n)o for a receipt
+  \param numFields the number of fields
+  \return NULL on success, otherwise what was wrong with the record
+ */
+const char *batchDonate(BatchRun *runPtr, char *fields[], size_t numFields);
+//! Counts a rejected record and reports it, up to a limit.
+/*!
+  \param statsPtr the counts to update
+  \param lineNum the record's line number
+  \param error what was wrong with the record
+ */
+void rejectBatchRecord(BatchStats *statsPtr, size_t lineNum, const char *error);
+//! Writes a generated batch to stdout for testing the batch mode.
+/*!
+  \param numOrgs the number of org records
+  \param numDonations the number of donation records
+ */
+void makeBatch(size_t numOrgs, size_t numDonations);
+
+//## Command line modes and benchmarks
+//! Runs the mode named by the command line arguments instead of the prompts.
+/*!
+  \param argc the number of arguments
+  \param argv the arguments
+  \return EXIT_SUCCESS or EXIT_FAILURE
+ */
+int runCommandLineMode(int argc, char *argv[]);
+//! Reads a monotonic clock for timing benchmarks.
+/*!
+  \return the current time in seconds
+ */
+double secondsNow(void);
+//! Fills an organization with generated benchmark data.
+/*!
+  \param org the organization to fill
+  \param orgNum the number which makes the organization's name unique
+ */
+void fillBenchOrg(Organization *org, size_t orgNum);
+//! Times selecting organizations by scanning the list and by the hash index.
+/*!
+  \param numOrgs the number of organizations to register
+  \return whether or not both ways selected the same organizations
+ */
+bool benchmarkOrgIndex(size_t numOrgs);
+//! Times bulk registration by copying organizations into nodes and by
+//! building them in place, once in descending and once in shuffled order.
+/*!
+  \param numOrgs the number of organizations to register
+  \return whether or not both ways built the same lists
+ */
+bool benchmarkOrgInsert(size_t numOrgs);
+//! Checks that two lists hold the same names in the same order and that
+//! every name in the second can be found through its index.
+/*!
+  \param list1Ptr the first list
+  \param list2Ptr the second list
+  \return whether or not the lists match
+ */
+bool sameOrgLists(const OrgList *list1Ptr, const OrgList *list2Ptr);
+//! Times writing receipts by opening each organization's file for every
+//! receipt and through the receipt writer.
+/*!
+  \param numReceipts the number of receipts to write each way
+  \return whether or not both ways wrote the same receipts
+ */
+bool benchmarkReceipts(size_t numReceipts);
+//! Checks that the first and second halves of every receipt file of a
+//! list's organizations hold the same receipts.
+/*!
+  \param listPtr the list of organizations
+  \return whether or not every file's halves match, ignoring time stamps
+ */
+bool receiptFileHalvesMatch(const OrgList *listPtr);
+//! Compares two runs of receipt text, skipping the time stamp on each date
+//! line since the minute can change between them.
+/*!
+  \param text1 the first receipts
+  \param text2 the second receipts
+  \param length the length of both runs in bytes
+  \return whether or not the receipts match
+ */
+bool sameReceiptText(const char *text1, const char *text2, size_t length);
+//! Times saving and loading a snapshot against building the list again, and
+//! checks that the loaded list matches.
+/*!
+  \param numOrgs the number of organizations to save
+  \return whether or not the loaded list matched
+ */
+bool benchmarkSnapshot(size_t numOrgs);
+//! Times donations applied directly on one thread and through the donation
+//! engine with 1 to maxThreads workers and as many donor sessions, and
+//! checks the engine's totals and a snapshot taken while it runs.
+/*!
+  \param maxThreads the most workers and sessions to run
+  \param numDonations the number of donations for each run
+  \return whether or not every check passed
+ */
+bool benchmarkDonationEngine(size_t maxThreads, size_t numDonations);
+//! Times summing donations and fees in doubles, as the tracker used to, and
+//! in cents, measures how far the doubles drift from the exact cents, and
+//! times formatting amounts with printf and formatCents().
+/*!
+  \param numDonations the number of donations to sum
+  \return whether or not the cents sums are exact
+ */
+bool benchmarkMoney(size_t numDonations);
+//! Builds organizations with donations and times a report of totals, percent
+//! of goal and the top organizations read from the list nodes, and from
+//! columns copied from the nodes, checking that both agree.
+/*!
+  \param numOrgs the number of organizations to build
+  \param numTop the number of top organizations to report
+  \return whether or not both reports agree
+ */
+bool benchmarkReport(size_t numOrgs, size_t numTop);
+//! Runs every validator and its original version on random and mutated
+//! strings and reports any string they disagree on.
+/*!
+  \param numCases the number of strings to try
+  \return whether or not every pair agreed on every string
+ */
+bool fuzzValidators(size_t numCases);
+//! Times every validator against its original version on a corpus of
+//! strings like the ones fuzzValidators() makes.
+/*!
+  \param numValidations the number of strings each validator checks
+  \return whether or not every pair accepted the same strings
+ */
+bool benchmarkValidators(size_t numValidations);
+//! Writes a random string for the validators to check. Half are a valid
+//! example with a few characters replaced, inserted or deleted.
+/*!
+  \param buffer a zeroed string of at least STRING_SIZE to write into
+  \param seedPtr the random number generator's state
+ */
+void makeFuzzString(char *buffer, unsigned int *seedPtr);
+//! Times durable donations through the donation log, with a group of
+//! donors waiting on each commit, at group sizes from 1 to 4096, and
+//! checks that replaying each log rebuilds the same totals.
+/*!
+  \param numDonations the number of donations for each group size
+  \param maxDelayMicros the log's latency bound
+  \return whether or not every replayed log matched
+ */
+bool benchmarkDonationLog(size_t numDonations, long maxDelayMicros);
+//! Times writing a donation log of numRecords records and replaying it, and
+//! checks that a torn last record is cut off on replay.
+/*!
+  \param numRecords the number of records to log
+  \return whether or not the replayed totals matched and the torn record
+          was cut off
+ */
+bool benchmarkRecovery(size_t numRecords);
+//! Checks that two lists hold the same organizations with the same
+//! donation counters, in the same order.
+/*!
+  \param list1Ptr the first list
+  \param list2Ptr the second list
+  \return whether or not the totals match
+ */
+bool sameOrgTotals(const OrgList *list1Ptr, const OrgList *list2Ptr);
+//! Fills a list with benchmark organizations, logging each to the list's
+//! log, and returns their nodes in an array for picking them at random.
+/*!
+  \param listPtr the list, which logs to a donation log
+  \param numOrgs the number of organizations
+  \return the array of nodes, to be freed, or NULL if memory ran out
+ */
+OrgNode **fillLoggedBenchList(OrgList *listPtr, size_t numOrgs);
+//! A benchmark donor session: submits its share of donations to random orgs.
+/*!
+  \param sessionArgPtr the session's arguments
+  \return 0
+ */
+int donationSessionThread(void *sessionArgPtr);
+
+
+int main(int argc, char *argv[])
+{
+    OrgList orgList;
+    initOrgList(&orgList);
+    Organization *currOrgPtr;
+    int exitStatus = EXIT_SUCCESS;
+
+    // Ignore this for now: it is an unused variable used to allow donations to 
+    // run when donors are not tracked for the moment.
+    Donor dummyDonor;
+
+    // new main loop, skipped when a command line mode was given
+    int currFlag = SETUP_MODE_FLAG;
+    const char *snapshotPath = NULL;
+    DonationLog donationLog;
+
+    // start from a snapshot if one was saved, and save one on exit
+    if (argc == 3 && strcmp(argv[1], SNAPSHOT_ARG) == 0) {
+        snapshotPath = argv[2];
+
+        if (access(snapshotPath, F_OK) == 0) {
+            if (!loadSnapshot(&orgList, snapshotPath)) {
+                currFlag = END_PROGRAM_FLAG;
+                snapshotPath = NULL;
+                exitStatus = EXIT_FAILURE;
+            } else if (orgList.headPtr != NULL) {
+                currFlag = DONATIONS_MODE_FLAG;
+            }
+        }
+    } else if (argc >= 3 && argc <= 5 && strcmp(argv[1], LOG_ARG) == 0) {
+        // rebuild the orgs and their totals from the log, and log to it
+        size_t groupSize = LOG_DEFAULT_GROUP_SIZE;
+        long maxDelayMicros = LOG_DEFAULT_MAX_DELAY_MICROS;
+        if (argc > 3) {
+            groupSize = strtoul(argv[3], NULL, 10);
+        }
+        if (argc > 4) {
+            maxDelayMicros = strtol(argv[4], NULL, 10);
+        }
+
+        if (maxDelayMicros < 0 ||
+                !openDonationLog(&donationLog, &orgList, argv[2], groupSize,
+                                 maxDelayMicros)) {
+            currFlag = END_PROGRAM_FLAG;
+            exitStatus = EXIT_FAILURE;
+        } else {
+            printf("Recovered %u organizations and %llu donations from %s.\n",
+                   donationLog.numOrgs,
+                   (unsigned long long) donationLog.replayedDonations, argv[2]);
+            if (donationLog.droppedBytes > 0) {
+                printf("Dropped %zu bytes of an incomplete record at its end.\n",
+                       donationLog.droppedBytes);
+            }
+            puts("");
+
+            if (orgList.headPtr != NULL) {
+                currFlag = DONATIONS_MODE_FLAG;
+            }
+        }
+    } else if (argc > 1) {
+        exitStatus = runCommandLineMode(argc, argv);
+        currFlag = END_PROGRAM_FLAG;
+    }
+    
+    // iterate until the program ends
+    while (currFlag != END_PROGRAM_FLAG) {
+        // find run each mode and go to the mode which its return value
+        // indicates with a flag
+        switch (currFlag) {
+          case SETUP_MODE_FLAG:
+            currFlag = setUp(&orgList);
+            break;
+        
+          case DONATIONS_MODE_FLAG:
+            currFlag = donate(&orgList, &currOrgPtr, &dummyDonor);
+            break;
+
+          case REPORT_MODE_FLAG:
+            currFlag = report(&orgList, &currOrgPtr);
+            break;
+        
+          default:
+            currFlag = END_PROGRAM_FLAG;
+            puts(MODE_ERROR);
+            break;
+        } // flag switch
+    } // main loop
+
+    // old main loop
+    // // run a loop until the program ends
+    // bool endProgram = false;
+    // while (!endProgram) {
+    //     // track the output of donation modes to see if the report mode
+    //     // should be entered
+    //     int donationSuccess = donate(&org, &dummyDonor);
 
     //     if (donationSuccess == MODE_SUCCESS_ADMIN) {
     //         // track the output of the report mode to see if the program 
@@ -451,10 +1722,18 @@ int main(void)
     //     }
     // }
 
+    if (snapshotPath != NULL && !saveSnapshot(&orgList, snapshotPath)) {
+        exitStatus = EXIT_FAILURE;
+    }
+
+    if (orgList.logPtr != NULL && !closeDonationLog(orgList.logPtr)) {
+        exitStatus = EXIT_FAILURE;
+    }
+
     // empty the list
-    emptyList(&headPtr);
+    emptyList(&orgList);
 
-    return 0;
+    return exitStatus;
 } // main
 
 
@@ -512,30 +1791,71 @@ bool matchCredential(const char *cred, const char *prompt, const char
     return isValid;
 } // matchCredential
 
-void fPrintReceipt(FILE *stream, const Organization *org, double donation)
+void fPrintReceipt(FILE *stream, const Organization *org, Cents donation)
 {
     // create formatted timestamp
     char timeStamp[TIME_STAMP_SIZE];
     time_t time_var = time(NULL);
-    strftime(timeStamp, sizeof(timeStamp), "%D - %I:%M%p",
+    strftime(timeStamp, sizeof(timeStamp), TIME_STAMP_FORMAT,
                 localtime(&time_var));
 
+    char amount[MONEY_STRING_SIZE];
+    formatCents(donation, amount);
+
     // print the actual receipt
     fprintf(stream, "Organization: %s\n", org->name);
-    fprintf(stream, "Donation Amount: $%.2lf\n", donation);
-    fprintf(stream, "Donation Date: %s\n", timeStamp);
+    fprintf(stream, "Donation Amount: $%s\n", amount);
+    fprintf(stream, RECEIPT_DATE_LABEL "%s\n", timeStamp);
     fputs("\n", stream);
 } // fPrintReceipt
 
 void fPrintSummary(FILE *stream, const Organization *org)
 {
-    fprintf(stream, "Organization Name: %s\n", org->name);
-    fprintf(stream, "Total Number of Donations: %d\n", org->numDonations);
-    fprintf(stream, "Total amount raised: $%.2lf\n", org->donationSum);
-    fprintf(stream, "Total Credit Card processing: $%.2lf\n", org->feesSum);
-    fputs("\n", stream);
+    OrgTotals totals = {org->name, org->numDonations, org->numDonors,
+                        org->donationSum, org->feesSum};
+
+    fPrintTotals(stream, &totals);
 } // fPrintSummary
 
+void fPrintTotals(FILE *stream, const OrgTotals *totalsPtr)
+{
+    char raised[MONEY_STRING_SIZE];
+    char fees[MONEY_STRING_SIZE];
+    formatCents(totalsPtr->donationSum, raised);
+    formatCents(totalsPtr->feesSum, fees);
+
+    fprintf(stream, "Organization Name: %s\n", totalsPtr->name);
+    fprintf(stream, "Total Number of Donations: %d\n", totalsPtr->numDonations);
+    fprintf(stream, "Total amount raised: $%s\n", raised);
+    fprintf(stream, "Total Credit Card processing: $%s\n", fees);
+    fputs("\n", stream);
+} // fPrintTotals
+
+void initOrgTotals(Organization *org)
+{
+    // Initialize count and sum variables
+    org->numDonations = 0;
+    org->donationSum = 0;
+    org->numDonors = 0;
+    org->feesSum = 0;
+
+    // Generate the receipt's path and the org's url
+    generateUrl(org->url, org->name);
+    generateReceiptPath(org->receiptPath, org->name);
+} // initOrgTotals
+
+Cents addDonation(Organization *org, Cents donation)
+{
+    // track donations and fees
+    Cents fee = feeOf(donation);
+    org->feesSum += fee;
+    org->donationSum += donation - fee;
+
+    org->numDonations++;
+
+    return fee;
+} // addDonation
+
 int caselessStrcmp(const char *str1, const char *str2)
 {
     // create a lowercase version of each string
@@ -671,6 +1991,94 @@ void getValidatedWord(char *word, size_t wordSize, bool (*validate)(const char
 } // getValidatedWord
 
 bool isEmail(const char *email)
+{
+    const unsigned char *currCharPtr = (const unsigned char *) email;
+    const unsigned char *atSignPtr = NULL;
+    size_t numLetters = 0;
+
+    // read up to the first dot, noting the first @
+    while (*currCharPtr != '\0' && *currCharPtr != '.') {
+        if (*currCharPtr == '@' && atSignPtr == NULL) {
+            atSignPtr = currCharPtr;
+        }
+
+        currCharPtr++;
+    }
+    const unsigned char *dotPtr = currCharPtr;
+
+    // then the top-level domain, which must be letters up to the end
+    if (*dotPtr == '.') {
+        currCharPtr++;
+        while (numLetters <= TOP_LVL_DOMAIN_LEN &&
+                (CHAR_CLASSES[*currCharPtr] & CHAR_ALPHA) != 0) {
+            numLetters++;
+            currCharPtr++;
+        }
+    }
+
+    // the @ can't be first or right before the dot
+    return *dotPtr == '.' && numLetters == TOP_LVL_DOMAIN_LEN &&
+           *currCharPtr == '\0' &&
+           (size_t) (currCharPtr - (const unsigned char *) email) >= MIN_EMAIL_LEN &&
+           atSignPtr != NULL && atSignPtr != (const unsigned char *) email &&
+           atSignPtr + 1 != dotPtr;
+} // isEmail
+
+bool isPassword(const char *password)
+{
+    // Declare counts
+    unsigned int upperCount = 0;
+    unsigned int lowerCount = 0;
+    unsigned int numCount = 0;
+    unsigned int charCount = 0;
+
+    // count every character type with one lookup per character
+    for (const unsigned char *currCharPtr = (const unsigned char *) password;
+            *currCharPtr != '\0'; currCharPtr++) {
+        unsigned char charClass = CHAR_CLASSES[*currCharPtr];
+        upperCount += (charClass & CHAR_UPPER) != 0;
+        lowerCount += (charClass & CHAR_LOWER) != 0;
+        numCount += (charClass & CHAR_DIGIT) != 0;
+        charCount++;
+    }
+
+    return upperCount >= PWD_MIN_UPPER && lowerCount >= PWD_MIN_LOWER &&
+           numCount >= PWD_MIN_NUMS && charCount >= PWD_MIN_CHARS;
+} // isPassword
+
+bool isYesNo(const char *yesNo)
+{
+    // check if the string is caselessly equal to YES or NO
+    return isCaselessMatch(yesNo, YES) || isCaselessMatch(yesNo, NO);
+} // isYesNo
+
+bool isZip(const char *zip)
+{
+    size_t length = 0;
+
+    // stop at the first character which isn't a digit, or once the string
+    // is too long to be a zip code
+    while (length <= ZIP_SIZE &&
+            (CHAR_CLASSES[(unsigned char) zip[length]] & CHAR_DIGIT) != 0) {
+        length++;
+    }
+
+    // the first character can't be zero
+    return length == ZIP_SIZE && zip[ZIP_SIZE] == '\0' && zip[0] != '0';
+} // isZip
+
+bool isCaselessMatch(const char *str, const char *lowerStr)
+{
+    // walk both strings until they differ or one ends
+    while (*str != '\0' && tolower((unsigned char) *str) == *lowerStr) {
+        str++;
+        lowerStr++;
+    }
+
+    return *str == '\0' && *lowerStr == '\0';
+} // isCaselessMatch
+
+bool isEmailByScans(const char *email)
 {
     bool retVal = true;
 
@@ -717,9 +2125,9 @@ bool isEmail(const char *email)
     }
 
     return retVal;
-} // isEmail
+} // isEmailByScans
 
-bool isPassword(const char *password)
+bool isPasswordByScans(const char *password)
 {
     // Declare counts
     unsigned int upperCount = 0;
@@ -769,16 +2177,16 @@ bool isPassword(const char *password)
     }
 
     return isPasswordValid;
-} // isPassword
+} // isPasswordByScans
 
-bool isYesNo(const char *yesNo)
+bool isYesNoByScans(const char *yesNo)
 {
     // check if the string is caselessly equal to YES or NO
     return caselessStrcmp(yesNo, YES) == 0 ||
            caselessStrcmp(yesNo, NO) == 0;
-} // isYesNo
+} // isYesNoByScans
 
-bool isZip(const char *zip)
+bool isZipByScans(const char *zip)
 {
     bool isZipValid = true;
 
@@ -805,7 +2213,7 @@ bool isZip(const char *zip)
     }
 
     return isZipValid;
-} // isZip
+} // isZipByScans
 
 void getEmail(char *email, size_t emailSize)
 {
@@ -836,56 +2244,130 @@ void getZip(char *zip, size_t zipSize)
     getValidatedWord(zip, zipSize, &isZip, ZIP_PROMPT, ZIP_ERROR);
 } // getZip
 
-bool strToPosDouble(const char *str, double *num, double min)
+bool strToCents(const char *str, Cents *cents, Cents min)
 {
-    // vars for validation
-	char *end;
-	errno = 0;
-
-    bool isValid = false;
+    Cents centsTest = 0;
+    size_t numDigits = 0;
+    size_t numDecimals = 0;
+    bool isValid = true;
+    bool pastPoint = false;
+    bool roundUp = false;
+
+    // Accumulate the dollars and the first two decimals as whole cents
+    for (const char *charPtr = str; *charPtr != '\0' && isValid; charPtr++) {
+        if (isdigit((unsigned char) *charPtr)) {
+            if (!pastPoint || numDecimals < 2) {
+                centsTest = centsTest * 10 + (*charPtr - '0');
+                isValid = centsTest <= MAX_CENTS;
+            } else if (numDecimals == 2) {
+                roundUp = *charPtr >= '5';
+            }
 
-	double doubleTest = strtod(str, &end);
+            numDigits++;
+            if (pastPoint) {
+                numDecimals++;
+            }
+        } else if (*charPtr == '.' && !pastPoint) {
+            pastPoint = true;
+        } else {
+            isValid = false;
+        }
+    }
 
-    // Test for a successful conversion
-	if (end != str && '\0' == *end && !(doubleTest == HUGE_VAL &&
-            ERANGE == errno) && doubleTest > min) {
-        *num = doubleTest;
+    // Scale what was read to cents
+    for (size_t i = numDecimals; i < 2; i++) {
+        centsTest *= 10;
+    }
+    if (roundUp) {
+        centsTest++;
+    }
 
-        isValid = true;
-	}
+    isValid = isValid && numDigits > 0 && centsTest <= MAX_CENTS &&
+              centsTest > min;
+    if (isValid) {
+        *cents = centsTest;
+    }
 
     return isValid;
-} // strToDouble
+} // strToCents
 
-void getPosDouble(double *num, const char *prompt, const char *error,
-                  double min)
+void getPosCents(Cents *cents, const char *prompt, const char *error,
+                 Cents min)
 {
     printf("%s", prompt);
 
     // Set up input variables
     char word[STRING_SIZE];
     bool getWordSuccess = getWord(word, STRING_SIZE);
-    double doubleTest;
+    Cents centsTest;
 
     // Print errors until a valid word that also passes validate() is found
-    while (!getWordSuccess || !strToPosDouble(word, &doubleTest, min)) {
+    while (!getWordSuccess || !strToCents(word, &centsTest, min)) {
         printf("%s", error);
 
         getWordSuccess = getWord(word, STRING_SIZE);
     }
 
-    *num = doubleTest;
-} // getDouble
+    *cents = centsTest;
+} // getPosCents
+
+Cents feeOf(Cents donation)
+{
+    return (donation * FEE_PER_MILLE + FEE_DIVISOR / 2) / FEE_DIVISOR;
+} // feeOf
+
+size_t formatCents(Cents cents, char *buffer)
+{
+    char digits[MONEY_STRING_SIZE];
+    size_t numDigits = 0;
+    bool negative = cents < 0;
+
+    // write the digits backwards, padding to at least "0.00"
+    uint64_t remaining = negative ? -(uint64_t) cents : (uint64_t) cents;
+    while (remaining > 0 || numDigits < 3) {
+        digits[numDigits] = (char) ('0' + remaining % 10);
+        remaining /= 10;
+        numDigits++;
+    }
+
+    size_t length = 0;
+    if (negative) {
+        buffer[length] = '-';
+        length++;
+    }
+    while (numDigits > 0) {
+        numDigits--;
+        buffer[length] = digits[numDigits];
+        length++;
+
+        if (numDigits == 2) {
+            buffer[length] = '.';
+            length++;
+        }
+    }
+    buffer[length] = '\0';
+
+    return length;
+} // formatCents
 
 bool isDonation(const char *donation)
+{
+    // an amount above the minimum donation, or ADMIN_MODE in any case
+    Cents moneyNum;
+
+    return strToCents(donation, &moneyNum, MIN_DONATION) ||
+           isCaselessMatch(donation, ADMIN_MODE);
+} // isDonation
+
+bool isDonationByScans(const char *donation)
 {
     bool isValid = false;
 
-    // determine if the string is a double that is above the minimum donation
-    double moneyNum;
-    bool isDonationDouble = strToPosDouble(donation, &moneyNum, MIN_DONATION);
+    // determine if the string is an amount above the minimum donation
+    Cents moneyNum;
+    bool isDonationAmount = strToCents(donation, &moneyNum, MIN_DONATION);
     
-    if (isDonationDouble) {
+    if (isDonationAmount) {
         isValid = true;
     } else {
         // Test for ADMIN_MODE
@@ -898,9 +2380,9 @@ bool isDonation(const char *donation)
     }
 
     return isValid;
-} // isDonation
+} // isDonationByScans
 
-void getDonation(double *donation)
+void getDonation(Cents *donation)
 {    
     // get a valid donation string
     char rawDonation[STRING_SIZE];
@@ -916,31 +2398,87 @@ void getDonation(double *donation)
         *donation = ADMIN_NUM;
     } else {
         // set validnumbers
-        strToPosDouble(rawDonation, donation, MIN_DONATION);
+        strToCents(rawDonation, donation, MIN_DONATION);
     }
 } // getDonation
 
-void emptyList(OrgNode **headPtr)
+void initOrgList(OrgList *listPtr)
+{
+    listPtr->headPtr = NULL;
+    listPtr->index.slots = NULL;
+    listPtr->index.capacity = 0;
+    listPtr->index.count = 0;
+    listPtr->index.slotsMapped = false;
+    listPtr->snapshotPtr = NULL;
+    listPtr->snapshotSize = 0;
+    listPtr->logPtr = NULL;
+} // initOrgList
+
+void emptyList(OrgList *listPtr)
 {
     // set up node pointers for iteration
-    OrgNode *currNodePtr = *headPtr;
+    OrgNode *currNodePtr = listPtr->headPtr;
     OrgNode *nextNodePtr = NULL;
 
-    // free the current node until there are no nodes left
+    // free the current node until there are no nodes left, leaving nodes
+    // from a snapshot to be unmapped with it
     while (currNodePtr != NULL) {
         nextNodePtr = currNodePtr->nextNodePtr;
-        free(currNodePtr);
+        if (!isInSnapshot(listPtr, currNodePtr)) {
+            free(currNodePtr);
+        }
         currNodePtr = nextNodePtr;
     }
 
-    // set the head pointer to NULL
-    *headPtr = NULL;
+    // set the head pointer to NULL and drop every indexed node with it
+    listPtr->headPtr = NULL;
+    clearOrgIndex(&listPtr->index);
+
+    if (listPtr->snapshotPtr != NULL) {
+        munmap(listPtr->snapshotPtr, listPtr->snapshotSize);
+        listPtr->snapshotPtr = NULL;
+        listPtr->snapshotSize = 0;
+    }
 } // emptyList
 
-void insertOrgToList(OrgNode **headPtr, Organization org)
+OrgNode *newOrgNode(OrgList *listPtr)
+{
+    // attempt to allocate memory, making sure the index has room first
+    OrgNode *newNodePtr = NULL;
+    if (reserveIndexSlot(&listPtr->index)) {
+        newNodePtr = malloc(sizeof(OrgNode));
+    }
+
+    if (newNodePtr != NULL) {
+        newNodePtr->receiptsPtr = NULL;
+        newNodePtr->logNum = 0;
+    }
+
+    return newNodePtr;
+} // newOrgNode
+
+void linkOrgNode(OrgList *listPtr, OrgNode *newNodePtr)
+{
+    newNodePtr->keyLength = foldKey(newNodePtr->org.name, newNodePtr->key,
+                                    &newNodePtr->keyHash);
+
+    // initialize node pointers for iteration
+    OrgNode *prevNodePtr = NULL;
+    OrgNode *currNodePtr = listPtr->headPtr;
+
+    // iterate forward until the end of the list or the new org's key is
+    // lexicologically after the current org's key
+    while (currNodePtr != NULL && strcmp(newNodePtr->key, currNodePtr->key) > 0) {
+        prevNodePtr = currNodePtr;
+        currNodePtr = currNodePtr->nextNodePtr;
+    }
+
+    attachOrgNode(listPtr, newNodePtr, prevNodePtr);
+} // linkOrgNode
+
+void insertOrgToListByCopy(OrgList *listPtr, Organization org)
 {
-    // attempt to allocate memory
-    OrgNode *newNodePtr = malloc(sizeof(OrgNode));
+    OrgNode *newNodePtr = newOrgNode(listPtr);
 
     // test for the edge case in which the os cannot give enough memory for the
     // node
@@ -948,12 +2486,13 @@ void insertOrgToList(OrgNode **headPtr, Organization org)
         puts(MEM_ERROR);
     } else {
         // initialize newNode
-        newNodePtr->nextNodePtr = NULL;
         newNodePtr->org = org;
+        newNodePtr->keyLength = foldKey(org.name, newNodePtr->key,
+                                        &newNodePtr->keyHash);
 
         // initialize node pointers for iteration
         OrgNode *prevNodePtr = NULL;
-        OrgNode *currNodePtr = *headPtr;
+        OrgNode *currNodePtr = listPtr->headPtr;
 
         // iterate forward until the end of the list or the new pet's name
         // is lexicologically after the current pet's name
@@ -963,19 +2502,31 @@ void insertOrgToList(OrgNode **headPtr, Organization org)
             currNodePtr = currNodePtr->nextNodePtr;
         }
 
-        // assign new node pointer to the prevNode's nextPtr or headPtr
-        // depending on if the linked list is empty
-        if (prevNodePtr == NULL) {
-            *headPtr = newNodePtr;
-        } else {
-            prevNodePtr->nextNodePtr = newNodePtr;
-        }
+        attachOrgNode(listPtr, newNodePtr, prevNodePtr);
+    }
+} // insertOrgToListByCopy
 
-        // finally, reattach the follwoing nodes to the list by having the 
-        // newNode's nextPtr point to currNode
-        newNodePtr->nextNodePtr = currNodePtr;
+void attachOrgNode(OrgList *listPtr, OrgNode *newNodePtr, OrgNode *prevNodePtr)
+{
+    // assign new node pointer to the prevNode's nextPtr or headPtr
+    // depending on if the linked list is empty
+    if (prevNodePtr == NULL) {
+        newNodePtr->nextNodePtr = listPtr->headPtr;
+        listPtr->headPtr = newNodePtr;
+    } else {
+        newNodePtr->nextNodePtr = prevNodePtr->nextNodePtr;
+        prevNodePtr->nextNodePtr = newNodePtr;
     }
-} // insertPet
+
+    // the new node comes before any others with the same name, so it is
+    // the one a scan would select and the one the index should find
+    indexOrgNode(&listPtr->index, newNodePtr);
+} // attachOrgNode
+
+OrgNode *nodeOfOrg(Organization *org)
+{
+    return (OrgNode *) ((char *) org - offsetof(OrgNode, org));
+} // nodeOfOrg
 
 void printListContents(OrgNode **headPtr)
 {
@@ -993,15 +2544,30 @@ void printListContents(OrgNode **headPtr)
         while (currNode != NULL) {
             // print the current org's data
             Organization currOrg = currNode->org;
-            printf("%-20s\t$%-16.2f\t$%-16.2f\n", currOrg.name,
-                   currOrg.goalAmount, currOrg.donationSum);
+            char goal[MONEY_STRING_SIZE];
+            char raised[MONEY_STRING_SIZE];
+            formatCents(currOrg.goalAmount, goal);
+            formatCents(currOrg.donationSum, raised);
+            printf("%-20s\t$%-16s\t$%-16s\n", currOrg.name, goal, raised);
 
             currNode = currNode->nextNodePtr;
         }
     }
 } // printContents
 
-void selectOrgFromList(Organization **orgPtr, OrgNode **headPtr, const char *name)
+void selectOrgFromList(Organization **orgPtr, OrgList *listPtr, const char *name)
+{
+    OrgNode *foundNodePtr = findIndexedOrg(&listPtr->index, name);
+
+    if (foundNodePtr == NULL) {
+        *orgPtr = NULL;
+    } else {
+        *orgPtr = &(foundNodePtr->org);
+    }
+} // selectOrgFromList
+
+void selectOrgFromListByScan(Organization **orgPtr, OrgNode **headPtr,
+                             const char *name)
 {
     OrgNode *currNodePtr = *headPtr;
 
@@ -1015,97 +2581,243 @@ void selectOrgFromList(Organization **orgPtr, OrgNode **headPtr, const char *nam
     } else {
         *orgPtr = &(currNodePtr->org);
     }
-} // selectOrgFromList
+} // selectOrgFromListByScan
 
-void selectValidOrgFromList(Organization **orgPtr, OrgNode **headPtr)
+void selectValidOrgFromList(Organization **orgPtr, OrgList *listPtr)
 {
     char name[STRING_SIZE];
     getLineWithPrompt(name, STRING_SIZE, SELECT_PROMPT);
 
-    selectOrgFromList(orgPtr, headPtr, name);
+    selectOrgFromList(orgPtr, listPtr, name);
 
     while (*orgPtr == NULL) {
         getLineWithPrompt(name, STRING_SIZE, SELECT_ERROR);
 
-        selectOrgFromList(orgPtr, headPtr, name);
+        selectOrgFromList(orgPtr, listPtr, name);
     }
 } // selectValidOrgFromList
 
-int setUp(OrgNode **headPtr)
+size_t foldKey(const char *name, char key[STRING_SIZE], uint64_t *hashPtr)
 {
-    // Create an organization to add to a node
-    Organization org;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    size_t length = 0;
 
-    // Grab user inputs
-    getLineWithPrompt(org.name, STRING_SIZE, ORG_NAME_PROMPT);
-    getLineWithPrompt(org.purpose, STRING_SIZE, ORG_PURPOSE_PROMPT);
-    getLineWithPrompt(org.ownerFirstLastName, STRING_SIZE, 
-                      FIRST_LAST_NAME_PROMPT);
-    getPosDouble(&org.goalAmount, GOAL_PROMPT, GOAL_ERROR, MIN_GOAL);
-    getEmail(org.ownerEmail, STRING_SIZE);
-    getPassword(org.ownerPwd, STRING_SIZE);
+    // lowercase and hash one byte at a time
+    while (name[length] != '\0' && length < STRING_SIZE - 1) {
+        key[length] = tolower((unsigned char) name[length]);
+        hash ^= (unsigned char) key[length];
+        hash *= FNV_PRIME;
 
-    // Initialize count and sum variables
-    org.numDonations = 0;
-    org.donationSum = 0.0;
-    org.numDonors = 0;
-    org.feesSum = 0.0;
-    
-    // Generate the receipt's path and the org's url
-    generateUrl(org.url, org.name);
-    generateReceiptPath(org.receiptPath, org.name);
+        length++;
+    }
 
-    // Create the receipts file, if it already exists, wipe it
-    FILE *receiptsFile = fopen(org.receiptPath, FILE_WRITE_MODE);
-    fclose(receiptsFile);
+    key[length] = '\0';
+    *hashPtr = hash;
 
-    // Insert the org to the linked list
-    insertOrgToList(headPtr, org);
+    return length;
+} // foldKey
 
-    // Print out thank you message. Not a constant in case more variables in the
-    // message are desired
-    printf("Thank you %s. The url to raise funds for %s is %s.\n\n",
-           org.ownerFirstLastName, org.name, org.url);
+bool reserveIndexSlot(OrgIndex *indexPtr)
+{
+    bool hasRoom = true;
+
+    // grow once one more node would fill more than the maximum load
+    if ((indexPtr->count + 1) * 100 >
+            indexPtr->capacity * INDEX_MAX_LOAD_PERCENT) {
+        size_t newCapacity = indexPtr->capacity * 2;
+        if (newCapacity < INDEX_MIN_CAPACITY) {
+            newCapacity = INDEX_MIN_CAPACITY;
+        }
 
-    // Figure out whether to add another organization with a flag
-    int retFlag;
-    if (getYesOrNo(NEW_ORG_PROMPT, NEW_ORG_ERROR)) {
-        retFlag = SETUP_MODE_FLAG;
-    } else {
-        retFlag = DONATIONS_MODE_FLAG;
-    }
+        OrgNode **newSlots = calloc(newCapacity, sizeof(OrgNode *));
 
-    return retFlag;
-} // setUp
+        if (newSlots == NULL) {
+            hasRoom = false;
+        } else {
+            // move every node into its slot in the larger table
+            OrgIndex newIndex = {newSlots, newCapacity, 0, false};
+            for (size_t i = 0; i < indexPtr->capacity; i++) {
+                if (indexPtr->slots[i] != NULL) {
+                    indexOrgNode(&newIndex, indexPtr->slots[i]);
+                }
+            }
 
-int donate(OrgNode **headPtr, Organization **currOrgPtr, Donor *donor)
-{
-    puts(DONATION_SELECT_PROMPT);
-    printListContents(headPtr);
-    puts("");
+            if (!indexPtr->slotsMapped) {
+                free(indexPtr->slots);
+            }
+            *indexPtr = newIndex;
+        }
+    }
 
-    selectValidOrgFromList(currOrgPtr, headPtr);
+    return hasRoom;
+} // reserveIndexSlot
 
-    Organization *currOrg = *currOrgPtr;
+void indexOrgNode(OrgIndex *indexPtr, OrgNode *nodePtr)
+{
+    size_t mask = indexPtr->capacity - 1;
+    size_t slot = nodePtr->keyHash & mask;
+
+    // probe until an empty slot or a node with the same key
+    while (indexPtr->slots[slot] != NULL &&
+           (indexPtr->slots[slot]->keyHash != nodePtr->keyHash ||
+            strcmp(indexPtr->slots[slot]->key, nodePtr->key) != 0)) {
+        slot = (slot + 1) & mask;
+    }
 
-    // Print out org info. Not constants in case more variables in the
-    // printf statements are desired.
-    puts(currOrg->url);
-    puts("MAKE A DIFFERENCE BY YOUR DONATION");
-    printf("Organization: %s\n", currOrg->name);
-    printf("Purpose: %s\n", currOrg->purpose);
-    printf("We currently have raised $%.2lf.\n", currOrg->donationSum);
-    if (currOrg->donationSum >= currOrg->goalAmount) {
-        puts("We have reached our goal but can still use the donations.");
-    } else {
-        printf("We are %2.2lf%% towards our goal of $%.2lf.\n",
-               (currOrg->donationSum / currOrg->goalAmount) * 100,
-               currOrg->goalAmount);
+    if (indexPtr->slots[slot] == NULL) {
+        indexPtr->count++;
     }
-    puts("");
 
-    // Retrieve the user's donation
-    double donation = 0;
+    indexPtr->slots[slot] = nodePtr;
+} // indexOrgNode
+
+OrgNode *findIndexedOrg(const OrgIndex *indexPtr, const char *name)
+{
+    OrgNode *foundNodePtr = NULL;
+
+    // an index which has never had a node added has no slots
+    if (indexPtr->capacity > 0) {
+        char key[STRING_SIZE];
+        uint64_t hash;
+        size_t keyLength = foldKey(name, key, &hash);
+
+        size_t mask = indexPtr->capacity - 1;
+        size_t slot = hash & mask;
+
+        // probe until the key or an empty slot is found, only comparing keys
+        // whose hash and length already match
+        while (indexPtr->slots[slot] != NULL && foundNodePtr == NULL) {
+            OrgNode *slotNodePtr = indexPtr->slots[slot];
+            if (slotNodePtr->keyHash == hash &&
+                slotNodePtr->keyLength == keyLength &&
+                memcmp(slotNodePtr->key, key, keyLength) == 0) {
+                foundNodePtr = slotNodePtr;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    return foundNodePtr;
+} // findIndexedOrg
+
+void clearOrgIndex(OrgIndex *indexPtr)
+{
+    if (!indexPtr->slotsMapped) {
+        free(indexPtr->slots);
+    }
+
+    indexPtr->slots = NULL;
+    indexPtr->capacity = 0;
+    indexPtr->count = 0;
+    indexPtr->slotsMapped = false;
+} // clearOrgIndex
+
+int setUp(OrgList *listPtr)
+{
+    int retFlag;
+
+    // Create the node first so the organization is built in place in it
+    OrgNode *newNodePtr = newOrgNode(listPtr);
+
+    if (newNodePtr == NULL) {
+        puts(MEM_ERROR);
+
+        // keep going with the organizations set up so far, if there are any
+        if (listPtr->headPtr == NULL) {
+            retFlag = END_PROGRAM_FLAG;
+        } else {
+            retFlag = DONATIONS_MODE_FLAG;
+        }
+    } else {
+        Organization *org = &newNodePtr->org;
+
+        // Grab user inputs
+        getLineWithPrompt(org->name, STRING_SIZE, ORG_NAME_PROMPT);
+        getLineWithPrompt(org->purpose, STRING_SIZE, ORG_PURPOSE_PROMPT);
+        getLineWithPrompt(org->ownerFirstLastName, STRING_SIZE, 
+                          FIRST_LAST_NAME_PROMPT);
+        getPosCents(&org->goalAmount, GOAL_PROMPT, GOAL_ERROR, MIN_GOAL);
+        getEmail(org->ownerEmail, STRING_SIZE);
+        getPassword(org->ownerPwd, STRING_SIZE);
+
+        // Initialize count and sum variables and generate the receipt's path
+        // and the org's url
+        initOrgTotals(org);
+
+        // Create the receipts file, if it already exists, wipe it
+        FILE *receiptsFile = fopen(org->receiptPath, FILE_WRITE_MODE);
+        fclose(receiptsFile);
+
+        // Save the org to the donation log before linking or confirming it
+        bool saved = listPtr->logPtr == NULL ||
+                     waitForLogCommit(listPtr->logPtr,
+                                      logOrg(listPtr->logPtr, newNodePtr));
+
+        if (!saved) {
+            puts(LOG_ORG_ERROR);
+            free(newNodePtr);
+
+            // the log stays failed, so keep going with the organizations
+            // set up so far, if there are any
+            if (listPtr->headPtr == NULL) {
+                retFlag = END_PROGRAM_FLAG;
+            } else {
+                retFlag = DONATIONS_MODE_FLAG;
+            }
+        } else {
+            // Link the org's node into the linked list
+            linkOrgNode(listPtr, newNodePtr);
+
+            // Print out thank you message. Not a constant in case more variables
+            // in the message are desired
+            printf("Thank you %s. The url to raise funds for %s is %s.\n\n",
+                   org->ownerFirstLastName, org->name, org->url);
+
+            // Figure out whether to add another organization with a flag
+            if (getYesOrNo(NEW_ORG_PROMPT, NEW_ORG_ERROR)) {
+                retFlag = SETUP_MODE_FLAG;
+            } else {
+                retFlag = DONATIONS_MODE_FLAG;
+            }
+        }
+    }
+
+    return retFlag;
+} // setUp
+
+int donate(OrgList *listPtr, Organization **currOrgPtr, Donor *donor)
+{
+    puts(DONATION_SELECT_PROMPT);
+    printListContents(&listPtr->headPtr);
+    puts("");
+
+    selectValidOrgFromList(currOrgPtr, listPtr);
+
+    Organization *currOrg = *currOrgPtr;
+
+    // Print out org info. Not constants in case more variables in the
+    // printf statements are desired.
+    puts(currOrg->url);
+    puts("MAKE A DIFFERENCE BY YOUR DONATION");
+    printf("Organization: %s\n", currOrg->name);
+    printf("Purpose: %s\n", currOrg->purpose);
+    char raised[MONEY_STRING_SIZE];
+    char goal[MONEY_STRING_SIZE];
+    formatCents(currOrg->donationSum, raised);
+    formatCents(currOrg->goalAmount, goal);
+    printf("We currently have raised $%s.\n", raised);
+    if (currOrg->donationSum >= currOrg->goalAmount) {
+        puts("We have reached our goal but can still use the donations.");
+    } else {
+        printf("We are %2.2lf%% towards our goal of $%s.\n",
+               ((double) currOrg->donationSum / currOrg->goalAmount) * 100,
+               goal);
+    }
+    puts("");
+
+    // Retrieve the user's donation
+    Cents donation = 0;
     getDonation(&donation);
 
     int retFlag;
@@ -1121,28 +2833,38 @@ int donate(OrgNode **headPtr, Organization **currOrgPtr, Donor *donor)
                           FIRST_LAST_NAME_PROMPT);
         getZip(donor->zip, STRING_SIZE);
 
-        // track donations and fees
-        double fee = donation * TRANSACTION_FEE;
-        currOrg->feesSum += fee;
-
-        double effectiveDonation = donation - fee;
-        currOrg->donationSum += effectiveDonation;
-
-        currOrg->numDonations++;
-
-        // print donation thank you
-        printf("Thank you for your donation. There is a %.1lf%% credit card" 
-               "processing fee of $%.2lf. $%.2lf will be donated.\n",
-                100 * TRANSACTION_FEE, fee, effectiveDonation);
+        // save the donation to the log before applying or confirming it, so
+        // a crash can never lose a donation the donor was thanked for
+        OrgNode *currNodePtr = nodeOfOrg(currOrg);
+        bool saved = listPtr->logPtr == NULL ||
+                     waitForLogCommit(listPtr->logPtr,
+                                      logDonation(listPtr->logPtr, currNodePtr,
+                                                  donation));
 
-        
-        // Ask user for receipt
-        if (getYesOrNo(RECEIPT_PROMPT, RECEIPT_ERROR)) {
-            fPrintReceipt(stdout, currOrg, donation);
-
-            FILE *receipts = fopen(currOrg->receiptPath, FILE_APPEND_MODE);
-            fPrintReceipt(receipts, currOrg, donation);
-            fclose(receipts);
+        if (!saved) {
+            puts(LOG_ERROR);
+        } else {
+            // track donations and fees
+            Cents fee = addDonation(&currNodePtr->org, donation);
+
+            char feeAmount[MONEY_STRING_SIZE];
+            char effectiveDonation[MONEY_STRING_SIZE];
+            formatCents(fee, feeAmount);
+            formatCents(donation - fee, effectiveDonation);
+
+            // print donation thank you
+            printf("Thank you for your donation. There is a %.1lf%% credit card" 
+                   "processing fee of $%s. $%s will be donated.\n",
+                    100 * TRANSACTION_FEE, feeAmount, effectiveDonation);
+
+            // Ask user for receipt
+            if (getYesOrNo(RECEIPT_PROMPT, RECEIPT_ERROR)) {
+                fPrintReceipt(stdout, currOrg, donation);
+
+                FILE *receipts = fopen(currOrg->receiptPath, FILE_APPEND_MODE);
+                fPrintReceipt(receipts, currOrg, donation);
+                fclose(receipts);
+            }
         }
 
         retFlag = DONATIONS_MODE_FLAG;
@@ -1153,7 +2875,7 @@ int donate(OrgNode **headPtr, Organization **currOrgPtr, Donor *donor)
     return retFlag;
 } // donate
 
-int report(OrgNode **headPtr, Organization **currOrgPtr)
+int report(OrgList *listPtr, Organization **currOrgPtr)
 {
     int exitFlag;
 
@@ -1170,15 +2892,26 @@ int report(OrgNode **headPtr, Organization **currOrgPtr)
 
             puts("");
 
-            // iterate through the linked list
-            OrgNode *currNodePtr = *headPtr;
+            // iterate through the linked list, copying each org's numbers
+            // into the columns on the way
+            OrgColumns columns = {NULL, NULL, 0};
+            bool copied = true;
+            OrgNode *currNodePtr = listPtr->headPtr;
             while (currNodePtr != NULL) {
                 // prints summary to orgs file and stdout
                 fPrintSummary(stdout, &(currNodePtr->org));
                 fPrintSummary(orgsFile, &(currNodePtr->org));
+                copied = copied && addOrgColumnRow(&columns, currNodePtr);
                 currNodePtr = currNodePtr->nextNodePtr;
             }
 
+            // the totals only read the columns, not every node again
+            if (!copied || !fPrintOrgReport(stdout, &columns, REPORT_TOP_ORGS) ||
+                    !fPrintOrgReport(orgsFile, &columns, REPORT_TOP_ORGS)) {
+                puts(MEM_ERROR);
+            }
+            freeOrgColumns(&columns);
+
             fclose(orgsFile);
 
             exitFlag = END_PROGRAM_FLAG;
@@ -1191,3 +2924,3116 @@ int report(OrgNode **headPtr, Organization **currOrgPtr)
 
     return exitFlag;
 } // report
+
+bool saveSnapshot(const OrgList *listPtr, const char *path)
+{
+    // count the nodes and put them in list order
+    size_t orgCount = 0;
+    for (const OrgNode *currNodePtr = listPtr->headPtr; currNodePtr != NULL;
+            currNodePtr = currNodePtr->nextNodePtr) {
+        orgCount++;
+    }
+
+    size_t slotCount = listPtr->index.capacity;
+    const OrgNode **orderedNodes = malloc((orgCount + 1) * sizeof(OrgNode *));
+    uint64_t *slots = calloc(slotCount + 1, sizeof(uint64_t));
+    bool saved = orderedNodes != NULL && slots != NULL;
+
+    if (!saved) {
+        puts(MEM_ERROR);
+    } else {
+        SnapshotHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+        header.version = SNAPSHOT_VERSION;
+        header.nodeSize = sizeof(OrgNode);
+        header.baseAddress = SNAPSHOT_BASE_ADDRESS;
+        header.orgCount = orgCount;
+        header.slotCount = slotCount;
+        header.slotsOffset = SNAPSHOT_HEADER_SIZE;
+        header.nodesOffset = header.slotsOffset + slotCount * sizeof(uint64_t);
+        header.fileSize = header.nodesOffset + orgCount * sizeof(OrgNode);
+
+        size_t orgNum = 0;
+        for (const OrgNode *currNodePtr = listPtr->headPtr; currNodePtr != NULL;
+                currNodePtr = currNodePtr->nextNodePtr) {
+            orderedNodes[orgNum] = currNodePtr;
+            orgNum++;
+        }
+
+        // index the nodes again by their place in the file; the first node
+        // with a name is the one the index finds, as in linkOrgNode()
+        for (orgNum = 0; orgNum < orgCount; orgNum++) {
+            const OrgNode *nodePtr = orderedNodes[orgNum];
+            size_t mask = slotCount - 1;
+            size_t slot = nodePtr->keyHash & mask;
+
+            while (slots[slot] != 0 &&
+                   (orderedNodes[slots[slot] - 1]->keyHash != nodePtr->keyHash ||
+                    strcmp(orderedNodes[slots[slot] - 1]->key, nodePtr->key) != 0)) {
+                slot = (slot + 1) & mask;
+            }
+
+            if (slots[slot] == 0) {
+                slots[slot] = orgNum + 1;
+            }
+        }
+
+        // turn node numbers into the addresses the nodes will be mapped at
+        for (size_t slot = 0; slot < slotCount; slot++) {
+            if (slots[slot] != 0) {
+                slots[slot] = header.baseAddress + header.nodesOffset +
+                              (slots[slot] - 1) * sizeof(OrgNode);
+            }
+        }
+
+        // write to a temporary file so a failed save leaves the old snapshot
+        char tempPath[FILENAME_MAX];
+        snprintf(tempPath, sizeof(tempPath), "%s%s", path, SNAPSHOT_TEMP_SUFFIX);
+        FILE *snapshotFile = fopen(tempPath, "wb");
+        saved = snapshotFile != NULL;
+
+        if (saved) {
+            static const char padding[SNAPSHOT_HEADER_SIZE];
+            saved = fwrite(&header, sizeof(header), 1, snapshotFile) == 1 &&
+                    fwrite(padding, 1, SNAPSHOT_HEADER_SIZE - sizeof(header),
+                           snapshotFile) == SNAPSHOT_HEADER_SIZE - sizeof(header) &&
+                    fwrite(slots, sizeof(uint64_t), slotCount,
+                           snapshotFile) == slotCount;
+
+            // copy each node with its next pointer set for the mapping
+            OrgNode nodeImage;
+            for (orgNum = 0; orgNum < orgCount && saved; orgNum++) {
+                nodeImage = *orderedNodes[orgNum];
+                nodeImage.receiptsPtr = NULL;
+                nodeImage.nextNodePtr = NULL;
+                if (orgNum + 1 < orgCount) {
+                    nodeImage.nextNodePtr = (OrgNode *) (uintptr_t)
+                        (header.baseAddress + header.nodesOffset +
+                         (orgNum + 1) * sizeof(OrgNode));
+                }
+
+                saved = fwrite(&nodeImage, sizeof(OrgNode), 1, snapshotFile) == 1;
+            }
+
+            saved = fclose(snapshotFile) == 0 && saved;
+            saved = saved && rename(tempPath, path) == 0;
+
+            if (!saved) {
+                remove(tempPath);
+            }
+        }
+
+        if (!saved) {
+            fprintf(stderr, "Could not save the snapshot %s\n", path);
+        }
+    }
+
+    free(orderedNodes);
+    free(slots);
+
+    return saved;
+} // saveSnapshot
+
+bool loadSnapshot(OrgList *listPtr, const char *path)
+{
+    bool loaded = false;
+    int fd = open(path, O_RDONLY);
+    struct stat fileStat;
+    SnapshotHeader header;
+
+    if (fd < 0 || fstat(fd, &fileStat) != 0) {
+        fprintf(stderr, "Could not open %s: %s\n", path, strerror(errno));
+    } else if (pread(fd, &header, sizeof(header), 0) != sizeof(header) ||
+               !isValidSnapshotHeader(&header, fileStat.st_size)) {
+        fprintf(stderr, "%s is not a snapshot this program can load\n", path);
+    } else {
+        // map the file copy-on-write at the address its pointers were set for
+        void *basePtr = (void *) (uintptr_t) header.baseAddress;
+        void *mapPtr = mmap(basePtr, header.fileSize, PROT_READ | PROT_WRITE,
+                            MAP_PRIVATE | MAP_FIXED_NOREPLACE, fd, 0);
+
+        if (mapPtr == MAP_FAILED) {
+            mapPtr = mmap(NULL, header.fileSize, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE, fd, 0);
+        }
+
+        if (mapPtr == MAP_FAILED) {
+            fprintf(stderr, "Could not map %s: %s\n", path, strerror(errno));
+        } else if (!isValidSnapshotImage(&header, mapPtr)) {
+            fprintf(stderr, "%s is not a snapshot this program can load\n", path);
+            munmap(mapPtr, header.fileSize);
+        } else {
+            char *mapBytes = mapPtr;
+            OrgNode **slots = (OrgNode **) (mapBytes + header.slotsOffset);
+            OrgNode *nodes = (OrgNode *) (mapBytes + header.nodesOffset);
+
+            // somewhere else was mapped there, so move every pointer by the
+            // difference, which reads the whole file
+            if (mapPtr != basePtr) {
+                uintptr_t delta = (uintptr_t) mapPtr - header.baseAddress;
+
+                for (size_t slot = 0; slot < header.slotCount; slot++) {
+                    if (slots[slot] != NULL) {
+                        slots[slot] = (OrgNode *) ((uintptr_t) slots[slot] + delta);
+                    }
+                }
+
+                for (size_t orgNum = 0; orgNum + 1 < header.orgCount; orgNum++) {
+                    nodes[orgNum].nextNodePtr = &nodes[orgNum + 1];
+                }
+            }
+
+            listPtr->snapshotPtr = mapPtr;
+            listPtr->snapshotSize = header.fileSize;
+            listPtr->headPtr = header.orgCount > 0 ? nodes : NULL;
+            listPtr->index.slots = slots;
+            listPtr->index.capacity = header.slotCount;
+            listPtr->index.count = header.orgCount;
+            listPtr->index.slotsMapped = true;
+
+            loaded = true;
+        }
+    }
+
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    return loaded;
+} // loadSnapshot
+
+bool isValidSnapshotHeader(const SnapshotHeader *headerPtr, size_t fileSize)
+{
+    uint64_t slotCount = headerPtr->slotCount;
+    uint64_t slotsSize;
+    uint64_t nodesSize;
+    uint64_t maxLoad;
+    uint64_t orgLoad;
+
+    // a corrupt header can make any of these products overflow
+    bool sizesFit = multiplySizes(slotCount, sizeof(uint64_t), &slotsSize) &&
+                    multiplySizes(headerPtr->orgCount, sizeof(OrgNode), &nodesSize) &&
+                    multiplySizes(slotCount, INDEX_MAX_LOAD_PERCENT, &maxLoad) &&
+                    multiplySizes(headerPtr->orgCount, 100, &orgLoad) &&
+                    slotsSize <= UINT64_MAX - SNAPSHOT_HEADER_SIZE &&
+                    nodesSize <= UINT64_MAX - SNAPSHOT_HEADER_SIZE - slotsSize;
+
+    // the index must be a power of two in size and no more than half full,
+    // and the nodes must fit in the file after it, with every pointer in the
+    // mapping still within the address space
+    return sizesFit &&
+           memcmp(headerPtr->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0 &&
+           headerPtr->version == SNAPSHOT_VERSION &&
+           headerPtr->nodeSize == sizeof(OrgNode) &&
+           headerPtr->fileSize == fileSize &&
+           (slotCount & (slotCount - 1)) == 0 &&
+           orgLoad <= maxLoad &&
+           headerPtr->slotsOffset == SNAPSHOT_HEADER_SIZE &&
+           headerPtr->nodesOffset == SNAPSHOT_HEADER_SIZE + slotsSize &&
+           headerPtr->fileSize == headerPtr->nodesOffset + nodesSize &&
+           headerPtr->baseAddress <= UINTPTR_MAX - headerPtr->fileSize;
+} // isValidSnapshotHeader
+
+bool isValidSnapshotImage(const SnapshotHeader *headerPtr, const char *mapBytes)
+{
+    const uint64_t *slots = (const uint64_t *) (mapBytes + headerPtr->slotsOffset);
+    const OrgNode *nodes = (const OrgNode *) (mapBytes + headerPtr->nodesOffset);
+    uint64_t nodesStart = headerPtr->baseAddress + headerPtr->nodesOffset;
+    bool valid = true;
+
+    // a slot holds the address of a node as it would be mapped at baseAddress
+    for (uint64_t slot = 0; slot < headerPtr->slotCount && valid; slot++) {
+        valid = slots[slot] == 0 ||
+                (slots[slot] >= nodesStart &&
+                 slots[slot] < headerPtr->baseAddress + headerPtr->fileSize &&
+                 (slots[slot] - nodesStart) % sizeof(OrgNode) == 0);
+    }
+
+    // the nodes were saved in list order, so each links to the next one
+    for (uint64_t orgNum = 0; orgNum < headerPtr->orgCount && valid; orgNum++) {
+        uint64_t nextAddress = 0;
+        if (orgNum + 1 < headerPtr->orgCount) {
+            nextAddress = nodesStart + (orgNum + 1) * sizeof(OrgNode);
+        }
+
+        valid = (uintptr_t) nodes[orgNum].nextNodePtr == nextAddress &&
+                nodes[orgNum].receiptsPtr == NULL &&
+                isValidSnapshotNode(&nodes[orgNum]);
+    }
+
+    return valid;
+} // isValidSnapshotImage
+
+bool isValidSnapshotNode(const OrgNode *nodePtr)
+{
+    const Organization *org = &nodePtr->org;
+
+    bool terminated =
+        memchr(org->name, '\0', sizeof(org->name)) != NULL &&
+        memchr(org->purpose, '\0', sizeof(org->purpose)) != NULL &&
+        memchr(org->receiptPath, '\0', sizeof(org->receiptPath)) != NULL &&
+        memchr(org->url, '\0', sizeof(org->url)) != NULL &&
+        memchr(org->ownerEmail, '\0', sizeof(org->ownerEmail)) != NULL &&
+        memchr(org->ownerPwd, '\0', sizeof(org->ownerPwd)) != NULL &&
+        memchr(org->ownerFirstLastName, '\0',
+               sizeof(org->ownerFirstLastName)) != NULL &&
+        memchr(nodePtr->key, '\0', sizeof(nodePtr->key)) != NULL;
+
+    // the key is only folded once the name is known to end
+    bool keyMatches = false;
+    if (terminated && nodePtr->keyLength < STRING_SIZE) {
+        char key[STRING_SIZE];
+        uint64_t keyHash;
+        size_t keyLength = foldKey(org->name, key, &keyHash);
+
+        keyMatches = keyLength == nodePtr->keyLength &&
+                     keyHash == nodePtr->keyHash &&
+                     strcmp(key, nodePtr->key) == 0;
+    }
+
+    return keyMatches;
+} // isValidSnapshotNode
+
+bool multiplySizes(uint64_t size1, uint64_t size2, uint64_t *productPtr)
+{
+    bool fits = size1 == 0 || size2 <= UINT64_MAX / size1;
+
+    if (fits) {
+        *productPtr = size1 * size2;
+    }
+
+    return fits;
+} // multiplySizes
+
+bool isInSnapshot(const OrgList *listPtr, const void *ptr)
+{
+    const char *snapshotBytes = listPtr->snapshotPtr;
+    const char *bytes = ptr;
+
+    return snapshotBytes != NULL && bytes >= snapshotBytes &&
+           bytes < snapshotBytes + listPtr->snapshotSize;
+} // isInSnapshot
+
+bool startReceiptWriter(ReceiptWriter *writerPtr)
+{
+    writerPtr->stopping = false;
+    writerPtr->writeFailed = false;
+    writerPtr->buffersPtr = NULL;
+    writerPtr->queueHeadPtr = NULL;
+    writerPtr->queueTailPtr = NULL;
+    writerPtr->openFiles = 0;
+    writerPtr->stampSecond = (time_t) -1;
+
+    mtx_init(&writerPtr->mutex, mtx_plain);
+    cnd_init(&writerPtr->workReady);
+    cnd_init(&writerPtr->flushDone);
+
+    bool started = thrd_create(&writerPtr->thread, receiptWriterThread,
+                               writerPtr) == thrd_success;
+
+    if (!started) {
+        fputs("Could not start the receipt writer\n", stderr);
+        mtx_destroy(&writerPtr->mutex);
+        cnd_destroy(&writerPtr->workReady);
+        cnd_destroy(&writerPtr->flushDone);
+    }
+
+    return started;
+} // startReceiptWriter
+
+bool queueReceipt(ReceiptWriter *writerPtr, OrgNode *nodePtr, Cents donation)
+{
+    ReceiptBuffer *bufferPtr = nodePtr->receiptsPtr;
+
+    // give the org a buffer the first time it gets a receipt
+    if (bufferPtr == NULL) {
+        bufferPtr = malloc(sizeof(ReceiptBuffer));
+
+        if (bufferPtr != NULL) {
+            bufferPtr->fillData = malloc(RECEIPT_BUFFER_SIZE);
+            bufferPtr->flushData = malloc(RECEIPT_BUFFER_SIZE);
+
+            if (bufferPtr->fillData == NULL || bufferPtr->flushData == NULL) {
+                free(bufferPtr->fillData);
+                free(bufferPtr->flushData);
+                free(bufferPtr);
+                bufferPtr = NULL;
+            } else {
+                memcpy(bufferPtr->receiptPath, nodePtr->org.receiptPath,
+                       sizeof(bufferPtr->receiptPath));
+                bufferPtr->file = NULL;
+                bufferPtr->ownerPtr = nodePtr;
+                bufferPtr->fillUsed = 0;
+                bufferPtr->flushUsed = 0;
+                bufferPtr->queued = false;
+                bufferPtr->nextQueuedPtr = NULL;
+
+                // the list of every buffer is only used by this thread
+                bufferPtr->nextBufferPtr = writerPtr->buffersPtr;
+                writerPtr->buffersPtr = bufferPtr;
+
+                nodePtr->receiptsPtr = bufferPtr;
+            }
+        }
+    }
+
+    if (bufferPtr == NULL) {
+        puts(MEM_ERROR);
+    } else {
+        const char *timeStamp = receiptTimeStamp(writerPtr);
+        char amount[MONEY_STRING_SIZE];
+        formatCents(donation, amount);
+
+        size_t room = RECEIPT_BUFFER_SIZE - bufferPtr->fillUsed;
+        int length = snprintf(bufferPtr->fillData + bufferPtr->fillUsed, room,
+                              RECEIPT_FORMAT, nodePtr->org.name, amount,
+                              timeStamp);
+
+        // when the receipt does not fit, hand off the full half and format the
+        // receipt again at the start of the empty one
+        if (length >= 0 && (size_t) length >= room) {
+            handOffReceipts(writerPtr, bufferPtr);
+            length = snprintf(bufferPtr->fillData, RECEIPT_BUFFER_SIZE,
+                              RECEIPT_FORMAT, nodePtr->org.name, amount,
+                              timeStamp);
+        }
+
+        if (length > 0) {
+            bufferPtr->fillUsed += length;
+        }
+    }
+
+    return bufferPtr != NULL;
+} // queueReceipt
+
+void handOffReceipts(ReceiptWriter *writerPtr, ReceiptBuffer *bufferPtr)
+{
+    mtx_lock(&writerPtr->mutex);
+
+    // the other half may still be waiting for or being written
+    while (bufferPtr->queued) {
+        cnd_wait(&writerPtr->flushDone, &writerPtr->mutex);
+    }
+
+    // swap the halves so filling can go on while the full one is written
+    char *fullData = bufferPtr->fillData;
+    bufferPtr->fillData = bufferPtr->flushData;
+    bufferPtr->flushData = fullData;
+    bufferPtr->flushUsed = bufferPtr->fillUsed;
+    bufferPtr->fillUsed = 0;
+
+    // add the buffer to the end of the queue
+    bufferPtr->queued = true;
+    bufferPtr->nextQueuedPtr = NULL;
+    if (writerPtr->queueTailPtr == NULL) {
+        writerPtr->queueHeadPtr = bufferPtr;
+    } else {
+        writerPtr->queueTailPtr->nextQueuedPtr = bufferPtr;
+    }
+    writerPtr->queueTailPtr = bufferPtr;
+
+    cnd_signal(&writerPtr->workReady);
+    mtx_unlock(&writerPtr->mutex);
+} // handOffReceipts
+
+int receiptWriterThread(void *writerArgPtr)
+{
+    ReceiptWriter *writerPtr = writerArgPtr;
+    bool done = false;
+
+    mtx_lock(&writerPtr->mutex);
+
+    while (!done) {
+        while (writerPtr->queueHeadPtr == NULL && !writerPtr->stopping) {
+            cnd_wait(&writerPtr->workReady, &writerPtr->mutex);
+        }
+
+        if (writerPtr->queueHeadPtr == NULL) {
+            done = true;
+        } else {
+            // take the first buffer and write it without holding the lock
+            ReceiptBuffer *bufferPtr = writerPtr->queueHeadPtr;
+            writerPtr->queueHeadPtr = bufferPtr->nextQueuedPtr;
+            if (writerPtr->queueHeadPtr == NULL) {
+                writerPtr->queueTailPtr = NULL;
+            }
+
+            mtx_unlock(&writerPtr->mutex);
+            bool written = writeReceipts(writerPtr, bufferPtr);
+            mtx_lock(&writerPtr->mutex);
+
+            if (!written) {
+                writerPtr->writeFailed = true;
+            }
+
+            bufferPtr->flushUsed = 0;
+            bufferPtr->queued = false;
+            cnd_broadcast(&writerPtr->flushDone);
+        }
+    }
+
+    mtx_unlock(&writerPtr->mutex);
+
+    return 0;
+} // receiptWriterThread
+
+bool writeReceipts(ReceiptWriter *writerPtr, ReceiptBuffer *bufferPtr)
+{
+    bool written = false;
+
+    if (bufferPtr->file == NULL) {
+        bufferPtr->file = fopen(bufferPtr->receiptPath, FILE_APPEND_MODE);
+
+        if (bufferPtr->file != NULL) {
+            writerPtr->openFiles++;
+        }
+    }
+
+    if (bufferPtr->file != NULL) {
+        written = fwrite(bufferPtr->flushData, 1, bufferPtr->flushUsed,
+                         bufferPtr->file) == bufferPtr->flushUsed;
+
+        // past the limit, files are opened again for every write
+        if (writerPtr->openFiles > RECEIPT_MAX_OPEN_FILES) {
+            written = fclose(bufferPtr->file) == 0 && written;
+            bufferPtr->file = NULL;
+            writerPtr->openFiles--;
+        }
+    }
+
+    return written;
+} // writeReceipts
+
+bool stopReceiptWriter(ReceiptWriter *writerPtr)
+{
+    // hand off what is left in every buffer
+    for (ReceiptBuffer *bufferPtr = writerPtr->buffersPtr; bufferPtr != NULL;
+            bufferPtr = bufferPtr->nextBufferPtr) {
+        if (bufferPtr->fillUsed > 0) {
+            handOffReceipts(writerPtr, bufferPtr);
+        }
+    }
+
+    mtx_lock(&writerPtr->mutex);
+    writerPtr->stopping = true;
+    cnd_signal(&writerPtr->workReady);
+    mtx_unlock(&writerPtr->mutex);
+
+    thrd_join(writerPtr->thread, NULL);
+
+    bool allWritten = !writerPtr->writeFailed;
+
+    // close the files and free the buffers, so their orgs start a new
+    // buffer if another writer queues receipts for them
+    ReceiptBuffer *bufferPtr = writerPtr->buffersPtr;
+    while (bufferPtr != NULL) {
+        ReceiptBuffer *nextBufferPtr = bufferPtr->nextBufferPtr;
+
+        if (bufferPtr->file != NULL && fclose(bufferPtr->file) != 0) {
+            allWritten = false;
+        }
+
+        bufferPtr->ownerPtr->receiptsPtr = NULL;
+
+        free(bufferPtr->fillData);
+        free(bufferPtr->flushData);
+        free(bufferPtr);
+
+        bufferPtr = nextBufferPtr;
+    }
+
+    writerPtr->buffersPtr = NULL;
+
+    mtx_destroy(&writerPtr->mutex);
+    cnd_destroy(&writerPtr->workReady);
+    cnd_destroy(&writerPtr->flushDone);
+
+    return allWritten;
+} // stopReceiptWriter
+
+const char *receiptTimeStamp(ReceiptWriter *writerPtr)
+{
+    time_t now = time(NULL);
+
+    if (now != writerPtr->stampSecond) {
+        struct tm localNow;
+        strftime(writerPtr->timeStamp, TIME_STAMP_SIZE, TIME_STAMP_FORMAT,
+                 localtime_r(&now, &localNow));
+        writerPtr->stampSecond = now;
+    }
+
+    return writerPtr->timeStamp;
+} // receiptTimeStamp
+
+bool openDonationLog(DonationLog *logPtr, OrgList *listPtr, const char *path,
+                     size_t groupSize, long maxDelayMicros)
+{
+    logPtr->fd = open(path, O_RDWR | O_CREAT | O_APPEND, LOG_FILE_MODE);
+    logPtr->fillData = malloc(LOG_BUFFER_SIZE);
+    logPtr->flushData = malloc(LOG_BUFFER_SIZE);
+    logPtr->fillUsed = 0;
+    logPtr->appendedRecords = 0;
+    logPtr->takenRecords = 0;
+    logPtr->durableRecords = 0;
+    logPtr->numSyncs = 0;
+    logPtr->groupSize = groupSize > 0 ? groupSize : 1;
+    logPtr->maxDelayMicros = maxDelayMicros;
+    logPtr->numOrgs = 0;
+    logPtr->replayedDonations = 0;
+    logPtr->droppedBytes = 0;
+    logPtr->flushNow = false;
+    logPtr->stopping = false;
+    logPtr->failed = false;
+
+    struct stat fileStat;
+    bool opened = logPtr->fd >= 0 && logPtr->fillData != NULL &&
+                  logPtr->flushData != NULL && fstat(logPtr->fd, &fileStat) == 0;
+    size_t fileSize = opened ? (size_t) fileStat.st_size : 0;
+    size_t validSize = 0;
+
+    if (opened && fileSize < sizeof(LogHeader)) {
+        // a new log, or one whose header never made it to disk
+        LogHeader header = {LOG_MAGIC, LOG_VERSION, sizeof(LogRecord)};
+        opened = ftruncate(logPtr->fd, 0) == 0 &&
+                 write(logPtr->fd, &header, sizeof(header)) == sizeof(header) &&
+                 fdatasync(logPtr->fd) == 0;
+    } else if (opened) {
+        validSize = replayDonationLog(logPtr, listPtr, fileSize);
+        opened = validSize > 0;
+
+        // cut off what a crash left half written, so new records follow the
+        // last intact one
+        if (opened && validSize < fileSize) {
+            logPtr->droppedBytes = fileSize - validSize;
+            opened = ftruncate(logPtr->fd, validSize) == 0 &&
+                     fdatasync(logPtr->fd) == 0;
+        }
+    }
+
+    if (opened) {
+        mtx_init(&logPtr->mutex, mtx_plain);
+        cnd_init(&logPtr->workReady);
+        cnd_init(&logPtr->committed);
+
+        opened = thrd_create(&logPtr->thread, donationLogThread, logPtr) ==
+                 thrd_success;
+        if (!opened) {
+            mtx_destroy(&logPtr->mutex);
+            cnd_destroy(&logPtr->workReady);
+            cnd_destroy(&logPtr->committed);
+        }
+    }
+
+    if (opened) {
+        listPtr->logPtr = logPtr;
+    } else {
+        fprintf(stderr, "Could not open the donation log %s\n", path);
+        if (logPtr->fd >= 0) {
+            close(logPtr->fd);
+        }
+        free(logPtr->fillData);
+        free(logPtr->flushData);
+    }
+
+    return opened;
+} // openDonationLog
+
+size_t replayDonationLog(DonationLog *logPtr, OrgList *listPtr,
+                         size_t fileSize)
+{
+    const char *data = mmap(NULL, fileSize, PROT_READ, MAP_PRIVATE, logPtr->fd,
+                            0);
+    size_t validSize = 0;
+
+    if (data != MAP_FAILED) {
+        madvise((void *) data, fileSize, MADV_SEQUENTIAL);
+
+        LogHeader header;
+        memcpy(&header, data, sizeof(header));
+        bool intact = memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 &&
+                      header.version == LOG_VERSION &&
+                      header.recordSize == sizeof(LogRecord);
+
+        // the node of every logged org, by its number
+        OrgNode **orgNodes = NULL;
+        size_t orgCapacity = 0;
+        bool enoughMemory = true;
+        size_t offset = sizeof(LogHeader);
+
+        while (intact && enoughMemory && offset + sizeof(LogRecord) <= fileSize) {
+            LogRecord record;
+            memcpy(&record, data + offset, sizeof(record));
+            const char *payload = data + offset + sizeof(record);
+            size_t payloadSize = 0;
+            if (record.type == LOG_ORG_RECORD) {
+                payloadSize = sizeof(LogOrgPayload);
+            }
+
+            intact = (record.type == LOG_ORG_RECORD ||
+                      record.type == LOG_DONATION_RECORD) &&
+                     offset + sizeof(record) + payloadSize <= fileSize &&
+                     logChecksum(&record, payload, payloadSize) == record.checksum;
+
+            if (intact && record.type == LOG_DONATION_RECORD) {
+                intact = record.orgNum < logPtr->numOrgs;
+                if (intact) {
+                    addDonation(&orgNodes[record.orgNum]->org, record.amount);
+                    logPtr->replayedDonations++;
+                }
+            } else if (intact) {
+                intact = record.orgNum == logPtr->numOrgs;
+
+                // grow the table of nodes by doubling
+                if (intact && logPtr->numOrgs == orgCapacity) {
+                    orgCapacity = orgCapacity > 0 ? 2 * orgCapacity : 64;
+                    OrgNode **newOrgNodes = realloc(orgNodes,
+                                                    orgCapacity * sizeof(OrgNode *));
+                    enoughMemory = newOrgNodes != NULL;
+                    if (enoughMemory) {
+                        orgNodes = newOrgNodes;
+                    }
+                }
+
+                OrgNode *newNodePtr = NULL;
+                if (intact && enoughMemory) {
+                    newNodePtr = newOrgNode(listPtr);
+                    enoughMemory = newNodePtr != NULL;
+                }
+
+                if (newNodePtr != NULL) {
+                    // build the organization in place, as setUp() did
+                    LogOrgPayload orgPayload;
+                    memcpy(&orgPayload, payload, sizeof(orgPayload));
+                    Organization *org = &newNodePtr->org;
+                    memcpy(org->name, orgPayload.name, sizeof(org->name));
+                    memcpy(org->purpose, orgPayload.purpose, sizeof(org->purpose));
+                    memcpy(org->ownerFirstLastName, orgPayload.ownerFirstLastName,
+                           sizeof(org->ownerFirstLastName));
+                    memcpy(org->ownerEmail, orgPayload.ownerEmail,
+                           sizeof(org->ownerEmail));
+                    memcpy(org->ownerPwd, orgPayload.ownerPwd,
+                           sizeof(org->ownerPwd));
+
+                    // the checksum only says the record is whole, so end
+                    // every string inside its array
+                    org->name[STRING_SIZE - 1] = '\0';
+                    org->purpose[STRING_SIZE - 1] = '\0';
+                    org->ownerFirstLastName[STRING_SIZE - 1] = '\0';
+                    org->ownerEmail[STRING_SIZE - 1] = '\0';
+                    org->ownerPwd[STRING_SIZE - 1] = '\0';
+                    org->goalAmount = record.amount;
+                    initOrgTotals(org);
+
+                    newNodePtr->logNum = record.orgNum;
+                    linkOrgNode(listPtr, newNodePtr);
+                    orgNodes[logPtr->numOrgs] = newNodePtr;
+                    logPtr->numOrgs++;
+                }
+            }
+
+            if (intact && enoughMemory) {
+                offset += sizeof(record) + payloadSize;
+            }
+        }
+
+        // a bad header means this is not a log at all
+        if (enoughMemory && offset > sizeof(LogHeader)) {
+            validSize = offset;
+        } else if (enoughMemory && memcmp(header.magic, LOG_MAGIC,
+                                          sizeof(LOG_MAGIC)) == 0 &&
+                   header.version == LOG_VERSION &&
+                   header.recordSize == sizeof(LogRecord)) {
+            validSize = sizeof(LogHeader);
+        } else if (!enoughMemory) {
+            puts(MEM_ERROR);
+        }
+
+        free(orgNodes);
+        munmap((void *) data, fileSize);
+    }
+
+    return validSize;
+} // replayDonationLog
+
+uint64_t logOrg(DonationLog *logPtr, OrgNode *nodePtr)
+{
+    const Organization *org = &nodePtr->org;
+    LogOrgPayload payload;
+    memset(&payload, 0, sizeof(payload));
+    memcpy(payload.name, org->name, sizeof(payload.name));
+    memcpy(payload.purpose, org->purpose, sizeof(payload.purpose));
+    memcpy(payload.ownerFirstLastName, org->ownerFirstLastName,
+           sizeof(payload.ownerFirstLastName));
+    memcpy(payload.ownerEmail, org->ownerEmail, sizeof(payload.ownerEmail));
+    memcpy(payload.ownerPwd, org->ownerPwd, sizeof(payload.ownerPwd));
+
+    // the number is only handed out on this thread, like the org itself
+    nodePtr->logNum = logPtr->numOrgs;
+    logPtr->numOrgs++;
+
+    LogRecord record = {0, LOG_ORG_RECORD, nodePtr->logNum, org->goalAmount};
+
+    return appendLogRecord(logPtr, &record, &payload, sizeof(payload));
+} // logOrg
+
+uint64_t logDonation(DonationLog *logPtr, const OrgNode *nodePtr,
+                     Cents donation)
+{
+    LogRecord record = {0, LOG_DONATION_RECORD, nodePtr->logNum, donation};
+
+    return appendLogRecord(logPtr, &record, NULL, 0);
+} // logDonation
+
+uint64_t appendLogRecord(DonationLog *logPtr, LogRecord *recordPtr,
+                         const void *payload, size_t payloadSize)
+{
+    recordPtr->checksum = logChecksum(recordPtr, payload, payloadSize);
+    size_t size = sizeof(LogRecord) + payloadSize;
+
+    mtx_lock(&logPtr->mutex);
+
+    // when the half being filled is full, have it committed now
+    while (logPtr->fillUsed + size > LOG_BUFFER_SIZE && !logPtr->failed) {
+        logPtr->flushNow = true;
+        cnd_signal(&logPtr->workReady);
+        cnd_wait(&logPtr->committed, &logPtr->mutex);
+    }
+
+    if (!logPtr->failed) {
+        memcpy(logPtr->fillData + logPtr->fillUsed, recordPtr, sizeof(LogRecord));
+        if (payloadSize > 0) {
+            memcpy(logPtr->fillData + logPtr->fillUsed + sizeof(LogRecord),
+                   payload, payloadSize);
+        }
+        logPtr->fillUsed += size;
+        logPtr->appendedRecords++;
+
+        // the first record of a group sets when the group must be committed
+        // by, so the thread is woken to wait for that
+        uint64_t waiting = logPtr->appendedRecords - logPtr->takenRecords;
+        if (waiting == 1) {
+            timespec_get(&logPtr->groupDeadline, TIME_UTC);
+            long nanos = logPtr->groupDeadline.tv_nsec +
+                         logPtr->maxDelayMicros % MICROS_PER_SECOND *
+                         NANOS_PER_MICRO;
+            logPtr->groupDeadline.tv_sec += logPtr->maxDelayMicros /
+                                            MICROS_PER_SECOND +
+                                            nanos / NANOS_PER_SECOND;
+            logPtr->groupDeadline.tv_nsec = nanos % NANOS_PER_SECOND;
+        }
+        if (waiting == 1 || waiting >= logPtr->groupSize) {
+            cnd_signal(&logPtr->workReady);
+        }
+    }
+
+    // a record which was never appended can never become durable
+    uint64_t sequence = logPtr->failed ? LOG_FAILED_SEQUENCE
+                                       : logPtr->appendedRecords;
+
+    mtx_unlock(&logPtr->mutex);
+
+    return sequence;
+} // appendLogRecord
+
+bool waitForLogCommit(DonationLog *logPtr, uint64_t sequence)
+{
+    mtx_lock(&logPtr->mutex);
+
+    while (logPtr->durableRecords < sequence && !logPtr->failed) {
+        cnd_wait(&logPtr->committed, &logPtr->mutex);
+    }
+    bool durable = logPtr->durableRecords >= sequence;
+
+    mtx_unlock(&logPtr->mutex);
+
+    return durable;
+} // waitForLogCommit
+
+int donationLogThread(void *logArgPtr)
+{
+    DonationLog *logPtr = logArgPtr;
+    bool running = true;
+
+    mtx_lock(&logPtr->mutex);
+
+    while (running) {
+        uint64_t waiting = logPtr->appendedRecords - logPtr->takenRecords;
+        bool timedOut = false;
+
+        // wait for a whole group, the oldest record's deadline, a full
+        // buffer or the log to be closed
+        while (waiting < logPtr->groupSize && !timedOut && !logPtr->flushNow &&
+                !logPtr->stopping) {
+            if (waiting == 0) {
+                cnd_wait(&logPtr->workReady, &logPtr->mutex);
+            } else {
+                timedOut = cnd_timedwait(&logPtr->workReady, &logPtr->mutex,
+                                         &logPtr->groupDeadline) == thrd_timedout;
+            }
+
+            waiting = logPtr->appendedRecords - logPtr->takenRecords;
+        }
+
+        if (waiting > 0) {
+            // swap the halves so appending can go on while the group is synced
+            char *groupData = logPtr->fillData;
+            size_t groupSize = logPtr->fillUsed;
+            uint64_t groupEnd = logPtr->appendedRecords;
+            logPtr->fillData = logPtr->flushData;
+            logPtr->flushData = groupData;
+            logPtr->fillUsed = 0;
+            logPtr->takenRecords = groupEnd;
+            logPtr->flushNow = false;
+            cnd_broadcast(&logPtr->committed);
+
+            mtx_unlock(&logPtr->mutex);
+
+            size_t written = 0;
+            ssize_t result = 0;
+            while (written < groupSize && result >= 0) {
+                result = write(logPtr->fd, groupData + written,
+                               groupSize - written);
+                if (result > 0) {
+                    written += result;
+                } else if (result < 0 && errno == EINTR) {
+                    result = 0;
+                }
+            }
+            bool synced = written == groupSize && fdatasync(logPtr->fd) == 0;
+
+            mtx_lock(&logPtr->mutex);
+
+            if (synced) {
+                logPtr->durableRecords = groupEnd;
+                logPtr->numSyncs++;
+            } else {
+                logPtr->failed = true;
+            }
+            cnd_broadcast(&logPtr->committed);
+        } else if (logPtr->stopping) {
+            running = false;
+        }
+    }
+
+    mtx_unlock(&logPtr->mutex);
+
+    return 0;
+} // donationLogThread
+
+uint64_t logChecksum(const LogRecord *recordPtr, const void *payload,
+                     size_t payloadSize)
+{
+    uint64_t checksum = FNV_OFFSET_BASIS;
+    const unsigned char *parts[2] = {
+        (const unsigned char *) recordPtr + sizeof(recordPtr->checksum), payload
+    };
+    size_t partSizes[2] = {
+        sizeof(LogRecord) - sizeof(recordPtr->checksum), payloadSize
+    };
+
+    // a word at a time, since the log is replayed hundreds of millions of
+    // records at once
+    for (size_t part = 0; part < 2; part++) {
+        for (size_t i = 0; i < partSizes[part]; i += sizeof(uint64_t)) {
+            uint64_t word;
+            memcpy(&word, parts[part] + i, sizeof(word));
+            checksum ^= word;
+            checksum *= FNV_PRIME;
+        }
+    }
+
+    return checksum;
+} // logChecksum
+
+bool closeDonationLog(DonationLog *logPtr)
+{
+    mtx_lock(&logPtr->mutex);
+    logPtr->stopping = true;
+    cnd_signal(&logPtr->workReady);
+    mtx_unlock(&logPtr->mutex);
+
+    thrd_join(logPtr->thread, NULL);
+
+    bool committed = !logPtr->failed &&
+                     logPtr->durableRecords == logPtr->appendedRecords;
+
+    close(logPtr->fd);
+    free(logPtr->fillData);
+    free(logPtr->flushData);
+    mtx_destroy(&logPtr->mutex);
+    cnd_destroy(&logPtr->workReady);
+    cnd_destroy(&logPtr->committed);
+
+    return committed;
+} // closeDonationLog
+
+bool startDonationEngine(DonationEngine *enginePtr, size_t numWorkers)
+{
+    enginePtr->numWorkers = 0;
+    atomic_init(&enginePtr->stopping, false);
+    enginePtr->pausedWorkers = 0;
+    enginePtr->snapshotEpoch = 0;
+    mtx_init(&enginePtr->snapshotMutex, mtx_plain);
+    mtx_init(&enginePtr->pauseMutex, mtx_plain);
+    cnd_init(&enginePtr->allPaused);
+    cnd_init(&enginePtr->resumed);
+
+    // the workers are aligned so their queue positions start cache lines
+    enginePtr->workers = aligned_alloc(CACHE_LINE_SIZE,
+                                       numWorkers * sizeof(DonationWorker));
+    bool started = enginePtr->workers != NULL;
+
+    for (size_t i = 0; i < numWorkers && started; i++) {
+        DonationWorker *workerPtr = &enginePtr->workers[i];
+        workerPtr->cells = malloc(ENGINE_QUEUE_SIZE * sizeof(TaskCell));
+        started = workerPtr->cells != NULL;
+
+        if (started) {
+            // a cell may be written once its sequence equals the position
+            for (size_t cell = 0; cell < ENGINE_QUEUE_SIZE; cell++) {
+                atomic_init(&workerPtr->cells[cell].sequence, cell);
+            }
+            atomic_init(&workerPtr->enqueuePos, 0);
+            workerPtr->dequeuePos = 0;
+            workerPtr->mask = ENGINE_QUEUE_SIZE - 1;
+            workerPtr->enginePtr = enginePtr;
+            atomic_init(&workerPtr->sleeping, false);
+            mtx_init(&workerPtr->sleepMutex, mtx_plain);
+            cnd_init(&workerPtr->wakeUp);
+
+            started = thrd_create(&workerPtr->thread, donationWorkerThread,
+                                  workerPtr) == thrd_success;
+            if (started) {
+                enginePtr->numWorkers++;
+            } else {
+                free(workerPtr->cells);
+                mtx_destroy(&workerPtr->sleepMutex);
+                cnd_destroy(&workerPtr->wakeUp);
+            }
+        }
+    }
+
+    // stop whichever workers did start
+    if (!started) {
+        fputs("Could not start the donation engine\n", stderr);
+        if (enginePtr->workers != NULL) {
+            stopDonationEngine(enginePtr);
+        } else {
+            mtx_destroy(&enginePtr->snapshotMutex);
+            mtx_destroy(&enginePtr->pauseMutex);
+            cnd_destroy(&enginePtr->allPaused);
+            cnd_destroy(&enginePtr->resumed);
+        }
+    }
+
+    return started;
+} // startDonationEngine
+
+void submitDonation(DonationEngine *enginePtr, OrgNode *nodePtr,
+                    Cents donation)
+{
+    // use the high half of the hash, since the index uses the low bits
+    size_t shard = (nodePtr->keyHash >> 32) % enginePtr->numWorkers;
+    DonationTask task = {nodePtr, donation, 0};
+
+    pushDonationTask(&enginePtr->workers[shard], task);
+} // submitDonation
+
+bool tryPushDonationTask(DonationWorker *workerPtr, DonationTask task)
+{
+    bool pushed = false;
+    bool full = false;
+    size_t pos = atomic_load_explicit(&workerPtr->enqueuePos,
+                                      memory_order_relaxed);
+
+    while (!pushed && !full) {
+        TaskCell *cellPtr = &workerPtr->cells[pos & workerPtr->mask];
+        size_t sequence = atomic_load_explicit(&cellPtr->sequence,
+                                               memory_order_acquire);
+        intptr_t difference = (intptr_t) sequence - (intptr_t) pos;
+
+        if (difference == 0) {
+            // claim the cell; on failure pos is reloaded and we try again
+            if (atomic_compare_exchange_weak_explicit(&workerPtr->enqueuePos,
+                    &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) {
+                cellPtr->task = task;
+                atomic_store_explicit(&cellPtr->sequence, pos + 1,
+                                      memory_order_release);
+                pushed = true;
+            }
+        } else if (difference < 0) {
+            // the worker has not taken the task a lap ago yet
+            full = true;
+        } else {
+            pos = atomic_load_explicit(&workerPtr->enqueuePos,
+                                       memory_order_relaxed);
+        }
+    }
+
+    return pushed;
+} // tryPushDonationTask
+
+void pushDonationTask(DonationWorker *workerPtr, DonationTask task)
+{
+    while (!tryPushDonationTask(workerPtr, task)) {
+        thrd_yield();
+    }
+
+    wakeDonationWorker(workerPtr);
+} // pushDonationTask
+
+void wakeDonationWorker(DonationWorker *workerPtr)
+{
+    // pairs with the fence in sleepDonationWorker(): either the worker sees
+    // the task just pushed, or this sees the worker is sleeping
+    atomic_thread_fence(memory_order_seq_cst);
+
+    if (atomic_load_explicit(&workerPtr->sleeping, memory_order_relaxed)) {
+        mtx_lock(&workerPtr->sleepMutex);
+        atomic_store_explicit(&workerPtr->sleeping, false, memory_order_relaxed);
+        cnd_signal(&workerPtr->wakeUp);
+        mtx_unlock(&workerPtr->sleepMutex);
+    }
+} // wakeDonationWorker
+
+void sleepDonationWorker(DonationWorker *workerPtr)
+{
+    atomic_store_explicit(&workerPtr->sleeping, true, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+    // a task pushed before the flag was seen is still in the queue
+    if (!hasDonationTask(workerPtr) &&
+            !atomic_load(&workerPtr->enginePtr->stopping)) {
+        mtx_lock(&workerPtr->sleepMutex);
+        while (atomic_load_explicit(&workerPtr->sleeping, memory_order_relaxed)) {
+            cnd_wait(&workerPtr->wakeUp, &workerPtr->sleepMutex);
+        }
+        mtx_unlock(&workerPtr->sleepMutex);
+    }
+
+    atomic_store_explicit(&workerPtr->sleeping, false, memory_order_relaxed);
+} // sleepDonationWorker
+
+bool popDonationTask(DonationWorker *workerPtr, DonationTask *taskPtr)
+{
+    size_t pos = workerPtr->dequeuePos;
+    TaskCell *cellPtr = &workerPtr->cells[pos & workerPtr->mask];
+    bool popped = atomic_load_explicit(&cellPtr->sequence,
+                                       memory_order_acquire) == pos + 1;
+
+    if (popped) {
+        *taskPtr = cellPtr->task;
+
+        // hand the cell back to producers for the next lap
+        atomic_store_explicit(&cellPtr->sequence, pos + workerPtr->mask + 1,
+                              memory_order_release);
+        workerPtr->dequeuePos = pos + 1;
+    }
+
+    return popped;
+} // popDonationTask
+
+bool hasDonationTask(const DonationWorker *workerPtr)
+{
+    size_t pos = workerPtr->dequeuePos;
+    const TaskCell *cellPtr = &workerPtr->cells[pos & workerPtr->mask];
+
+    return atomic_load_explicit(&cellPtr->sequence,
+                                memory_order_acquire) == pos + 1;
+} // hasDonationTask
+
+int donationWorkerThread(void *workerArgPtr)
+{
+    DonationWorker *workerPtr = workerArgPtr;
+    DonationEngine *enginePtr = workerPtr->enginePtr;
+    DonationTask task;
+    bool running = true;
+    size_t idleSpins = 0;
+
+    while (running) {
+        // read the flag first: everything queued before it was set is then
+        // visible, so an empty queue means the worker is done
+        bool stopping = atomic_load(&enginePtr->stopping);
+
+        if (popDonationTask(workerPtr, &task)) {
+            idleSpins = 0;
+
+            if (task.nodePtr != NULL) {
+                addDonation(&task.nodePtr->org, task.donation);
+            } else {
+                // pause until the snapshot has been copied
+                mtx_lock(&enginePtr->pauseMutex);
+                enginePtr->pausedWorkers++;
+                if (enginePtr->pausedWorkers == enginePtr->numWorkers) {
+                    cnd_signal(&enginePtr->allPaused);
+                }
+                while (enginePtr->snapshotEpoch == task.snapshotEpoch) {
+                    cnd_wait(&enginePtr->resumed, &enginePtr->pauseMutex);
+                }
+                mtx_unlock(&enginePtr->pauseMutex);
+            }
+        } else if (stopping) {
+            running = false;
+        } else if (++idleSpins < ENGINE_IDLE_SPINS) {
+            thrd_yield();
+        } else {
+            sleepDonationWorker(workerPtr);
+            idleSpins = 0;
+        }
+    }
+
+    return 0;
+} // donationWorkerThread
+
+size_t snapshotDonationEngine(DonationEngine *enginePtr, const OrgList *listPtr,
+                              OrgTotals totals[])
+{
+    mtx_lock(&enginePtr->snapshotMutex);
+
+    // queue a pause behind whatever each worker already has; only this
+    // thread changes the epoch, and it holds snapshotMutex
+    DonationTask pauseTask = {NULL, 0, enginePtr->snapshotEpoch};
+    for (size_t i = 0; i < enginePtr->numWorkers; i++) {
+        pushDonationTask(&enginePtr->workers[i], pauseTask);
+    }
+
+    mtx_lock(&enginePtr->pauseMutex);
+    while (enginePtr->pausedWorkers < enginePtr->numWorkers) {
+        cnd_wait(&enginePtr->allPaused, &enginePtr->pauseMutex);
+    }
+
+    // no counter changes while every worker is paused
+    size_t numTotals = copyOrgTotals(listPtr, totals);
+
+    enginePtr->pausedWorkers = 0;
+    enginePtr->snapshotEpoch++;
+    cnd_broadcast(&enginePtr->resumed);
+    mtx_unlock(&enginePtr->pauseMutex);
+
+    mtx_unlock(&enginePtr->snapshotMutex);
+
+    return numTotals;
+} // snapshotDonationEngine
+
+size_t copyOrgTotals(const OrgList *listPtr, OrgTotals totals[])
+{
+    size_t numTotals = 0;
+
+    for (const OrgNode *currNodePtr = listPtr->headPtr; currNodePtr != NULL;
+            currNodePtr = currNodePtr->nextNodePtr) {
+        const Organization *org = &currNodePtr->org;
+        OrgTotals orgTotals = {org->name, org->numDonations, org->numDonors,
+                               org->donationSum, org->feesSum};
+        totals[numTotals] = orgTotals;
+        numTotals++;
+    }
+
+    return numTotals;
+} // copyOrgTotals
+
+void stopDonationEngine(DonationEngine *enginePtr)
+{
+    atomic_store(&enginePtr->stopping, true);
+
+    for (size_t i = 0; i < enginePtr->numWorkers; i++) {
+        DonationWorker *workerPtr = &enginePtr->workers[i];
+
+        wakeDonationWorker(workerPtr);
+        thrd_join(workerPtr->thread, NULL);
+        free(workerPtr->cells);
+        mtx_destroy(&workerPtr->sleepMutex);
+        cnd_destroy(&workerPtr->wakeUp);
+    }
+
+    free(enginePtr->workers);
+    enginePtr->workers = NULL;
+    enginePtr->numWorkers = 0;
+
+    mtx_destroy(&enginePtr->snapshotMutex);
+    mtx_destroy(&enginePtr->pauseMutex);
+    cnd_destroy(&enginePtr->allPaused);
+    cnd_destroy(&enginePtr->resumed);
+} // stopDonationEngine
+
+bool reserveOrgColumnRow(OrgColumns *columnsPtr)
+{
+    bool reserved = true;
+    OrgColumnBlock *tailBlockPtr = columnsPtr->tailBlockPtr;
+
+    // start a new block once the last one is full
+    if (tailBlockPtr == NULL || tailBlockPtr->count == COLUMN_BLOCK_ROWS) {
+        OrgColumnBlock *newBlockPtr = malloc(sizeof(OrgColumnBlock));
+        reserved = newBlockPtr != NULL;
+
+        if (reserved) {
+            newBlockPtr->count = 0;
+            newBlockPtr->nextBlockPtr = NULL;
+
+            if (tailBlockPtr == NULL) {
+                columnsPtr->headBlockPtr = newBlockPtr;
+            } else {
+                tailBlockPtr->nextBlockPtr = newBlockPtr;
+            }
+            columnsPtr->tailBlockPtr = newBlockPtr;
+        }
+    }
+
+    return reserved;
+} // reserveOrgColumnRow
+
+bool addOrgColumnRow(OrgColumns *columnsPtr, const OrgNode *nodePtr)
+{
+    bool added = reserveOrgColumnRow(columnsPtr);
+
+    if (added) {
+        OrgColumnBlock *blockPtr = columnsPtr->tailBlockPtr;
+        const Organization *org = &nodePtr->org;
+        size_t slot = blockPtr->count;
+
+        blockPtr->goals[slot] = org->goalAmount;
+        blockPtr->raised[slot] = org->donationSum;
+        blockPtr->fees[slot] = org->feesSum;
+        blockPtr->numDonations[slot] = org->numDonations;
+        blockPtr->nodes[slot] = nodePtr;
+        blockPtr->count++;
+        columnsPtr->count++;
+    }
+
+    return added;
+} // addOrgColumnRow
+
+void freeOrgColumns(OrgColumns *columnsPtr)
+{
+    OrgColumnBlock *currBlockPtr = columnsPtr->headBlockPtr;
+
+    while (currBlockPtr != NULL) {
+        OrgColumnBlock *nextBlockPtr = currBlockPtr->nextBlockPtr;
+        free(currBlockPtr);
+        currBlockPtr = nextBlockPtr;
+    }
+
+    columnsPtr->headBlockPtr = NULL;
+    columnsPtr->tailBlockPtr = NULL;
+    columnsPtr->count = 0;
+} // freeOrgColumns
+
+void totalOrgColumns(const OrgColumns *columnsPtr, ReportTotals *totalsPtr)
+{
+    // keep the sums in locals so the loops do not store through the pointer
+    Cents goalsSum = 0;
+    Cents raisedSum = 0;
+    Cents feesSum = 0;
+    uint64_t donationsSum = 0;
+    size_t numAtGoal = 0;
+
+    for (const OrgColumnBlock *blockPtr = columnsPtr->headBlockPtr;
+            blockPtr != NULL; blockPtr = blockPtr->nextBlockPtr) {
+        const Cents *goals = blockPtr->goals;
+        const Cents *raised = blockPtr->raised;
+        const Cents *fees = blockPtr->fees;
+        const unsigned int *numDonations = blockPtr->numDonations;
+        size_t count = blockPtr->count;
+
+        for (size_t i = 0; i < count; i++) {
+            goalsSum += goals[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            raisedSum += raised[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            feesSum += fees[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            donationsSum += numDonations[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            numAtGoal += raised[i] >= goals[i];
+        }
+    }
+
+    totalsPtr->numOrgs = columnsPtr->count;
+    totalsPtr->goals = goalsSum;
+    totalsPtr->raised = raisedSum;
+    totalsPtr->fees = feesSum;
+    totalsPtr->numDonations = donationsSum;
+    totalsPtr->numAtGoal = numAtGoal;
+} // totalOrgColumns
+
+void percentOfGoal(const OrgColumns *columnsPtr, double percents[])
+{
+    for (const OrgColumnBlock *blockPtr = columnsPtr->headBlockPtr;
+            blockPtr != NULL; blockPtr = blockPtr->nextBlockPtr) {
+        const Cents *goals = blockPtr->goals;
+        const Cents *raised = blockPtr->raised;
+
+        for (size_t i = 0; i < blockPtr->count; i++) {
+            percents[i] = (double) raised[i] * 100 / goals[i];
+        }
+        percents += blockPtr->count;
+    }
+} // percentOfGoal
+
+size_t topOrgsByRaised(const OrgColumns *columnsPtr, size_t numTop,
+                       TopOrg top[])
+{
+    size_t heapSize = 0;
+    size_t firstRow = 0;
+
+    // once the heap is full, most rows raised less than its least and are
+    // passed over with one compare
+    for (const OrgColumnBlock *blockPtr = columnsPtr->headBlockPtr;
+            blockPtr != NULL; blockPtr = blockPtr->nextBlockPtr) {
+        const Cents *raised = blockPtr->raised;
+
+        for (size_t i = 0; i < blockPtr->count; i++) {
+            if (heapSize < numTop || raised[i] > top[0].raised) {
+                TopOrg candidate = {raised[i], firstRow + i, blockPtr->nodes[i]};
+                offerTopOrg(top, &heapSize, numTop, candidate);
+            }
+        }
+        firstRow += blockPtr->count;
+    }
+
+    qsort(top, heapSize, sizeof(TopOrg), compareTopOrgs);
+
+    return heapSize;
+} // topOrgsByRaised
+
+void offerTopOrg(TopOrg heap[], size_t *heapSizePtr, size_t numTop,
+                 TopOrg candidate)
+{
+    size_t heapSize = *heapSizePtr;
+    size_t pos = 0;
+    bool sifting = true;
+
+    if (heapSize < numTop) {
+        // sift the new org up from the end
+        pos = heapSize;
+        while (pos > 0 && ranksAbove(heap[(pos - 1) / 2], candidate)) {
+            heap[pos] = heap[(pos - 1) / 2];
+            pos = (pos - 1) / 2;
+        }
+        heap[pos] = candidate;
+        *heapSizePtr = heapSize + 1;
+    } else if (numTop > 0 && ranksAbove(candidate, heap[0])) {
+        // replace the lowest ranked org and sift the new one down
+        while (sifting) {
+            size_t child = 2 * pos + 1;
+            if (child + 1 < heapSize && ranksAbove(heap[child], heap[child + 1])) {
+                child++;
+            }
+
+            if (child < heapSize && ranksAbove(candidate, heap[child])) {
+                heap[pos] = heap[child];
+                pos = child;
+            } else {
+                sifting = false;
+            }
+        }
+        heap[pos] = candidate;
+    }
+} // offerTopOrg
+
+bool ranksAbove(TopOrg org1, TopOrg org2)
+{
+    return org1.raised > org2.raised ||
+           (org1.raised == org2.raised && org1.row < org2.row);
+} // ranksAbove
+
+int compareTopOrgs(const void *org1Ptr, const void *org2Ptr)
+{
+    const TopOrg *org1 = org1Ptr;
+    const TopOrg *org2 = org2Ptr;
+
+    return ranksAbove(*org2, *org1) - ranksAbove(*org1, *org2);
+} // compareTopOrgs
+
+void fPrintColumnReport(FILE *stream, const ReportTotals *totalsPtr,
+                        const TopOrg top[], size_t numTop)
+{
+    char goals[MONEY_STRING_SIZE];
+    char raised[MONEY_STRING_SIZE];
+    char fees[MONEY_STRING_SIZE];
+    formatCents(totalsPtr->goals, goals);
+    formatCents(totalsPtr->raised, raised);
+    formatCents(totalsPtr->fees, fees);
+
+    fprintf(stream, "Organizations: %zu, %zu at their goal\n", totalsPtr->numOrgs,
+            totalsPtr->numAtGoal);
+    fprintf(stream, "Total Number of Donations: %llu\n",
+            (unsigned long long) totalsPtr->numDonations);
+    fprintf(stream, "Total amount raised: $%s of $%s in goals\n", raised, goals);
+    fprintf(stream, "Total Credit Card processing: $%s\n", fees);
+    fputs("\n", stream);
+
+    fprintf(stream, "%-4s%-24s%16s%12s\n", "#", "Organization", "Raised",
+            "Of goal");
+    for (size_t i = 0; i < numTop; i++) {
+        // put the dollar sign right before the amount so it aligns right;
+        // only the top rows read their names and goals from the nodes
+        const Organization *org = &top[i].nodePtr->org;
+        raised[0] = '$';
+        formatCents(top[i].raised, raised + 1);
+        fprintf(stream, "%-4zu%-24s%16s%11.1f%%\n", i + 1, org->name, raised,
+                (double) top[i].raised * 100 / org->goalAmount);
+    }
+} // fPrintColumnReport
+
+bool fPrintOrgReport(FILE *stream, const OrgColumns *columnsPtr,
+                     size_t numTop)
+{
+    TopOrg *top = malloc(numTop * sizeof(TopOrg) + 1);
+    bool printed = top != NULL;
+
+    if (printed) {
+        ReportTotals totals;
+        totalOrgColumns(columnsPtr, &totals);
+        size_t numFound = topOrgsByRaised(columnsPtr, numTop, top);
+        fPrintColumnReport(stream, &totals, top, numFound);
+    }
+
+    free(top);
+
+    return printed;
+} // fPrintOrgReport
+
+int runBatchMode(const char *path, size_t numThreads)
+{
+    int exitStatus = EXIT_SUCCESS;
+
+    FILE *stream = stdin;
+    if (strcmp(path, BATCH_STDIN_PATH) != 0) {
+        stream = fopen(path, "rb");
+    }
+
+    if (stream == NULL) {
+        fprintf(stderr, "Could not open %s: %s\n", path, strerror(errno));
+        exitStatus = EXIT_FAILURE;
+    } else {
+        OrgList list;
+        initOrgList(&list);
+        ReceiptWriter writer;
+        DonationEngine engine;
+        BatchRun run = {&list, &writer, NULL, {0, 0, 0, 0, 0}, '\0'};
+
+        // the time includes writing out every receipt and applying every
+        // donation
+        double start = secondsNow();
+        bool writerStarted = startReceiptWriter(&writer);
+        bool readAll = writerStarted;
+        if (readAll && numThreads > 0) {
+            readAll = startDonationEngine(&engine, numThreads);
+            run.enginePtr = readAll ? &engine : NULL;
+        }
+        if (readAll) {
+            readAll = ingestBatch(stream, &run);
+        }
+
+        // the summaries come from a snapshot taken after every donation
+        // which was read, as the report mode would see them
+        OrgTotals *totals = malloc((run.stats.orgs + 1) * sizeof(OrgTotals));
+        size_t numTotals = 0;
+        if (totals == NULL) {
+            puts(MEM_ERROR);
+        } else if (run.enginePtr != NULL) {
+            numTotals = snapshotDonationEngine(&engine, &list, totals);
+        } else {
+            numTotals = copyOrgTotals(&list, totals);
+        }
+
+        if (run.enginePtr != NULL) {
+            stopDonationEngine(&engine);
+        }
+        if (writerStarted) {
+            readAll = stopReceiptWriter(&writer) && readAll;
+        }
+        double seconds = secondsNow() - start;
+
+        if (stream != stdin) {
+            fclose(stream);
+        }
+
+        // write every organization's summary, as the report mode does
+        FILE *orgsFile = fopen(ORGS_PATH, FILE_WRITE_MODE);
+        if (orgsFile != NULL) {
+            for (size_t i = 0; i < numTotals; i++) {
+                fPrintTotals(orgsFile, &totals[i]);
+            }
+
+            fclose(orgsFile);
+        }
+
+        BatchStats stats = run.stats;
+        printf("Records: %zu (%zu orgs, %zu donations, %zu receipts, "
+               "%zu rejected)\n", stats.records, stats.orgs, stats.donations,
+               stats.receipts, stats.rejected);
+        printf("Replayed in %.3f s: %.0f records/s\n", seconds,
+               stats.records / seconds);
+        printf("Summaries written to %s\n", ORGS_PATH);
+
+        if (!readAll || totals == NULL || orgsFile == NULL) {
+            exitStatus = EXIT_FAILURE;
+        }
+
+        free(totals);
+        emptyList(&list);
+    }
+
+    return exitStatus;
+} // runBatchMode
+
+bool ingestBatch(FILE *stream, BatchRun *runPtr)
+{
+    // one spare byte to end a last line which has no newline
+    char *buffer = malloc(BATCH_BUFFER_SIZE + 1);
+    bool readAll = buffer != NULL;
+
+    size_t used = 0;
+    size_t lineNum = 0;
+    bool atEnd = !readAll;
+    bool skippingLine = false;
+
+    while (!atEnd) {
+        size_t numRead = fread(buffer + used, 1, BATCH_BUFFER_SIZE - used, stream);
+        used += numRead;
+        atEnd = numRead == 0;
+
+        if (atEnd && used > 0) {
+            buffer[used] = '\n';
+            used++;
+        }
+
+        // hand off every complete line, ending each where its newline was
+        char *lineStart = buffer;
+        char *bufferEnd = buffer + used;
+        char *newlinePtr = memchr(lineStart, '\n', used);
+
+        while (newlinePtr != NULL) {
+            *newlinePtr = '\0';
+            if (newlinePtr > lineStart && newlinePtr[-1] == '\r') {
+                newlinePtr[-1] = '\0';
+            }
+
+            lineNum++;
+
+            // the rest of a line that was too long was already rejected
+            if (skippingLine) {
+                skippingLine = false;
+            } else {
+                processBatchLine(lineStart, lineNum, runPtr);
+            }
+
+            lineStart = newlinePtr + 1;
+            newlinePtr = memchr(lineStart, '\n', bufferEnd - lineStart);
+        }
+
+        // keep the start of an unfinished line for the next read, unless it
+        // fills the whole buffer
+        used = bufferEnd - lineStart;
+        if (used == BATCH_BUFFER_SIZE) {
+            rejectBatchRecord(&runPtr->stats, lineNum + 1, "line too long");
+            skippingLine = true;
+            used = 0;
+        } else {
+            memmove(buffer, lineStart, used);
+        }
+    }
+
+    if (buffer == NULL) {
+        puts(MEM_ERROR);
+    } else if (ferror(stream)) {
+        fprintf(stderr, "Read error after line %zu\n", lineNum);
+        readAll = false;
+    }
+
+    free(buffer);
+
+    return readAll;
+} // ingestBatch
+
+void processBatchLine(char *line, size_t lineNum, BatchRun *runPtr)
+{
+    // skip blank lines and comments
+    if (*line != '\0' && *line != BATCH_COMMENT_CHAR) {
+        if (runPtr->separator == '\0') {
+            runPtr->separator = strchr(line, '\t') != NULL ? '\t' : ',';
+        }
+
+        char *fields[BATCH_MAX_FIELDS];
+        size_t numFields = splitFields(line, runPtr->separator, fields,
+                                       BATCH_MAX_FIELDS);
+        const char *error = NULL;
+
+        runPtr->stats.records++;
+
+        if (strcmp(fields[0], BATCH_ORG_RECORD) == 0) {
+            if (numFields != BATCH_ORG_FIELDS) {
+                error = "org records have 7 fields";
+            } else {
+                error = batchRegisterOrg(runPtr->listPtr, fields);
+            }
+
+            if (error == NULL) {
+                runPtr->stats.orgs++;
+            }
+        } else if (strcmp(fields[0], BATCH_DONATION_RECORD) == 0) {
+            if (numFields < BATCH_MIN_DONATION_FIELDS ||
+                    numFields > BATCH_MAX_DONATION_FIELDS) {
+                error = "donation records have 5 or 6 fields";
+            } else {
+                error = batchDonate(runPtr, fields, numFields);
+            }
+        } else {
+            error = "unknown record type";
+        }
+
+        if (error != NULL) {
+            rejectBatchRecord(&runPtr->stats, lineNum, error);
+        }
+    }
+} // processBatchLine
+
+size_t splitFields(char *line, char separator, char *fields[], size_t maxFields)
+{
+    size_t numFields = 1;
+    fields[0] = line;
+
+    // end the current field at each separator and start the next after it
+    char *separatorPtr = strchr(line, separator);
+    while (separatorPtr != NULL && numFields <= maxFields) {
+        *separatorPtr = '\0';
+
+        if (numFields < maxFields) {
+            fields[numFields] = separatorPtr + 1;
+        }
+
+        numFields++;
+        separatorPtr = strchr(separatorPtr + 1, separator);
+    }
+
+    return numFields;
+} // splitFields
+
+const char *batchRegisterOrg(OrgList *listPtr, char *fields[])
+{
+    const char *error = NULL;
+    Cents goal;
+
+    if (fields[1][0] == '\0') {
+        error = "missing organization name";
+    } else if (findIndexedOrg(&listPtr->index, fields[1]) != NULL) {
+        error = "organization already registered";
+    } else if (!strToCents(fields[2], &goal, MIN_GOAL)) {
+        error = "invalid goal amount";
+    } else if (!isEmail(fields[5])) {
+        error = "invalid email";
+    } else if (!isPassword(fields[6])) {
+        error = "invalid password";
+    } else {
+        OrgNode *newNodePtr = newOrgNode(listPtr);
+
+        if (newNodePtr == NULL) {
+            error = MEM_ERROR;
+        } else {
+            // build the organization in place in its node
+            Organization *org = &newNodePtr->org;
+            strNCpySafe(org->name, fields[1], STRING_SIZE - 1);
+            strNCpySafe(org->purpose, fields[3], STRING_SIZE - 1);
+            strNCpySafe(org->ownerFirstLastName, fields[4], STRING_SIZE - 1);
+            strNCpySafe(org->ownerEmail, fields[5], STRING_SIZE - 1);
+            strNCpySafe(org->ownerPwd, fields[6], STRING_SIZE - 1);
+            org->goalAmount = goal;
+            initOrgTotals(org);
+
+            // Create the receipts file, if it already exists, wipe it
+            FILE *receiptsFile = fopen(org->receiptPath, FILE_WRITE_MODE);
+            if (receiptsFile != NULL) {
+                fclose(receiptsFile);
+            }
+
+            linkOrgNode(listPtr, newNodePtr);
+        }
+    }
+
+    return error;
+} // batchRegisterOrg
+
+const char *batchDonate(BatchRun *runPtr, char *fields[], size_t numFields)
+{
+    const char *error = NULL;
+    OrgNode *orgNodePtr = findIndexedOrg(&runPtr->listPtr->index, fields[1]);
+    Cents donation;
+    bool wantsReceipt = false;
+
+    if (numFields == BATCH_MAX_DONATION_FIELDS) {
+        // fields come straight from the file and may be any length, so
+        // use the bounded match instead of caselessStrcmp()
+        wantsReceipt = isCaselessMatch(fields[5], YES);
+    }
+
+    if (orgNodePtr == NULL) {
+        error = "organization not registered";
+    } else if (!strToCents(fields[2], &donation, MIN_DONATION)) {
+        error = "invalid donation amount";
+    } else if (!isZip(fields[4])) {
+        error = "invalid zip code";
+    } else if (numFields == BATCH_MAX_DONATION_FIELDS && !isYesNo(fields[5])) {
+        error = "receipt must be (y)es or (n)o";
+    } else {
+        // the receipt only needs the name and amount, so it can be queued
+        // before a worker has applied the donation
+        if (runPtr->enginePtr == NULL) {
+            addDonation(&orgNodePtr->org, donation);
+        } else {
+            submitDonation(runPtr->enginePtr, orgNodePtr, donation);
+        }
+        runPtr->stats.donations++;
+
+        if (wantsReceipt && queueReceipt(runPtr->writerPtr, orgNodePtr, donation)) {
+            runPtr->stats.receipts++;
+        }
+    }
+
+    return error;
+} // batchDonate
+
+void rejectBatchRecord(BatchStats *statsPtr, size_t lineNum, const char *error)
+{
+    statsPtr->rejected++;
+
+    if (statsPtr->rejected <= BATCH_MAX_REPORTED_ERRORS) {
+        fprintf(stderr, "Line %zu rejected: %s\n", lineNum, error);
+    } else if (statsPtr->rejected == BATCH_MAX_REPORTED_ERRORS + 1) {
+        fputs("Further rejected lines are only counted\n", stderr);
+    }
+} // rejectBatchRecord
+
+void makeBatch(size_t numOrgs, size_t numDonations)
+{
+    puts("# record,name,goal,purpose,owner,email,password");
+    puts("# record,name,amount,donor,zip,receipt");
+
+    Organization org;
+    char goal[MONEY_STRING_SIZE];
+    for (size_t i = 0; i < numOrgs; i++) {
+        fillBenchOrg(&org, i);
+        formatCents(org.goalAmount, goal);
+        printf("%s,%s,%s,%s,%s,%s,%s\n", BATCH_ORG_RECORD, org.name,
+               goal, org.purpose, org.ownerFirstLastName,
+               org.ownerEmail, org.ownerPwd);
+    }
+
+    // donate to organizations named in lower case, asking for some receipts
+    unsigned int seed = 2060;
+    for (size_t i = 0; i < numDonations; i++) {
+        seed = seed * 1103515245 + 12345;
+        printf("%s,organization %07zu,%u.%02u,Bench Donor,15213,%s\n",
+               BATCH_DONATION_RECORD, (size_t) (seed >> 16) % numOrgs,
+               1 + (seed >> 4) % 500, (seed >> 8) % 100, i % MAKE_BATCH_RECEIPT_EVERY == 0 ? YES : NO);
+    }
+} // makeBatch
+
+int runCommandLineMode(int argc, char *argv[])
+{
+    int exitStatus = EXIT_SUCCESS;
+
+    // pick the mode by the first argument; later arguments are its options
+    if (strcmp(argv[1], BENCH_INDEX_ARG) == 0) {
+        size_t numOrgs = BENCH_DEFAULT_ORGS;
+        if (argc > 2) {
+            numOrgs = strtoul(argv[2], NULL, 10);
+        }
+
+        if (numOrgs == 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkOrgIndex(numOrgs)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_INSERT_ARG) == 0) {
+        size_t numOrgs = BENCH_INSERT_DEFAULT_ORGS;
+        if (argc > 2) {
+            numOrgs = strtoul(argv[2], NULL, 10);
+        }
+
+        if (numOrgs == 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkOrgInsert(numOrgs)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_RECEIPTS_ARG) == 0) {
+        size_t numReceipts = BENCH_RECEIPTS_DEFAULT;
+        if (argc > 2) {
+            numReceipts = strtoul(argv[2], NULL, 10);
+        }
+
+        if (!benchmarkReceipts(numReceipts)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_SNAPSHOT_ARG) == 0) {
+        size_t numOrgs = BENCH_SNAPSHOT_DEFAULT_ORGS;
+        if (argc > 2) {
+            numOrgs = strtoul(argv[2], NULL, 10);
+        }
+
+        if (!benchmarkSnapshot(numOrgs)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BATCH_ARG) == 0) {
+        const char *path = BATCH_STDIN_PATH;
+        size_t numThreads = 0;
+        if (argc > 2) {
+            path = argv[2];
+        }
+        if (argc > 3) {
+            numThreads = strtoul(argv[3], NULL, 10);
+        }
+
+        if (numThreads > ENGINE_MAX_WORKERS) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else {
+            exitStatus = runBatchMode(path, numThreads);
+        }
+    } else if (strcmp(argv[1], BENCH_ENGINE_ARG) == 0) {
+        // default to one thread per online core, within what the engine
+        // can run; sysconf() returns -1 if it cannot tell
+        long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+        size_t maxThreads = 1;
+        if (numCores > ENGINE_MAX_WORKERS) {
+            maxThreads = ENGINE_MAX_WORKERS;
+        } else if (numCores > 1) {
+            maxThreads = numCores;
+        }
+        size_t numDonations = BENCH_ENGINE_DEFAULT_DONATIONS;
+        if (argc > 2) {
+            maxThreads = strtoul(argv[2], NULL, 10);
+        }
+        if (argc > 3) {
+            numDonations = strtoul(argv[3], NULL, 10);
+        }
+
+        if (maxThreads < 1 || maxThreads > ENGINE_MAX_WORKERS) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkDonationEngine(maxThreads, numDonations)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_MONEY_ARG) == 0) {
+        size_t numDonations = BENCH_MONEY_DEFAULT_DONATIONS;
+        if (argc > 2) {
+            numDonations = strtoul(argv[2], NULL, 10);
+        }
+
+        if (!benchmarkMoney(numDonations)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_REPORT_ARG) == 0) {
+        size_t numOrgs = BENCH_REPORT_DEFAULT_ORGS;
+        size_t numTop = BENCH_REPORT_DEFAULT_TOP;
+        if (argc > 2) {
+            numOrgs = strtoul(argv[2], NULL, 10);
+        }
+        if (argc > 3) {
+            numTop = strtoul(argv[3], NULL, 10);
+        }
+
+        if (numOrgs == 0 || numTop == 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkReport(numOrgs, numTop)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], FUZZ_VALIDATORS_ARG) == 0) {
+        size_t numCases = FUZZ_VALIDATORS_DEFAULT_CASES;
+        if (argc > 2) {
+            numCases = strtoul(argv[2], NULL, 10);
+        }
+
+        if (!fuzzValidators(numCases)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_VALIDATORS_ARG) == 0) {
+        size_t numValidations = BENCH_VALIDATORS_DEFAULT;
+        if (argc > 2) {
+            numValidations = strtoul(argv[2], NULL, 10);
+        }
+
+        if (!benchmarkValidators(numValidations)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_LOG_ARG) == 0) {
+        size_t numDonations = BENCH_LOG_DEFAULT_DONATIONS;
+        long maxDelayMicros = LOG_DEFAULT_MAX_DELAY_MICROS;
+        if (argc > 2) {
+            numDonations = strtoul(argv[2], NULL, 10);
+        }
+        if (argc > 3) {
+            maxDelayMicros = strtol(argv[3], NULL, 10);
+        }
+
+        if (numDonations == 0 || maxDelayMicros < 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkDonationLog(numDonations, maxDelayMicros)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], BENCH_RECOVERY_ARG) == 0) {
+        size_t numRecords = BENCH_RECOVERY_DEFAULT_RECORDS;
+        if (argc > 2) {
+            numRecords = strtoul(argv[2], NULL, 10);
+        }
+
+        if (numRecords == 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else if (!benchmarkRecovery(numRecords)) {
+            exitStatus = EXIT_FAILURE;
+        }
+    } else if (strcmp(argv[1], MAKE_BATCH_ARG) == 0) {
+        size_t numOrgs = MAKE_BATCH_DEFAULT_ORGS;
+        size_t numDonations = MAKE_BATCH_DEFAULT_DONATIONS;
+        if (argc > 2) {
+            numOrgs = strtoul(argv[2], NULL, 10);
+        }
+        if (argc > 3) {
+            numDonations = strtoul(argv[3], NULL, 10);
+        }
+
+        if (numOrgs == 0) {
+            puts(USAGE_MESSAGE);
+            exitStatus = EXIT_FAILURE;
+        } else {
+            makeBatch(numOrgs, numDonations);
+        }
+    } else {
+        puts(USAGE_MESSAGE);
+        exitStatus = EXIT_FAILURE;
+    }
+
+    return exitStatus;
+} // runCommandLineMode
+
+double secondsNow(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return now.tv_sec + now.tv_nsec / 1e9;
+} // secondsNow
+
+void fillBenchOrg(Organization *org, size_t orgNum)
+{
+    snprintf(org->name, STRING_SIZE, BENCH_ORG_NAME_FORMAT, orgNum);
+    strNCpySafe(org->purpose, "Benchmarking", STRING_SIZE - 1);
+    strNCpySafe(org->ownerFirstLastName, "Bench Owner", STRING_SIZE - 1);
+    strNCpySafe(org->ownerEmail, "owner@bench.com", STRING_SIZE - 1);
+    strNCpySafe(org->ownerPwd, "Passw0rd", STRING_SIZE - 1);
+    org->goalAmount = (1000 + orgNum % 9000) * CENTS_PER_DOLLAR;
+
+    initOrgTotals(org);
+} // fillBenchOrg
+
+bool benchmarkOrgIndex(size_t numOrgs)
+{
+    OrgList list;
+    initOrgList(&list);
+
+    // register in reverse alphabetical order so each org goes to the head
+    // and building the list does not take O(n^2) name comparisons
+    double start = secondsNow();
+    for (size_t i = numOrgs; i > 0; i--) {
+        OrgNode *newNodePtr = newOrgNode(&list);
+        if (newNodePtr != NULL) {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+            linkOrgNode(&list, newNodePtr);
+        }
+    }
+    double buildSeconds = secondsNow() - start;
+
+    // look up names in upper case to exercise the caseless comparison
+    char name[STRING_SIZE];
+    Organization *scanOrgPtr = NULL;
+    Organization *indexOrgPtr = NULL;
+    bool sameOrgs = true;
+    unsigned int seed = 2060;
+
+    start = secondsNow();
+    for (size_t i = 0; i < BENCH_SCAN_LOOKUPS; i++) {
+        seed = seed * 1103515245 + 12345;
+        snprintf(name, STRING_SIZE, "ORGANIZATION %07zu", seed % numOrgs);
+        selectOrgFromListByScan(&scanOrgPtr, &list.headPtr, name);
+        selectOrgFromList(&indexOrgPtr, &list, name);
+
+        if (scanOrgPtr == NULL || scanOrgPtr != indexOrgPtr) {
+            sameOrgs = false;
+        }
+    }
+    double scanSeconds = secondsNow() - start;
+
+    start = secondsNow();
+    for (size_t i = 0; i < BENCH_INDEX_LOOKUPS; i++) {
+        seed = seed * 1103515245 + 12345;
+        snprintf(name, STRING_SIZE, "ORGANIZATION %07zu", seed % numOrgs);
+        selectOrgFromList(&indexOrgPtr, &list, name);
+    }
+    double indexSeconds = secondsNow() - start;
+
+    printf("Registered %zu organizations in %.3f s\n", numOrgs, buildSeconds);
+    printf("List scan:  %12.0f selections/s (%d selections, each also "
+           "checked against the index)\n", BENCH_SCAN_LOOKUPS / scanSeconds,
+           BENCH_SCAN_LOOKUPS);
+    printf("Hash index: %12.0f selections/s (%d selections)\n",
+           BENCH_INDEX_LOOKUPS / indexSeconds, BENCH_INDEX_LOOKUPS);
+    printf("Scan and index selected the same organizations: %s\n",
+           sameOrgs ? "yes" : "NO");
+
+    emptyList(&list);
+
+    return sameOrgs;
+} // benchmarkOrgIndex
+
+bool benchmarkOrgInsert(size_t numOrgs)
+{
+    size_t *orgNums = malloc(numOrgs * sizeof(size_t));
+    bool sameLists = orgNums != NULL;
+
+    // run once registering in descending order, which only measures building
+    // and allocating nodes, then once shuffled, which also walks the list
+    for (int shuffled = 0; shuffled <= 1 && sameLists; shuffled++) {
+        for (size_t i = 0; i < numOrgs; i++) {
+            orgNums[i] = numOrgs - 1 - i;
+        }
+
+        if (shuffled) {
+            unsigned int seed = 2060;
+            for (size_t i = numOrgs - 1; i > 0; i--) {
+                seed = seed * 1103515245 + 12345;
+                size_t j = seed % (i + 1);
+                size_t temp = orgNums[i];
+                orgNums[i] = orgNums[j];
+                orgNums[j] = temp;
+            }
+        }
+
+        OrgList copyList;
+        initOrgList(&copyList);
+        Organization org;
+
+        double start = secondsNow();
+        for (size_t i = 0; i < numOrgs; i++) {
+            fillBenchOrg(&org, orgNums[i]);
+            insertOrgToListByCopy(&copyList, org);
+        }
+        double copySeconds = secondsNow() - start;
+
+        OrgList inPlaceList;
+        initOrgList(&inPlaceList);
+
+        start = secondsNow();
+        for (size_t i = 0; i < numOrgs; i++) {
+            OrgNode *newNodePtr = newOrgNode(&inPlaceList);
+            if (newNodePtr != NULL) {
+                fillBenchOrg(&newNodePtr->org, orgNums[i]);
+                linkOrgNode(&inPlaceList, newNodePtr);
+            }
+        }
+        double inPlaceSeconds = secondsNow() - start;
+
+        sameLists = sameOrgLists(&copyList, &inPlaceList);
+
+        printf("Registered %zu organizations in %s order\n", numOrgs,
+               shuffled ? "shuffled" : "descending");
+        printf("Copy and lowercase every compare: %12.0f registrations/s\n",
+               numOrgs / copySeconds);
+        printf("In place with folded keys:        %12.0f registrations/s\n",
+               numOrgs / inPlaceSeconds);
+
+        emptyList(&copyList);
+        emptyList(&inPlaceList);
+    }
+
+    printf("Both ways built the same lists: %s\n", sameLists ? "yes" : "NO");
+
+    free(orgNums);
+
+    return sameLists;
+} // benchmarkOrgInsert
+
+bool sameOrgLists(const OrgList *list1Ptr, const OrgList *list2Ptr)
+{
+    bool same = true;
+    const OrgNode *currNode1 = list1Ptr->headPtr;
+    const OrgNode *currNode2 = list2Ptr->headPtr;
+
+    // walk both lists together until one ends or they differ
+    while (currNode1 != NULL && currNode2 != NULL && same) {
+        same = strcmp(currNode1->org.name, currNode2->org.name) == 0 &&
+               findIndexedOrg(&list2Ptr->index, currNode2->org.name) == currNode2;
+
+        currNode1 = currNode1->nextNodePtr;
+        currNode2 = currNode2->nextNodePtr;
+    }
+
+    return same && currNode1 == NULL && currNode2 == NULL;
+} // sameOrgLists
+
+bool benchmarkReceipts(size_t numReceipts)
+{
+    OrgList list;
+    initOrgList(&list);
+
+    // set up a few orgs and empty receipt files for them
+    OrgNode *nodes[BENCH_RECEIPT_ORGS];
+    size_t numOrgs = 0;
+    for (size_t i = BENCH_RECEIPT_ORGS; i > 0; i--) {
+        OrgNode *newNodePtr = newOrgNode(&list);
+        if (newNodePtr != NULL) {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+            linkOrgNode(&list, newNodePtr);
+            nodes[numOrgs] = newNodePtr;
+            numOrgs++;
+        }
+    }
+
+    for (size_t i = 0; i < numOrgs; i++) {
+        FILE *receiptsFile = fopen(nodes[i]->org.receiptPath, FILE_WRITE_MODE);
+        if (receiptsFile != NULL) {
+            fclose(receiptsFile);
+        }
+    }
+
+    // open, print to and close an org's file for every receipt
+    unsigned int seed = 2060;
+    double start = secondsNow();
+    for (size_t i = 0; i < numReceipts && numOrgs > 0; i++) {
+        seed = seed * 1103515245 + 12345;
+        Organization *org = &nodes[(seed >> 16) % numOrgs]->org;
+
+        FILE *receipts = fopen(org->receiptPath, FILE_APPEND_MODE);
+        if (receipts != NULL) {
+            fPrintReceipt(receipts, org, (1 + (seed >> 4) % 500) * CENTS_PER_DOLLAR);
+            fclose(receipts);
+        }
+    }
+    double directSeconds = secondsNow() - start;
+
+    // queue the same receipts through the writer, which appends them after
+    // the ones already written
+    ReceiptWriter writer;
+    bool written = startReceiptWriter(&writer);
+    seed = 2060;
+    start = secondsNow();
+    for (size_t i = 0; i < numReceipts && numOrgs > 0 && written; i++) {
+        seed = seed * 1103515245 + 12345;
+        queueReceipt(&writer, nodes[(seed >> 16) % numOrgs],
+                     (1 + (seed >> 4) % 500) * CENTS_PER_DOLLAR);
+    }
+    if (written) {
+        written = stopReceiptWriter(&writer);
+    }
+    double writerSeconds = secondsNow() - start;
+
+    bool sameReceipts = written && receiptFileHalvesMatch(&list);
+
+    printf("Wrote %zu receipts for %zu organizations each way\n", numReceipts,
+           numOrgs);
+    printf("Open, print and close per receipt: %12.0f receipts/s\n",
+           numReceipts / directSeconds);
+    printf("Buffered receipt writer:           %12.0f receipts/s\n",
+           numReceipts / writerSeconds);
+    printf("Both ways wrote the same receipts: %s\n",
+           sameReceipts ? "yes" : "NO");
+
+    // remove the benchmark's receipt files
+    for (size_t i = 0; i < numOrgs; i++) {
+        remove(nodes[i]->org.receiptPath);
+    }
+
+    emptyList(&list);
+
+    return sameReceipts;
+} // benchmarkReceipts
+
+bool receiptFileHalvesMatch(const OrgList *listPtr)
+{
+    bool match = true;
+
+    for (const OrgNode *currNodePtr = listPtr->headPtr;
+            currNodePtr != NULL && match; currNodePtr = currNodePtr->nextNodePtr) {
+        FILE *receipts = fopen(currNodePtr->org.receiptPath, "rb");
+        char *contents = NULL;
+        long size = -1;
+
+        if (receipts != NULL) {
+            fseek(receipts, 0, SEEK_END);
+            size = ftell(receipts);
+            rewind(receipts);
+
+            contents = size > 0 ? malloc(size) : NULL;
+            if (contents != NULL &&
+                    fread(contents, 1, size, receipts) != (size_t) size) {
+                free(contents);
+                contents = NULL;
+            }
+            fclose(receipts);
+        }
+
+        // the direct receipts come first and the writer's follow them
+        match = size == 0 ||
+                (contents != NULL && size % 2 == 0 &&
+                 sameReceiptText(contents, contents + size / 2, size / 2));
+        free(contents);
+    }
+
+    return match;
+} // receiptFileHalvesMatch
+
+bool sameReceiptText(const char *text1, const char *text2, size_t length)
+{
+    const size_t labelLength = strlen(RECEIPT_DATE_LABEL);
+    bool same = true;
+    size_t pos = 0;
+
+    // compare line by line, treating any two time stamps as equal
+    while (pos < length && same) {
+        const char *end1 = memchr(text1 + pos, '\n', length - pos);
+        const char *end2 = memchr(text2 + pos, '\n', length - pos);
+        size_t lineLength = end1 == NULL ? length - pos
+                                         : (size_t) (end1 - (text1 + pos)) + 1;
+
+        if (end1 == NULL || end2 == NULL ||
+                (size_t) (end2 - (text2 + pos)) + 1 != lineLength) {
+            same = end1 == NULL && end2 == NULL &&
+                   memcmp(text1 + pos, text2 + pos, lineLength) == 0;
+        } else if (lineLength > labelLength &&
+                   memcmp(text1 + pos, RECEIPT_DATE_LABEL, labelLength) == 0) {
+            same = memcmp(text2 + pos, RECEIPT_DATE_LABEL, labelLength) == 0;
+        } else {
+            same = memcmp(text1 + pos, text2 + pos, lineLength) == 0;
+        }
+
+        pos += lineLength;
+    }
+
+    return same;
+} // sameReceiptText
+
+bool benchmarkSnapshot(size_t numOrgs)
+{
+    OrgList list;
+    initOrgList(&list);
+
+    // build the list as a restart without a snapshot would have to
+    double start = secondsNow();
+    for (size_t i = numOrgs; i > 0; i--) {
+        OrgNode *newNodePtr = newOrgNode(&list);
+        if (newNodePtr != NULL) {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+            linkOrgNode(&list, newNodePtr);
+        }
+    }
+    double buildSeconds = secondsNow() - start;
+
+    // give the orgs different totals so the check can tell them apart
+    for (OrgNode *currNodePtr = list.headPtr; currNodePtr != NULL;
+            currNodePtr = currNodePtr->nextNodePtr) {
+        addDonation(&currNodePtr->org, currNodePtr->org.goalAmount / 4);
+    }
+
+    start = secondsNow();
+    bool matches = saveSnapshot(&list, BENCH_SNAPSHOT_PATH);
+    double saveSeconds = secondsNow() - start;
+
+    OrgList loadedList;
+    initOrgList(&loadedList);
+
+    start = secondsNow();
+    matches = matches && loadSnapshot(&loadedList, BENCH_SNAPSHOT_PATH);
+    double loadSeconds = secondsNow() - start;
+
+    // look up a sample of orgs, which only reads the pages they are on
+    char name[STRING_SIZE];
+    unsigned int seed = 2060;
+    start = secondsNow();
+    for (size_t i = 0; i < BENCH_SNAPSHOT_CHECKS && matches && numOrgs > 0; i++) {
+        seed = seed * 1103515245 + 12345;
+        snprintf(name, STRING_SIZE, "ORGANIZATION %07zu",
+                 (size_t) (seed >> 8) % numOrgs);
+
+        OrgNode *loadedNodePtr = findIndexedOrg(&loadedList.index, name);
+        OrgNode *builtNodePtr = findIndexedOrg(&list.index, name);
+        matches = loadedNodePtr != NULL && builtNodePtr != NULL &&
+                  strcmp(loadedNodePtr->org.name, builtNodePtr->org.name) == 0 &&
+                  loadedNodePtr->org.donationSum == builtNodePtr->org.donationSum;
+    }
+    double lookupSeconds = secondsNow() - start;
+
+    // walking the whole list reads every page of the snapshot
+    start = secondsNow();
+    matches = matches && sameOrgLists(&list, &loadedList);
+    double walkSeconds = secondsNow() - start;
+
+    // orgs can still be added after a load
+    OrgNode *newNodePtr = newOrgNode(&loadedList);
+    if (newNodePtr != NULL && matches) {
+        fillBenchOrg(&newNodePtr->org, numOrgs);
+        linkOrgNode(&loadedList, newNodePtr);
+        snprintf(name, STRING_SIZE, BENCH_ORG_NAME_FORMAT, numOrgs);
+        matches = findIndexedOrg(&loadedList.index, name) == newNodePtr;
+    }
+
+    printf("Built %zu organizations in %.3f s\n", numOrgs, buildSeconds);
+    printf("Saved a snapshot of %zu bytes in %.3f s\n", loadedList.snapshotSize,
+           saveSeconds);
+    printf("Loaded it in %.3f ms (%s address)\n", loadSeconds * 1000,
+           loadedList.snapshotPtr == (void *) SNAPSHOT_BASE_ADDRESS ?
+           "at its base" : "moved to another");
+    printf("%d lookups in the loaded list took %.3f ms\n", BENCH_SNAPSHOT_CHECKS,
+           lookupSeconds * 1000);
+    printf("Walking and checking the whole list took %.3f s\n", walkSeconds);
+    printf("The loaded list matched: %s\n", matches ? "yes" : "NO");
+
+    emptyList(&loadedList);
+    emptyList(&list);
+    remove(BENCH_SNAPSHOT_PATH);
+
+    return matches;
+} // benchmarkSnapshot
+
+//! Arguments for one benchmark donor session.
+typedef struct sessionArgs
+{
+    DonationEngine *enginePtr;
+    OrgNode **nodes;
+    size_t numOrgs;
+    size_t numDonations;
+    unsigned int seed;
+} SessionArgs;
+
+bool benchmarkDonationEngine(size_t maxThreads, size_t numDonations)
+{
+    OrgList list;
+    initOrgList(&list);
+
+    OrgNode **nodes = malloc(BENCH_ENGINE_ORGS * sizeof(OrgNode *));
+    OrgTotals *totals = malloc(BENCH_ENGINE_ORGS * sizeof(OrgTotals));
+    bool passed = nodes != NULL && totals != NULL;
+    size_t numOrgs = 0;
+
+    for (size_t i = BENCH_ENGINE_ORGS; i > 0 && passed; i--) {
+        OrgNode *newNodePtr = newOrgNode(&list);
+        if (newNodePtr != NULL) {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+            linkOrgNode(&list, newNodePtr);
+            nodes[numOrgs] = newNodePtr;
+            numOrgs++;
+        }
+    }
+
+    // every donation to an org is the same amount, so a consistent snapshot
+    // has each org's sum equal to its count times that amount
+    size_t perSession = numDonations / maxThreads;
+
+    if (passed) {
+        // apply the same number of donations directly on this thread
+        unsigned int seed = 2060;
+        double start = secondsNow();
+        for (size_t i = 0; i < numDonations; i++) {
+            seed = seed * 1103515245 + 12345;
+            OrgNode *nodePtr = nodes[(seed >> 8) % numOrgs];
+            addDonation(&nodePtr->org, nodePtr->org.goalAmount / 1000);
+        }
+        double directSeconds = secondsNow() - start;
+
+        printf("%zu donations to %zu organizations\n", numDonations, numOrgs);
+        printf("%-9s%-10s%16s\n", "Threads", "Path", "donations/s");
+        printf("%-9d%-10s%16.0f\n", 1, "direct", numDonations / directSeconds);
+    }
+
+    for (size_t numThreads = 1; numThreads <= maxThreads && passed; numThreads++) {
+        // start each run from zero
+        for (size_t i = 0; i < numOrgs; i++) {
+            initOrgTotals(&nodes[i]->org);
+        }
+
+        DonationEngine engine;
+        thrd_t sessions[ENGINE_MAX_WORKERS];
+        SessionArgs args[ENGINE_MAX_WORKERS];
+        bool engineStarted = startDonationEngine(&engine, numThreads);
+        size_t numSessions = 0;
+        passed = engineStarted;
+
+        double start = secondsNow();
+        for (size_t t = 0; t < numThreads && passed; t++) {
+            SessionArgs sessionArgs = {&engine, nodes, numOrgs, perSession,
+                                       2060 + (unsigned int) t};
+            args[t] = sessionArgs;
+            passed = thrd_create(&sessions[t], donationSessionThread,
+                                 &args[t]) == thrd_success;
+            if (passed) {
+                numSessions++;
+            }
+        }
+
+        // check a snapshot taken while the sessions are running
+        size_t snapshotDonations = 0;
+        bool consistent = true;
+        if (engineStarted) {
+            size_t numTotals = snapshotDonationEngine(&engine, &list, totals);
+            for (size_t i = 0; i < numTotals; i++) {
+                OrgNode *nodePtr = findIndexedOrg(&list.index, totals[i].name);
+                Cents amount = nodePtr->org.goalAmount / 1000;
+                consistent = consistent && totals[i].donationSum ==
+                             totals[i].numDonations * (amount - feeOf(amount)) &&
+                             totals[i].feesSum ==
+                             totals[i].numDonations * feeOf(amount);
+                snapshotDonations += totals[i].numDonations;
+            }
+        }
+
+        // only the sessions that started can be joined
+        for (size_t t = 0; t < numSessions; t++) {
+            thrd_join(sessions[t], NULL);
+        }
+        if (engineStarted) {
+            stopDonationEngine(&engine);
+        }
+        double seconds = secondsNow() - start;
+
+        // every donation must have been applied exactly once
+        size_t appliedDonations = 0;
+        for (size_t i = 0; i < numOrgs; i++) {
+            appliedDonations += nodes[i]->org.numDonations;
+        }
+
+        passed = passed && consistent &&
+                 appliedDonations == perSession * numThreads &&
+                 snapshotDonations <= appliedDonations;
+
+        printf("%-9zu%-10s%16.0f  (snapshot of %zu donations %s)\n",
+               numThreads, "engine", perSession * numThreads / seconds,
+               snapshotDonations, consistent ? "consistent" : "INCONSISTENT");
+    }
+
+    printf("Every donation applied exactly once: %s\n", passed ? "yes" : "NO");
+
+    free(nodes);
+    free(totals);
+    emptyList(&list);
+
+    return passed;
+} // benchmarkDonationEngine
+
+int donationSessionThread(void *sessionArgPtr)
+{
+    SessionArgs *args = sessionArgPtr;
+    unsigned int seed = args->seed;
+
+    for (size_t i = 0; i < args->numDonations; i++) {
+        seed = seed * 1103515245 + 12345;
+        OrgNode *nodePtr = args->nodes[(seed >> 8) % args->numOrgs];
+        submitDonation(args->enginePtr, nodePtr, nodePtr->org.goalAmount / 1000);
+    }
+
+    return 0;
+} // donationSessionThread
+
+bool benchmarkMoney(size_t numDonations)
+{
+    Cents *amounts = malloc(numDonations * sizeof(Cents));
+    double *dollars = malloc(numDonations * sizeof(double));
+    bool exact = amounts != NULL && dollars != NULL;
+
+    if (exact) {
+        // the same donations, from $1.00 to $500.99, in cents and in doubles
+        unsigned int seed = 2060;
+        for (size_t i = 0; i < numDonations; i++) {
+            seed = seed * 1103515245 + 12345;
+            amounts[i] = (1 + (seed >> 4) % 500) * CENTS_PER_DOLLAR +
+                         (seed >> 16) % CENTS_PER_DOLLAR;
+            dollars[i] = (double) amounts[i] / CENTS_PER_DOLLAR;
+        }
+
+        // sum as addDonation() used to, in doubles
+        double doubleGross = 0.0;
+        double doubleRaised = 0.0;
+        double doubleFees = 0.0;
+        double start = secondsNow();
+        for (size_t i = 0; i < numDonations; i++) {
+            double fee = dollars[i] * TRANSACTION_FEE;
+            doubleGross += dollars[i];
+            doubleFees += fee;
+            doubleRaised += dollars[i] - fee;
+        }
+        double doubleSeconds = secondsNow() - start;
+
+        // and as it does now, in cents
+        Cents gross = 0;
+        Cents raised = 0;
+        Cents fees = 0;
+        start = secondsNow();
+        for (size_t i = 0; i < numDonations; i++) {
+            Cents fee = feeOf(amounts[i]);
+            gross += amounts[i];
+            fees += fee;
+            raised += amounts[i] - fee;
+        }
+        double centsSeconds = secondsNow() - start;
+
+        // every cent donated is either raised or a fee
+        exact = raised + fees == gross;
+
+        // format every amount both ways; they must agree
+        char printfAmount[MONEY_STRING_SIZE];
+        char centsAmount[MONEY_STRING_SIZE];
+        size_t printfLength = 0;
+        size_t centsLength = 0;
+        start = secondsNow();
+        for (size_t i = 0; i < numDonations; i++) {
+            printfLength += snprintf(printfAmount, MONEY_STRING_SIZE, "%.2f",
+                                     dollars[i]);
+        }
+        double printfSeconds = secondsNow() - start;
+
+        start = secondsNow();
+        for (size_t i = 0; i < numDonations; i++) {
+            centsLength += formatCents(amounts[i], centsAmount);
+        }
+        double formatSeconds = secondsNow() - start;
+
+        for (size_t i = 0; i < numDonations && exact; i++) {
+            snprintf(printfAmount, MONEY_STRING_SIZE, "%.2f", dollars[i]);
+            formatCents(amounts[i], centsAmount);
+            exact = strcmp(printfAmount, centsAmount) == 0;
+        }
+        exact = exact && printfLength == centsLength;
+
+        char grossAmount[MONEY_STRING_SIZE];
+        char raisedAmount[MONEY_STRING_SIZE];
+        formatCents(gross, grossAmount);
+        formatCents(raised, raisedAmount);
+
+        printf("Summed %zu donations and their fees\n", numDonations);
+        printf("Doubles: %12.0f donations/s\n", numDonations / doubleSeconds);
+        printf("Cents:   %12.0f donations/s\n", numDonations / centsSeconds);
+        printf("Donated:  $%s exactly, $%.6f in doubles\n", grossAmount,
+               doubleGross);
+        printf("Raised:   $%s exactly, $%.6f in doubles\n", raisedAmount,
+               doubleRaised);
+        printf("The doubles drifted $%.6f from the exact amount donated\n",
+               doubleGross - (double) gross / CENTS_PER_DOLLAR);
+        printf("Formatted with printf(\"%%.2f\"): %12.0f amounts/s\n",
+               numDonations / printfSeconds);
+        printf("Formatted with formatCents():  %12.0f amounts/s\n",
+               numDonations / formatSeconds);
+        printf("Raised plus fees is the amount donated and the formats "
+               "agree: %s\n", exact ? "yes" : "NO");
+    }
+
+    free(amounts);
+    free(dollars);
+
+    return exact;
+} // benchmarkMoney
+
+bool benchmarkReport(size_t numOrgs, size_t numTop)
+{
+    OrgList list;
+    initOrgList(&list);
+
+    // build the orgs in reverse so each insert is at the head of the list
+    size_t builtOrgs = 0;
+    unsigned int seed = 2060;
+    for (size_t i = numOrgs; i > 0; i--) {
+        OrgNode *newNodePtr = newOrgNode(&list);
+        if (newNodePtr != NULL) {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+
+            // up to three donations of up to $5000.99, so some orgs reach
+            // their goal
+            for (size_t donation = 0; donation < (seed >> 8) % 4; donation++) {
+                seed = seed * 1103515245 + 12345;
+                addDonation(&newNodePtr->org,
+                            (1 + (seed >> 4) % 5000) * CENTS_PER_DOLLAR +
+                            (seed >> 16) % CENTS_PER_DOLLAR);
+            }
+            seed = seed * 1103515245 + 12345;
+
+            linkOrgNode(&list, newNodePtr);
+            builtOrgs++;
+        }
+    }
+
+    double *rowPercents = malloc(builtOrgs * sizeof(double) + 1);
+    double *columnPercents = malloc(builtOrgs * sizeof(double) + 1);
+    TopOrg *rowTop = malloc(numTop * sizeof(TopOrg));
+    TopOrg *columnTop = malloc(numTop * sizeof(TopOrg));
+    bool agree = rowPercents != NULL && columnPercents != NULL &&
+                 rowTop != NULL && columnTop != NULL;
+
+    if (agree) {
+        // the same report read from every node, as printListContents() and
+        // the summaries in report() do; rows are numbered in list order,
+        // as they are in the columns
+        ReportTotals rowTotals = {builtOrgs, 0, 0, 0, 0, 0};
+        size_t numRowTop = 0;
+        size_t row = 0;
+        double start = secondsNow();
+        for (const OrgNode *currNodePtr = list.headPtr; currNodePtr != NULL;
+                currNodePtr = currNodePtr->nextNodePtr, row++) {
+            const Organization *org = &currNodePtr->org;
+            rowTotals.goals += org->goalAmount;
+            rowTotals.raised += org->donationSum;
+            rowTotals.fees += org->feesSum;
+            rowTotals.numDonations += org->numDonations;
+            rowTotals.numAtGoal += org->donationSum >= org->goalAmount;
+            rowPercents[row] = (double) org->donationSum * 100 / org->goalAmount;
+
+            TopOrg candidate = {org->donationSum, row, currNodePtr};
+            offerTopOrg(rowTop, &numRowTop, numTop, candidate);
+        }
+        qsort(rowTop, numRowTop, sizeof(TopOrg), compareTopOrgs);
+        double rowSeconds = secondsNow() - start;
+
+        // report() copies the numbers into the columns during the walk it
+        // makes for the summaries, and then only scans the columns
+        OrgColumns columns = {NULL, NULL, 0};
+        start = secondsNow();
+        for (const OrgNode *currNodePtr = list.headPtr;
+                currNodePtr != NULL && agree;
+                currNodePtr = currNodePtr->nextNodePtr) {
+            agree = addOrgColumnRow(&columns, currNodePtr);
+        }
+        double copySeconds = secondsNow() - start;
+
+        ReportTotals columnTotals;
+        start = secondsNow();
+        totalOrgColumns(&columns, &columnTotals);
+        percentOfGoal(&columns, columnPercents);
+        size_t numColumnTop = topOrgsByRaised(&columns, numTop, columnTop);
+        double columnSeconds = secondsNow() - start;
+
+        agree = agree && columnTotals.numOrgs == rowTotals.numOrgs &&
+                columnTotals.goals == rowTotals.goals &&
+                columnTotals.raised == rowTotals.raised &&
+                columnTotals.fees == rowTotals.fees &&
+                columnTotals.numDonations == rowTotals.numDonations &&
+                columnTotals.numAtGoal == rowTotals.numAtGoal &&
+                memcmp(columnPercents, rowPercents,
+                       builtOrgs * sizeof(double)) == 0 &&
+                numColumnTop == numRowTop;
+        for (size_t i = 0; i < numColumnTop && agree; i++) {
+            agree = columnTop[i].nodePtr == rowTop[i].nodePtr;
+        }
+
+        fPrintColumnReport(stdout, &columnTotals, columnTop, numColumnTop);
+        puts("");
+        printf("Reported on %zu organizations\n", builtOrgs);
+        printf("Reading every node:    %8.3f ms\n", rowSeconds * 1000);
+        printf("Copying into columns:  %8.3f ms\n", copySeconds * 1000);
+        printf("Scanning the columns:  %8.3f ms\n", columnSeconds * 1000);
+        printf("Both reports agree: %s\n", agree ? "yes" : "NO");
+
+        freeOrgColumns(&columns);
+    }
+
+    free(rowPercents);
+    free(columnPercents);
+    free(rowTop);
+    free(columnTop);
+    emptyList(&list);
+
+    return agree;
+} // benchmarkReport
+
+//! Every validator with its original version, for the fuzzer and benchmark.
+const ValidatorPair VALIDATOR_PAIRS[] = {
+    {"isEmail", isEmail, isEmailByScans},
+    {"isPassword", isPassword, isPasswordByScans},
+    {"isZip", isZip, isZipByScans},
+    {"isYesNo", isYesNo, isYesNoByScans},
+    {"isDonation", isDonation, isDonationByScans}
+};
+#define NUM_VALIDATOR_PAIRS (sizeof(VALIDATOR_PAIRS) / sizeof(VALIDATOR_PAIRS[0]))
+
+bool fuzzValidators(size_t numCases)
+{
+    // room past the longest string for the original isEmail(), which reads
+    // up to a top-level domain's length past a dot at the end
+    char buffer[STRING_SIZE + TOP_LVL_DOMAIN_LEN + 1];
+    size_t numAccepted[NUM_VALIDATOR_PAIRS] = {0};
+    size_t numMismatches = 0;
+    unsigned int seed = 2060;
+
+    for (size_t i = 0; i < numCases; i++) {
+        memset(buffer, 0, sizeof(buffer));
+        makeFuzzString(buffer, &seed);
+
+        for (size_t pair = 0; pair < NUM_VALIDATOR_PAIRS; pair++) {
+            bool byTable = VALIDATOR_PAIRS[pair].byTable(buffer);
+            bool byScans = VALIDATOR_PAIRS[pair].byScans(buffer);
+            numAccepted[pair] += byTable;
+
+            if (byTable != byScans) {
+                numMismatches++;
+
+                if (numMismatches <= FUZZ_MAX_REPORTED_MISMATCHES) {
+                    printf("%s disagrees on \"%s\": %d, originally %d\n",
+                           VALIDATOR_PAIRS[pair].name, buffer, byTable, byScans);
+                }
+            }
+        }
+    }
+
+    printf("Tried %zu strings on every validator\n", numCases);
+    for (size_t pair = 0; pair < NUM_VALIDATOR_PAIRS; pair++) {
+        printf("%-12s accepted %zu\n", VALIDATOR_PAIRS[pair].name,
+               numAccepted[pair]);
+    }
+    printf("Mismatches with the original validators: %zu\n", numMismatches);
+
+    return numMismatches == 0;
+} // fuzzValidators
+
+bool benchmarkValidators(size_t numValidations)
+{
+    char *corpus = calloc(BENCH_VALIDATORS_CORPUS,
+                          STRING_SIZE + TOP_LVL_DOMAIN_LEN + 1);
+    bool agree = corpus != NULL;
+
+    if (agree) {
+        // a corpus which fits in cache, so the validators are what is timed
+        unsigned int seed = 2060;
+        for (size_t i = 0; i < BENCH_VALIDATORS_CORPUS; i++) {
+            makeFuzzString(corpus + i * (STRING_SIZE + TOP_LVL_DOMAIN_LEN + 1),
+                           &seed);
+        }
+
+        printf("%zu validations each on %d strings\n", numValidations,
+               BENCH_VALIDATORS_CORPUS);
+        printf("%-12s%18s%18s\n", "Validator", "by scans/s", "by table/s");
+
+        for (size_t pair = 0; pair < NUM_VALIDATOR_PAIRS; pair++) {
+            bool (*validators[2])(const char *) = {
+                VALIDATOR_PAIRS[pair].byScans, VALIDATOR_PAIRS[pair].byTable
+            };
+            size_t numAccepted[2] = {0, 0};
+            double seconds[2];
+
+            for (size_t version = 0; version < 2; version++) {
+                double start = secondsNow();
+                for (size_t i = 0; i < numValidations; i++) {
+                    const char *str = corpus + (i % BENCH_VALIDATORS_CORPUS) *
+                                      (STRING_SIZE + TOP_LVL_DOMAIN_LEN + 1);
+                    numAccepted[version] += validators[version](str);
+                }
+                seconds[version] = secondsNow() - start;
+            }
+
+            agree = agree && numAccepted[0] == numAccepted[1];
+
+            printf("%-12s%18.0f%18.0f\n", VALIDATOR_PAIRS[pair].name,
+                   numValidations / seconds[0], numValidations / seconds[1]);
+        }
+
+        printf("Both versions accepted the same strings: %s\n",
+               agree ? "yes" : "NO");
+    }
+
+    free(corpus);
+
+    return agree;
+} // benchmarkValidators
+
+OrgNode **fillLoggedBenchList(OrgList *listPtr, size_t numOrgs)
+{
+    OrgNode **nodes = malloc(numOrgs * sizeof(OrgNode *));
+    uint64_t sequence = 0;
+
+    for (size_t i = numOrgs; i > 0 && nodes != NULL; i--) {
+        OrgNode *newNodePtr = newOrgNode(listPtr);
+        if (newNodePtr == NULL) {
+            free(nodes);
+            nodes = NULL;
+        } else {
+            fillBenchOrg(&newNodePtr->org, i - 1);
+            linkOrgNode(listPtr, newNodePtr);
+            sequence = logOrg(listPtr->logPtr, newNodePtr);
+            nodes[i - 1] = newNodePtr;
+        }
+    }
+
+    if (nodes != NULL && !waitForLogCommit(listPtr->logPtr, sequence)) {
+        free(nodes);
+        nodes = NULL;
+    }
+    if (nodes == NULL) {
+        puts(MEM_ERROR);
+    }
+
+    return nodes;
+} // fillLoggedBenchList
+
+bool benchmarkDonationLog(size_t numDonations, long maxDelayMicros)
+{
+    const size_t groupSizes[] = {1, 16, 256, 4096};
+    bool matches = true;
+
+    printf("%zu durable donations for each group size, at most %ld us "
+           "latency\n", numDonations, maxDelayMicros);
+    printf("%-12s%16s%12s%18s\n", "Group size", "donations/s", "syncs",
+           "donations/sync");
+
+    for (size_t size = 0; size < sizeof(groupSizes) / sizeof(groupSizes[0]) &&
+            matches; size++) {
+        size_t groupSize = groupSizes[size];
+        remove(BENCH_LOG_PATH);
+
+        OrgList list;
+        initOrgList(&list);
+        DonationLog log;
+        matches = openDonationLog(&log, &list, BENCH_LOG_PATH, groupSize,
+                                  maxDelayMicros);
+
+        OrgNode **nodes = NULL;
+        if (matches) {
+            nodes = fillLoggedBenchList(&list, BENCH_LOG_ORGS);
+            matches = nodes != NULL;
+        }
+
+        double seconds = 0;
+        uint64_t orgSyncs = matches ? log.numSyncs : 0;
+        if (matches) {
+            // a group of donors donates at once, and each waits until its
+            // donation is durable before being thanked
+            unsigned int seed = 2060;
+            double start = secondsNow();
+            for (size_t i = 0; i < numDonations && matches; i += groupSize) {
+                uint64_t sequence = 0;
+                for (size_t j = i; j < i + groupSize && j < numDonations; j++) {
+                    seed = seed * 1103515245 + 12345;
+                    OrgNode *nodePtr = nodes[(seed >> 8) % BENCH_LOG_ORGS];
+                    Cents donation = (Cents) (seed >> 20) + 1;
+
+                    addDonation(&nodePtr->org, donation);
+                    sequence = logDonation(&log, nodePtr, donation);
+                }
+                matches = waitForLogCommit(&log, sequence);
+            }
+            seconds = secondsNow() - start;
+        }
+
+        uint64_t numSyncs = log.numSyncs - orgSyncs;
+        if (matches) {
+            matches = closeDonationLog(&log);
+        }
+
+        // replaying the log must give every org the same totals
+        OrgList replayedList;
+        initOrgList(&replayedList);
+        DonationLog replayedLog;
+        if (matches) {
+            matches = openDonationLog(&replayedLog, &replayedList, BENCH_LOG_PATH,
+                                      groupSize, maxDelayMicros);
+            if (matches) {
+                matches = closeDonationLog(&replayedLog) &&
+                          replayedLog.replayedDonations == numDonations &&
+                          sameOrgTotals(&list, &replayedList);
+            }
+        }
+
+        if (matches) {
+            printf("%-12zu%16.0f%12llu%18.1f\n", groupSize,
+                   numDonations / seconds, (unsigned long long) numSyncs,
+                   numSyncs > 0 ? (double) numDonations / numSyncs : 0.0);
+        }
+
+        free(nodes);
+        emptyList(&replayedList);
+        emptyList(&list);
+    }
+
+    printf("Replaying every log rebuilt the same totals: %s\n",
+           matches ? "yes" : "NO");
+    remove(BENCH_LOG_PATH);
+
+    return matches;
+} // benchmarkDonationLog
+
+bool benchmarkRecovery(size_t numRecords)
+{
+    size_t numOrgs = numRecords < BENCH_LOG_ORGS ? numRecords : BENCH_LOG_ORGS;
+    size_t numDonations = numRecords - numOrgs;
+    remove(BENCH_LOG_PATH);
+
+    OrgList list;
+    initOrgList(&list);
+    DonationLog log;
+
+    // as many records to a group as fill half the buffer, the latency bound
+    // only matters for a group which never fills
+    bool matches = numOrgs > 0 &&
+                   openDonationLog(&log, &list, BENCH_LOG_PATH,
+                                   LOG_BUFFER_SIZE / sizeof(LogRecord),
+                                   LOG_DEFAULT_MAX_DELAY_MICROS);
+    OrgNode **nodes = NULL;
+    if (matches) {
+        nodes = fillLoggedBenchList(&list, numOrgs);
+        matches = nodes != NULL;
+    }
+
+    double start = secondsNow();
+    if (matches) {
+        unsigned int seed = 2060;
+        for (size_t i = 0; i < numDonations; i++) {
+            seed = seed * 1103515245 + 12345;
+            OrgNode *nodePtr = nodes[(seed >> 8) % numOrgs];
+            Cents donation = (Cents) (seed >> 20) + 1;
+
+            addDonation(&nodePtr->org, donation);
+            logDonation(&log, nodePtr, donation);
+        }
+        matches = closeDonationLog(&log);
+    }
+    double writeSeconds = secondsNow() - start;
+
+    struct stat logStat;
+    matches = matches && stat(BENCH_LOG_PATH, &logStat) == 0;
+
+    // replay it as a restart after a crash would
+    OrgList replayedList;
+    initOrgList(&replayedList);
+    DonationLog replayedLog;
+    start = secondsNow();
+    bool replayed = matches && openDonationLog(&replayedLog, &replayedList,
+                                               BENCH_LOG_PATH, 1,
+                                               LOG_DEFAULT_MAX_DELAY_MICROS);
+    double replaySeconds = secondsNow() - start;
+
+    if (replayed) {
+        matches = closeDonationLog(&replayedLog) &&
+                  replayedLog.replayedDonations == numDonations &&
+                  sameOrgTotals(&list, &replayedList);
+    }
+    matches = matches && replayed;
+
+    // a crash in the middle of writing the last record leaves it torn
+    OrgList tornList;
+    initOrgList(&tornList);
+    DonationLog tornLog;
+    bool cutOff = matches && numDonations > 0 &&
+                  truncate(BENCH_LOG_PATH, logStat.st_size - 5) == 0 &&
+                  openDonationLog(&tornLog, &tornList, BENCH_LOG_PATH, 1,
+                                  LOG_DEFAULT_MAX_DELAY_MICROS);
+    if (cutOff) {
+        struct stat tornStat;
+        cutOff = closeDonationLog(&tornLog) &&
+                 tornLog.replayedDonations == numDonations - 1 &&
+                 tornLog.droppedBytes == sizeof(LogRecord) - 5 &&
+                 stat(BENCH_LOG_PATH, &tornStat) == 0 &&
+                 (size_t) tornStat.st_size ==
+                 (size_t) logStat.st_size - sizeof(LogRecord);
+    }
+
+    if (matches) {
+        printf("Logged %zu organizations and %zu donations, %lld bytes, in "
+               "%.3f s\n", numOrgs, numDonations, (long long) logStat.st_size,
+               writeSeconds);
+        printf("Replayed them in %.3f s, %.0f records/s\n", replaySeconds,
+               numRecords / replaySeconds);
+    }
+    printf("The replayed totals matched: %s\n", matches ? "yes" : "NO");
+    printf("A torn last record was cut off: %s\n", cutOff ? "yes" : "NO");
+
+    free(nodes);
+    emptyList(&tornList);
+    emptyList(&replayedList);
+    emptyList(&list);
+    remove(BENCH_LOG_PATH);
+
+    return matches && (cutOff || numDonations == 0);
+} // benchmarkRecovery
+
+bool sameOrgTotals(const OrgList *list1Ptr, const OrgList *list2Ptr)
+{
+    const OrgNode *node1Ptr = list1Ptr->headPtr;
+    const OrgNode *node2Ptr = list2Ptr->headPtr;
+    bool same = true;
+
+    while (node1Ptr != NULL && node2Ptr != NULL && same) {
+        same = strcmp(node1Ptr->org.name, node2Ptr->org.name) == 0 &&
+               node1Ptr->org.goalAmount == node2Ptr->org.goalAmount &&
+               node1Ptr->org.numDonations == node2Ptr->org.numDonations &&
+               node1Ptr->org.donationSum == node2Ptr->org.donationSum &&
+               node1Ptr->org.feesSum == node2Ptr->org.feesSum;
+
+        node1Ptr = node1Ptr->nextNodePtr;
+        node2Ptr = node2Ptr->nextNodePtr;
+    }
+
+    return same && node1Ptr == NULL && node2Ptr == NULL;
+} // sameOrgTotals
+
+void makeFuzzString(char *buffer, unsigned int *seedPtr)
+{
+    static const char *const examples[] = {
+        "owner@bench.com", "a@b.org", "Passw0rd", "aB3defg", "15213", "90210",
+        "12.50", "0.005", ".5", "q", "Q", "y", "N"
+    };
+    static const char alphabet[] = "aZq@.@.05919Yyn -\t";
+    size_t numExamples = sizeof(examples) / sizeof(examples[0]);
+    size_t length = 0;
+
+    *seedPtr = *seedPtr * 1103515245 + 12345;
+    unsigned int choice = *seedPtr >> 16;
+
+    if (choice % 2 == 0) {
+        // a valid example with up to three mutations
+        strcpy(buffer, examples[(choice >> 1) % numExamples]);
+        length = strlen(buffer);
+
+        for (unsigned int i = 0; i < (choice >> 5) % 4; i++) {
+            *seedPtr = *seedPtr * 1103515245 + 12345;
+            unsigned int mutation = *seedPtr >> 16;
+            size_t pos = length > 0 ? (mutation >> 2) % (length + 1) : 0;
+            char newChar = alphabet[(mutation >> 8) % (sizeof(alphabet) - 1)];
+
+            if (mutation % 4 == 0 && length > 0) {
+                // delete a character
+                memmove(buffer + pos, buffer + pos + 1, length - pos);
+                length -= pos < length;
+            } else if (mutation % 4 == 1 && length < STRING_SIZE - 1) {
+                // insert a character
+                memmove(buffer + pos + 1, buffer + pos, length - pos + 1);
+                buffer[pos] = newChar;
+                length++;
+            } else if (pos < length) {
+                // replace a character, sometimes with any byte at all
+                buffer[pos] = mutation % 4 == 2 ? newChar :
+                              (char) (1 + (mutation >> 4) % UCHAR_MAX);
+            }
+        }
+    } else {
+        // random characters, mostly short
+        length = (choice >> 1) % 12;
+        if ((choice >> 5) % 16 == 0) {
+            length = (choice >> 9) % STRING_SIZE;
+        }
+
+        for (size_t i = 0; i < length; i++) {
+            *seedPtr = *seedPtr * 1103515245 + 12345;
+            unsigned int charChoice = *seedPtr >> 16;
+            buffer[i] = charChoice % 8 == 0 ?
+                        (char) (1 + (charChoice >> 3) % UCHAR_MAX) :
+                        alphabet[(charChoice >> 3) % (sizeof(alphabet) - 1)];
+        }
+        buffer[length] = '\0';
+    }
+} // makeFuzzString